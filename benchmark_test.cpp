@@ -5,7 +5,12 @@
 #include <iostream>
 
 #include <benchmark/benchmark.h>
+#include <pjh_json/helpers/json_path.hpp>
 #include <pjh_json/parsers/json_parser.hpp>
+#include <pjh_json/parsers/json_document_builder.hpp>
+#include <pjh_json/parsers/json_lazy_document.hpp>
+#include <pjh_json/parsers/json_line_stream_parser.hpp>
+#include <pjh_json/parsers/json_push_parser.hpp>
 #include <nlohmann/json.hpp>
 #include "rapidjson/document.h"
 
@@ -61,7 +66,7 @@ pjh_std::json::Ref random_json(int depth = 0, int max_depth = 5)
         int n = 1 + (rng() % 5);
         for (int i = 0; i < n; i++)
         {
-            obj.get()->as_object()->insert_raw_ptr(random_string(3 + rng() % 5), random_json(depth + 1, max_depth).get());
+            obj.get()->as_object()->insert_raw_ptr_copy_key(random_string(3 + rng() % 5), random_json(depth + 1, max_depth).get());
         }
         return obj;
     }
@@ -142,6 +147,291 @@ static void BM_PJH_Json_Parse(benchmark::State &state, const std::string &conten
     }
 }
 
+// pjh_json（借用模式，不拷贝输入）
+static void BM_PJH_Json_Parse_View(benchmark::State &state, const std::string &content)
+{
+    for (auto _ : state)
+    {
+        pjh_std::json::Parser parser{std::string_view(content)};
+        pjh_std::json::Ref root = parser.parse();
+        benchmark::DoNotOptimize(root);
+        delete root.get();
+    }
+}
+
+// pjh_json（借用模式，节点分配在文档自己的 Arena 上，整体释放）
+static void BM_PJH_Json_Parse_Document(benchmark::State &state, const std::string &content)
+{
+    for (auto _ : state)
+    {
+        pjh_std::json::Parser parser{std::string_view(content)};
+        pjh_std::json::Document doc = parser.parse_document();
+        benchmark::DoNotOptimize(doc);
+    }
+}
+
+// pjh_json（内存映射文件）
+static void BM_PJH_Json_Parse_File(benchmark::State &state, const std::string &path)
+{
+    for (auto _ : state)
+    {
+        pjh_std::json::Document doc = pjh_std::json::Parser::parse_file(path);
+        benchmark::DoNotOptimize(doc);
+    }
+}
+
+// pjh_json（借用模式 + SIMD 结构索引）
+static void BM_PJH_Json_Parse_Indexed(benchmark::State &state, const std::string &content)
+{
+    pjh_std::json::ParseOptions options;
+    options.structural_index = true;
+    for (auto _ : state)
+    {
+        pjh_std::json::Parser parser{std::string_view(content), options};
+        pjh_std::json::Ref root = parser.parse();
+        benchmark::DoNotOptimize(root);
+        delete root.get();
+    }
+}
+
+// pjh_json（借用模式，解析为扁平的 Tape）
+static void BM_PJH_Json_Parse_Tape(benchmark::State &state, const std::string &content)
+{
+    for (auto _ : state)
+    {
+        pjh_std::json::Parser parser{std::string_view(content)};
+        pjh_std::json::Tape tape = parser.parse_to_tape();
+        benchmark::DoNotOptimize(tape);
+    }
+}
+
+// pjh_json（借用模式，SAX 事件：只统计数字之和与字符串个数，不构建任何节点）
+static void BM_PJH_Json_Parse_Sax(benchmark::State &state, const std::string &content)
+{
+    struct Counter : pjh_std::json::SaxHandler
+    {
+        double sum = 0;
+        size_t strings = 0;
+        void on_int(int64_t p_value) { sum += static_cast<double>(p_value); }
+        void on_double(double p_value) { sum += p_value; }
+        void on_string(pjh_std::json::string_v_t) { ++strings; }
+    };
+    for (auto _ : state)
+    {
+        Counter counter;
+        pjh_std::json::Parser parser{std::string_view(content)};
+        parser.parse_sax(counter);
+        benchmark::DoNotOptimize(counter);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(content.size()));
+}
+
+// pjh_json（增量解析：按 state.range(0) 字节的块送入 PushParser，边接收边构建 DOM）
+static void BM_PJH_Json_Parse_Push(benchmark::State &state, const std::string &content)
+{
+    const size_t chunk = static_cast<size_t>(state.range(0));
+    pjh_std::json::DocumentBuilder builder;
+    for (auto _ : state)
+    {
+        pjh_std::json::PushParser parser(builder);
+        for (size_t pos = 0; pos < content.size(); pos += chunk)
+            parser.feed(content.data() + pos, (std::min)(chunk, content.size() - pos));
+        parser.finish();
+        pjh_std::json::Document doc = builder.document();
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(content.size()));
+}
+
+// pjh_json（按需解析：遍历根数组，只读取每个元素的类型，子树按括号匹配整体跳过）
+static void BM_PJH_Json_Parse_Lazy(benchmark::State &state, const std::string &content)
+{
+    for (auto _ : state)
+    {
+        pjh_std::json::LazyDocument doc{std::string_view(content)};
+        size_t containers = 0;
+        for (pjh_std::json::LazyRef value : doc.root())
+            containers += value.is_array() || value.is_object();
+        benchmark::DoNotOptimize(containers);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(content.size()));
+}
+
+// pjh_json（键白名单：根对象中只解析一个标量成员，其余成员的值按括号匹配整体跳过）
+static void BM_PJH_Json_Parse_Allowlist(benchmark::State &state, const std::string &content)
+{
+    const std::string wrapped = "{\"data\": " + content + ", \"size\": " + std::to_string(content.size()) + "}";
+    pjh_std::json::ParseOptions options;
+    options.key_allowlist = {"size"};
+    for (auto _ : state)
+    {
+        pjh_std::json::Parser parser{std::string_view(wrapped), options};
+        pjh_std::json::Document doc = parser.parse_document();
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(wrapped.size()));
+}
+
+// pjh_json（路由场景：对同一类小消息反复求值一组预先编译的路径，分别在 DOM 与按需解析的文档上）
+static void BM_PJH_Json_Path(benchmark::State &state, bool lazy)
+{
+    std::string message = R"({"header": {"id": 12345, "type": "order", "region": "eu", "priority": 3},)"
+                          R"( "user": {"name": "pjh_json", "tier": "gold", "tags": ["a", "b", "c"]}, "items": [)";
+    for (int i = 0; i < 16; ++i)
+        message += (i ? ", " : "") + std::string(R"({"sku": "item-)") + std::to_string(i) + R"(", "qty": )" + std::to_string(i % 4) +
+                   R"(, "price": )" + std::to_string(i * 2.5) + "}";
+    message += R"(], "trace": {"spans": [[1, 2, 3], [4, 5, 6]], "note": "skipped unless requested"}})";
+
+    std::vector<pjh_std::json::Path> paths;
+    for (const char *pointer : {"/header/type", "/header/region", "/header/priority", "/user/tier", "/items/0/sku"})
+        paths.push_back(pjh_std::json::Path::pointer(pointer));
+    for (const char *expression : {"$.user.tags[-1]", "$.items[?(@.qty == 3)].sku", "$.items[?(@.price > 30)].price"})
+        paths.push_back(pjh_std::json::Path::compile(expression));
+
+    for (auto _ : state)
+    {
+        size_t selected = 0;
+        if (lazy)
+        {
+            pjh_std::json::LazyDocument doc{std::string_view(message)};
+            std::vector<pjh_std::json::LazyRef> out;
+            for (const auto &path : paths)
+                path.select(doc.root(), out);
+            selected = out.size();
+        }
+        else
+        {
+            pjh_std::json::Document doc = pjh_std::json::Parser(std::string_view(message)).parse_document();
+            std::vector<pjh_std::json::Element *> out;
+            for (const auto &path : paths)
+                path.select(doc.get(), out);
+            selected = out.size();
+        }
+        benchmark::DoNotOptimize(selected);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(message.size()));
+}
+
+// pjh_json（逐条记录的场景：每条记录有 40 个相同的键，解析后按键读取全部字段；
+// 驻留时键解析到共享的 KeyTable 中，读取时使用预先驻留的 Key 而不是按字符串哈希查找）
+static void BM_PJH_Json_Key_Lookup(benchmark::State &state, bool interned)
+{
+    std::vector<std::string> names;
+    std::string record = "{";
+    for (int i = 0; i < 40; ++i)
+    {
+        names.push_back("field_" + std::to_string(i));
+        record += (i ? ", \"" : "\"") + names.back() + "\": " + std::to_string(i * 7);
+    }
+    record += "}";
+
+    pjh_std::json::ParseOptions options;
+    std::vector<pjh_std::json::KeyTable::Key> keys;
+    if (interned)
+    {
+        options.key_table = std::make_shared<pjh_std::json::KeyTable>();
+        for (const auto &name : names)
+            keys.push_back(options.key_table->intern(name));
+    }
+    for (auto _ : state)
+    {
+        pjh_std::json::Document doc = pjh_std::json::Parser(std::string_view(record), options).parse_document();
+        pjh_std::json::Object *obj = doc.get()->as_object();
+        size_t found = 0;
+        for (size_t i = 0; i < names.size(); ++i)
+            found += (interned ? (*obj)[keys[i]] : (*obj)[names[i]]) != nullptr;
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(record.size()));
+}
+
+// pjh_json（借用模式 + 两线程流水线：后台线程做词法分析，当前线程构建文档）
+static void BM_PJH_Json_Parse_Pipelined(benchmark::State &state, const std::string &content)
+{
+    pjh_std::json::ParseOptions options;
+    options.pipelined = true;
+    for (auto _ : state)
+    {
+        pjh_std::json::Parser parser{std::string_view(content), options};
+        pjh_std::json::Document doc = parser.parse_document();
+        benchmark::DoNotOptimize(doc);
+    }
+}
+
+// 流水线与单线程在不同输入大小下的对比：输入较小时线程启动与交接的开销占主导，单线程更快
+static void BM_PJH_Json_Parse_Sized(benchmark::State &state, bool pipelined)
+{
+    const std::string record = R"({"id": 12345, "name": "pjh_json", "tags": ["a", "b", "c"], "score": 98.5, "ok": true},)";
+    std::string content = "[";
+    while (content.size() + record.size() < static_cast<size_t>(state.range(0)))
+        content += record;
+    content += "null]";
+
+    pjh_std::json::ParseOptions options;
+    options.pipelined = pipelined;
+    for (auto _ : state)
+    {
+        pjh_std::json::Parser parser{std::string_view(content), options};
+        pjh_std::json::Document doc = parser.parse_document();
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(content.size()));
+}
+
+// pjh_json（借用模式，顶层数组切分后在线程池上并行解析）
+static void BM_PJH_Json_Parse_Parallel(benchmark::State &state, const std::string &content)
+{
+    pjh_std::json::ThreadPool pool(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        pjh_std::json::Document doc = pjh_std::json::Parser::parse_parallel(std::string_view(content), pool);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(content.size()));
+}
+
+// pjh_json（NDJSON：按块读取文件，每批记录在线程池上解析后按顺序交付）
+static void BM_PJH_Json_Parse_NDJSON(benchmark::State &state, const std::string &path)
+{
+    pjh_std::json::LineStreamOptions options;
+    options.threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        pjh_std::json::LineStreamParser reader(std::filesystem::path(path), options);
+        size_t count = reader.for_each([](const pjh_std::json::LineRecord &record)
+                                       { benchmark::DoNotOptimize(record.element); });
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(std::filesystem::file_size(path)));
+}
+
+// 仅建立结构索引（第一阶段）
+static void BM_PJH_Structural_Index(benchmark::State &state, const std::string &content)
+{
+    pjh_std::json::StructuralIndex index;
+    for (auto _ : state)
+    {
+        index.build(content);
+        benchmark::DoNotOptimize(index);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(content.size()));
+}
+
+// 序列化：复用同一个 Writer，逐字节写入一次
+static void BM_PJH_Json_Serialize(benchmark::State &state, const std::string &content)
+{
+    pjh_std::json::Parser parser{std::string_view(content)};
+    pjh_std::json::Document doc = parser.parse_document();
+    pjh_std::json::Writer writer(content.size() + 1);
+    for (auto _ : state)
+    {
+        writer.clear();
+        doc.get()->serialize_to(writer);
+        benchmark::DoNotOptimize(writer.view().data());
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(content.size()));
+}
+
 void RegisterBenchmarks()
 {
     // std::vector<std::pair<std::string, size_t>> sizes = {
@@ -168,6 +458,87 @@ void RegisterBenchmarks()
         benchmark::RegisterBenchmark(
             "PJH/",
             BM_PJH_Json_Parse, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_View/",
+            BM_PJH_Json_Parse_View, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_Document/",
+            BM_PJH_Json_Parse_Document, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_Indexed/",
+            BM_PJH_Json_Parse_Indexed, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_Pipelined/",
+            BM_PJH_Json_Parse_Pipelined, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_Serial_Sized/",
+            BM_PJH_Json_Parse_Sized, false)
+            ->RangeMultiplier(8)
+            ->Range(1 << 10, 1 << 25);
+        benchmark::RegisterBenchmark(
+            "PJH_Pipelined_Sized/",
+            BM_PJH_Json_Parse_Sized, true)
+            ->RangeMultiplier(8)
+            ->Range(1 << 10, 1 << 25);
+        benchmark::RegisterBenchmark(
+            "PJH_Parallel/",
+            BM_PJH_Json_Parse_Parallel, json_data)
+            ->RangeMultiplier(2)
+            ->Range(1, 32)
+            ->UseRealTime();
+        // 同样的记录按行写出一份 NDJSON
+        std::string ndjson_path = (std::filesystem::temp_directory_path() / "pjh_json_bench.ndjson").string();
+        {
+            std::ofstream ofs(ndjson_path, std::ios::binary);
+            pjh_std::json::Document doc = pjh_std::json::Parser::parse_parallel(std::string_view(json_data));
+            if (doc.get()->is_array())
+                for (size_t idx = 0; idx < doc.get()->as_array()->size(); ++idx)
+                    ofs << doc[idx].get()->serialize() << '\n';
+        }
+        benchmark::RegisterBenchmark(
+            "PJH_NDJSON/",
+            BM_PJH_Json_Parse_NDJSON, ndjson_path)
+            ->RangeMultiplier(2)
+            ->Range(1, 32)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(
+            "PJH_Sax/",
+            BM_PJH_Json_Parse_Sax, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_Push/",
+            BM_PJH_Json_Parse_Push, json_data)
+            ->RangeMultiplier(4)
+            ->Range(16 << 10, 64 << 10);
+        benchmark::RegisterBenchmark(
+            "PJH_Lazy/",
+            BM_PJH_Json_Parse_Lazy, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_Allowlist/",
+            BM_PJH_Json_Parse_Allowlist, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_Path_Dom/",
+            BM_PJH_Json_Path, false);
+        benchmark::RegisterBenchmark(
+            "PJH_Path_Lazy/",
+            BM_PJH_Json_Path, true);
+        benchmark::RegisterBenchmark(
+            "PJH_Key_Lookup/",
+            BM_PJH_Json_Key_Lookup, false);
+        benchmark::RegisterBenchmark(
+            "PJH_Key_Lookup_Interned/",
+            BM_PJH_Json_Key_Lookup, true);
+        benchmark::RegisterBenchmark(
+            "PJH_Tape/",
+            BM_PJH_Json_Parse_Tape, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_StructuralIndex/",
+            BM_PJH_Structural_Index, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_Serialize/",
+            BM_PJH_Json_Serialize, json_data);
+        benchmark::RegisterBenchmark(
+            "PJH_File/",
+            BM_PJH_Json_Parse_File, path);
         benchmark::RegisterBenchmark(
             "Nlohmann/",
             BM_Nlohmann_Json_Parse, json_data);
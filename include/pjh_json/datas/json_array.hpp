@@ -22,12 +22,16 @@ namespace pjh_std
         class Array : public Element
         {
         private:
-            array_t<Element *> m_arr;      // 使用 vector 存储指向 Element 的指针
-            static ObjectPool<Array> pool; // 用于 Array 对象的静态对象池
+            using storage_t = std::vector<Element *, ArenaAllocator<Element *>>;
+
+            storage_t m_arr;               // 使用 vector 存储指向 Element 的指针
+            static ObjectPool<Array, ThreadCachedAllocator<Array>> pool; // 用于 Array 对象的静态对象池（线程安全）
 
         public:
             /// @brief 默认构造函数，创建空数组。
             Array() : m_arr() {}
+            /// @brief 构造函数，子元素指针表从 p_arena 上分配（p_arena 为空时使用堆）。
+            explicit Array(Arena *p_arena) : m_arr(ArenaAllocator<Element *>(p_arena)) {}
             /// @brief 构造函数，预分配指定大小的空间。
             Array(const size_t count) : m_arr(count) {}
             /// @brief 构造函数，从一个元素指针的 vector 创建数组（转移所有权）。
@@ -83,64 +87,58 @@ namespace pjh_std
             /// @brief 如果数组只有一个元素，则返回该元素，否则返回 nullptr。
             Element *as_element() const noexcept { return size() == 1 ? m_arr[0] : nullptr; }
             /// @brief 返回底层的元素指针 vector。
-            array_t<Element *> as_vector() const noexcept { return m_arr; }
+            array_t<Element *> as_vector() const noexcept { return array_t<Element *>(m_arr.begin(), m_arr.end()); }
 
         public:
             /// @brief 清空数组，并递归删除所有子元素，释放内存。
             void clear() override
             {
                 for (const auto &it : m_arr)
-                    if (it != nullptr)
-                        it->clear(), delete it;
+                    Element::release(it);
                 m_arr.clear();
             }
 
             /// @brief 创建并返回当前 Array 对象的深拷贝。
             Element *copy() const noexcept override { return new Array(this); }
 
-            /// @brief 将 Array 序列化为紧凑的 JSON 字符串。
-            string_t serialize() const noexcept override
+            /// @brief 将 Array 以紧凑格式写入 Writer。
+            void serialize_to(Writer &writer) const override
             {
-                std::ostringstream oss;
-                oss << '[';
+                writer.put('[');
                 bool is_first = true;
                 for (const auto &it : m_arr)
                 {
                     if (is_first)
                         is_first = false;
                     else
-                        oss << ',';
-                    oss << it->serialize();
+                        writer.put(',');
+                    it->serialize_to(writer);
                 }
-                oss << ']';
-                return oss.str();
+                writer.put(']');
             }
 
-            /// @brief 将 Array 序列化为带缩进的美化 JSON 字符串。
-            string_t pretty_serialize(size_t depth = 0, char table_ch = 't') const noexcept override
+            /// @brief 将 Array 以带缩进的美化格式写入 Writer。
+            void pretty_serialize_to(Writer &writer, size_t depth = 0, char table_ch = '\t') const override
             {
-                std::ostringstream oss;
-                oss << '[' << '\n';
+                writer.put('[');
+                writer.put('\n');
                 bool is_first = true;
                 for (const auto &it : m_arr)
                 {
                     if (is_first)
                         is_first = false;
                     else
-                        oss << ',' << '\n';
+                        writer.put(','), writer.put('\n');
 
                     // 添加当前层级的缩进
-                    for (size_t idx = 0; idx <= depth; ++idx)
-                        oss << table_ch;
+                    writer.put(table_ch, depth + 1);
                     // 递归序列化子元素，并增加深度
-                    oss << it->pretty_serialize(depth + 1, table_ch);
+                    it->pretty_serialize_to(writer, depth + 1, table_ch);
                 }
-                oss << '\n';
+                writer.put('\n');
                 // 添加闭合括号前的缩进
-                for (size_t idx = 0; idx < depth; ++idx)
-                    oss << table_ch;
-                oss << ']';
-                return oss.str();
+                writer.put(table_ch, depth);
+                writer.put(']');
             }
 
         public:
@@ -201,14 +199,20 @@ namespace pjh_std
             void set_raw_ptr(size_t idx, Element *child)
             {
                 if (size() <= idx)
-                    m_arr.resize(idx);
-                if (m_arr[idx] != nullptr)
-                    delete m_arr[idx];
+                    m_arr.resize(idx + 1);
+                Element::release(m_arr[idx]);
+                Element::note_child(m_arr.get_allocator().arena(), child);
                 m_arr[idx] = child;
             }
 
+            /// @brief 预留至少能容纳 p_count 个元素的空间。
+            void reserve(size_t p_count) { m_arr.reserve(p_count); }
             /// @brief 在数组末尾添加一个元素（转移所有权）。
-            void append_raw_ptr(Element *child) { m_arr.push_back(child); }
+            void append_raw_ptr(Element *child)
+            {
+                Element::note_child(m_arr.get_allocator().arena(), child);
+                m_arr.push_back(child);
+            }
             /// @brief 在数组末尾添加多个元素（转移所有权）。
             void append_all_raw_ptr(const std::vector<Element *> &children)
             {
@@ -228,7 +232,10 @@ namespace pjh_std
             /// @brief 添加各种基础类型值的便捷方法。
             void append(bool p_value) { append_raw_ptr(new Value(p_value)); }
             void append(int p_value) { append_raw_ptr(new Value(p_value)); }
+            void append(int64_t p_value) { append_raw_ptr(new Value(p_value)); }
+            void append(uint64_t p_value) { append_raw_ptr(new Value(p_value)); }
             void append(float p_value) { append_raw_ptr(new Value(p_value)); }
+            void append(double p_value) { append_raw_ptr(new Value(p_value)); }
             void append(const char *p_value) { append_raw_ptr(new Value(string_t(p_value))); }
             void append(const string_t &p_value) { append_raw_ptr(new Value(p_value)); }
             void append(char *p_value) { append_raw_ptr(new Value(p_value)); }
@@ -259,7 +266,7 @@ namespace pjh_std
             void operator delete(void *ptr) { Array::pool.deallocate(ptr); }
         };
         // 静态成员初始化
-        inline ObjectPool<Array> Array::pool;
+        inline ObjectPool<Array, ThreadCachedAllocator<Array>> Array::pool;
     }
 }
 
@@ -0,0 +1,140 @@
+#ifndef INCLUDE_JSON_DOCUMENT
+#define INCLUDE_JSON_DOCUMENT
+
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include <pjh_json/helpers/json_definition.hpp>
+#include <pjh_json/helpers/json_exception.hpp>
+#include <pjh_json/helpers/json_ref.hpp>
+
+#include <pjh_json/datas/json_element.hpp>
+
+#include <pjh_json/utils/arena.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class Document
+         * @brief 一份解析完成的 JSON 文档，同时拥有根元素和输入缓冲区。
+         *        树中的 string_view 直接指向输入缓冲区（例如一段文件映射），
+         *        Document 保证只要文档还活着，这块缓冲区就不会被释放。
+         *
+         * 由解析器生成的 Document 还拥有一个 Arena：所有节点、子元素指针表与哈希桶都分配在其中，
+         * 文档销毁时直接整体丢弃 Arena，无需递归地 clear() + delete 每个节点。
+         * 向这样的文档中插入新节点时，应使用 create() 在同一个 Arena 上构造。
+         */
+        class Document
+        {
+        private:
+            std::shared_ptr<const void> m_source; // 保持输入缓冲区存活（文件映射、字符串等）
+            std::shared_ptr<const void> m_keys;   // 保持对象键所在的驻留表存活（解析时设置了 key_table）
+            std::unique_ptr<Arena> m_arena;       // 节点所在的 Arena（可为空，此时节点位于堆上）
+            Element *m_root;                      // 文档的根元素，由 Document 负责释放
+
+        public:
+            /// @brief 默认构造函数，创建空文档。
+            Document() : m_source(), m_keys(), m_arena(), m_root(nullptr) {}
+            /// @brief 构造函数。@param p_root 根元素（转移所有权）。@param p_source 需要保持存活的输入缓冲区。
+            Document(Element *p_root, std::shared_ptr<const void> p_source)
+                : m_source(std::move(p_source)), m_keys(), m_arena(), m_root(p_root) {}
+            /// @brief 构造函数。@param p_root 根元素。@param p_source 需要保持存活的输入缓冲区。@param p_arena 节点所在的 Arena（转移所有权）。
+            Document(Element *p_root, std::shared_ptr<const void> p_source, std::unique_ptr<Arena> p_arena)
+                : m_source(std::move(p_source)), m_keys(), m_arena(std::move(p_arena)), m_root(p_root) {}
+
+            Document(const Document &) = delete;
+            Document &operator=(const Document &) = delete;
+
+            /// @brief 移动构造函数。
+            Document(Document &&other) noexcept
+                : m_source(std::move(other.m_source)), m_keys(std::move(other.m_keys)), m_arena(std::move(other.m_arena)),
+                  m_root(other.m_root) { other.m_root = nullptr; }
+            /// @brief 移动赋值运算符。
+            Document &operator=(Document &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    release();
+                    m_source = std::move(other.m_source);
+                    m_keys = std::move(other.m_keys);
+                    m_arena = std::move(other.m_arena);
+                    m_root = other.m_root;
+                    other.m_root = nullptr;
+                }
+                return *this;
+            }
+
+            /// @brief 析构函数，先释放整棵树，再释放输入缓冲区。
+            ~Document() { release(); }
+
+        public:
+            /// @brief 检查文档是否为空。
+            bool empty() const noexcept { return m_root == nullptr; }
+            /// @brief 获取根元素指针（所有权仍归 Document）。
+            Element *get() const noexcept { return m_root; }
+            /// @brief 以 Ref 的形式访问根元素。
+            Ref root() const { return Ref(m_root); }
+
+            /// @brief 获取文档的 Arena（没有时为空）。
+            Arena *arena() const noexcept { return m_arena.get(); }
+
+            /// @brief 让文档保持对象键所在的驻留表（KeyTable）存活。
+            void retain_keys(std::shared_ptr<const void> p_keys) noexcept { m_keys = std::move(p_keys); }
+
+            /**
+             * @brief 构造一个属于本文档的新元素：有 Arena 时分配在 Arena 上，否则分配在堆上。
+             *        Array / Object 的子元素指针表同样使用该 Arena；
+             *        以 string_t / C 字符串构造 Value 时，字符串会拷贝到 Arena 上。
+             */
+            template <typename T, typename... Args>
+            T *create(Args &&...args)
+            {
+                if (m_arena == nullptr)
+                    return new T(std::forward<Args>(args)...);
+                if constexpr (std::is_same_v<T, Array> || std::is_same_v<T, Object>)
+                {
+                    static_assert(sizeof...(Args) == 0, "containers are created empty");
+                    return Element::create_in<T>(*m_arena, m_arena.get());
+                }
+                else if constexpr (std::is_same_v<T, Value> && sizeof...(Args) == 1 && (Element::owns_string<Args> && ...))
+                    return Element::create_in<Value>(*m_arena, copy_string(string_v_t(args...)));
+                else
+                    return Element::create_in<T>(*m_arena, std::forward<Args>(args)...);
+            }
+
+            /// @brief 访问根 Object 的成员。
+            Ref operator[](string_v_t p_key) const { return root()[p_key]; }
+            /// @brief 访问根 Array 的成员。
+            Ref operator[](size_t p_index) const { return root()[p_index]; }
+
+        private:
+            /// @brief 把字符串拷贝到文档的 Arena 上。
+            string_v_t copy_string(string_v_t p_str)
+            {
+                char *out = static_cast<char *>(m_arena->allocate(p_str.size(), 1));
+                if (!p_str.empty())
+                    std::memcpy(out, p_str.data(), p_str.size());
+                return string_v_t(out, p_str.size());
+            }
+
+            /**
+             * @brief 释放整棵树与输入缓冲区。Arena 上的树随 Arena 整体释放；
+             *        只有树中挂着堆上的元素时，才需要先遍历整棵树释放它们。
+             */
+            void release() noexcept
+            {
+                if (m_root != nullptr && (!m_root->in_arena() || m_arena == nullptr || m_arena->has_heap_refs()))
+                    Element::release(m_root);
+                m_root = nullptr;
+                m_arena.reset();
+                m_keys.reset();
+                m_source.reset();
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_DOCUMENT
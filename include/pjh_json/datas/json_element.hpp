@@ -1,9 +1,14 @@
 #ifndef INCLUDE_JSON_ELEMENT
 #define INCLUDE_JSON_ELEMENT
 
+#include <type_traits>
+
 #include <pjh_json/helpers/json_definition.hpp>
 #include <pjh_json/helpers/json_exception.hpp>
 
+#include <pjh_json/utils/arena.hpp>
+#include <pjh_json/utils/writer.hpp>
+
 namespace pjh_std
 {
     namespace json
@@ -15,10 +20,57 @@ namespace pjh_std
          */
         class Element
         {
+        private:
+            bool m_in_arena = false; // 是否分配在 Arena 上（由 Arena 整体释放，不能单独 delete）
+
         public:
             /// @brief 虚析构函数。
             virtual ~Element() {}
 
+            /// @brief 参数类型会让 Value 持有一份堆上的字符串（string_t / C 字符串）。
+            template <typename Arg>
+            static constexpr bool owns_string = std::is_same_v<std::decay_t<Arg>, string_t> ||
+                                                std::is_same_v<std::decay_t<Arg>, const char *> ||
+                                                std::is_same_v<std::decay_t<Arg>, char *>;
+
+            /**
+             * @brief 在 Arena 上构造一个元素，它将随 Arena 一同被整体释放。
+             *        Arena 上元素的析构函数不会被调用，因此 Value 不能持有堆上的字符串：
+             *        请先把字符串拷贝到 Arena 上，以 string_v_t 构造（见 Document::create）。
+             */
+            template <typename T, typename... Args>
+            static T *create_in(Arena &p_arena, Args &&...args)
+            {
+                static_assert(!(std::is_same_v<T, Value> && (owns_string<Args> || ...)),
+                              "a Value on an Arena must not own a heap string; copy it into the Arena as string_v_t");
+                T *ptr = p_arena.create<T>(std::forward<Args>(args)...);
+                ptr->m_in_arena = true;
+                return ptr;
+            }
+
+            /**
+             * @brief 释放一个子元素：堆上的元素会被递归清空并删除；Arena 上的元素本身留给 Arena 统一回收，
+             *        但仍会递归清空，以释放其中挂着的堆上的子元素。
+             */
+            static void release(Element *p_child)
+            {
+                if (p_child == nullptr)
+                    return;
+                p_child->clear();
+                if (!p_child->m_in_arena)
+                    delete p_child;
+            }
+
+            /// @brief 把 p_child 挂到使用 p_arena 的容器上时调用：堆上的子元素需要在 Arena 释放前单独释放。
+            static void note_child(Arena *p_arena, const Element *p_child) noexcept
+            {
+                if (p_arena != nullptr && p_child != nullptr && !p_child->m_in_arena)
+                    p_arena->mark_heap_refs();
+            }
+
+            /// @brief 判断当前元素是否分配在 Arena 上。
+            bool in_arena() const noexcept { return m_in_arena; }
+
             /// @brief 判断当前元素是否为简单值 (Value)。
             virtual bool is_value() const noexcept { return false; }
             /// @brief 判断当前元素是否为数组 (Array)。
@@ -37,10 +89,25 @@ namespace pjh_std
             virtual void clear() {}
             /// @brief 创建并返回当前元素的一个深拷贝。
             virtual Element *copy() const = 0;
+            /// @brief 将当前元素以紧凑格式写入 Writer，子元素直接写入同一个 Writer，不产生中间字符串。
+            virtual void serialize_to(Writer &) const {}
+            /// @brief 将当前元素以带缩进的美化格式写入 Writer。
+            virtual void pretty_serialize_to(Writer &, size_t = 0, char = '\t') const {}
+
             /// @brief 将当前元素序列化为紧凑的 JSON 字符串。
-            virtual string_t serialize() const noexcept { return ""; }
+            string_t serialize() const noexcept
+            {
+                Writer writer;
+                serialize_to(writer);
+                return writer.str();
+            }
             /// @brief 将当前元素序列化为带缩进的美化 JSON 字符串。
-            virtual string_t pretty_serialize(size_t = 0, char = '\t') const noexcept { return ""; }
+            string_t pretty_serialize(size_t depth = 0, char table_ch = '\t') const noexcept
+            {
+                Writer writer;
+                pretty_serialize_to(writer, depth, table_ch);
+                return writer.str();
+            }
 
             /// @brief 比较两个元素是否相等。
             virtual bool operator==(const Element &other) const noexcept { return false; }
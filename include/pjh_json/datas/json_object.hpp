@@ -2,13 +2,20 @@
 #define INCLUDE_JSON_OBJECT
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
 
 #include <pjh_json/helpers/json_definition.hpp>
 #include <pjh_json/helpers/json_exception.hpp>
+#include <pjh_json/helpers/json_key_table.hpp>
 
 #include <pjh_json/datas/json_element.hpp>
 #include <pjh_json/datas/json_value.hpp>
 
+#include <pjh_json/utils/escape.hpp>
 #include <pjh_json/utils/object_pool.hpp>
 
 namespace pjh_std
@@ -18,24 +25,59 @@ namespace pjh_std
         /**
          * @class Object
          * @brief 表示一个 JSON 对象，即键值对的集合。
+         *
+         * 成员按插入顺序连续存放在一个数组里，序列化时保持输入中的顺序。
+         * 成员较少时查找是对键的线性比较（先比长度），超过 index_threshold 个成员后
+         * 再额外建立一个开放寻址的哈希索引；索引只存放成员下标，与成员数组一样从同一个分配器分配。
          */
         class Object : public Element
         {
+        public:
+            /// @brief 一个成员：(键, 值指针)。
+            using member_t = std::pair<string_v_t, Element *>;
+            /// @brief 成员数超过该值时建立哈希索引。
+            static constexpr size_t index_threshold = 16;
+
         private:
-            object_t<Element *> m_obj;      // 使用哈希表存储键和指向 Element 的指针
-            static ObjectPool<Object> pool; // 用于 Object 对象的静态对象池
+            using storage_t = std::vector<member_t, ArenaAllocator<member_t>>;
+
+            /// @brief 堆上的对象拷贝出的一个键，键的内容紧跟在结构之后，以单链表串起来随对象释放。
+            struct KeyBlock
+            {
+                KeyBlock *next;
+            };
+
+            static constexpr size_t npos = static_cast<size_t>(-1);
+            static constexpr size_t min_index_slots = 64;
+
+            storage_t m_members;   // 按插入顺序连续存放的成员
+            uint32_t *m_index;     // 哈希索引，槽中存放成员下标 + 1（0 表示空槽）；成员较少时为空
+            size_t m_index_slots;  // 索引的槽数（2 的幂）
+            KeyBlock *m_keys;      // 堆上的对象拷贝出的键
+            static ObjectPool<Object, ThreadCachedAllocator<Object>> pool; // 用于 Object 对象的静态对象池（线程安全）
 
         public:
             /// @brief 默认构造函数，创建空对象。
-            Object() { m_obj.clear(); };
-            /// @brief 构造函数，从一个键值对 map 创建对象（转移所有权）。
-            Object(const object_t<Element *> &val) noexcept { insert_all_raw_ptr(val); }
+            Object() noexcept : m_members(), m_index(nullptr), m_index_slots(0), m_keys(nullptr) {}
+            /// @brief 构造函数，成员数组、索引与拷贝的键都从 p_arena 上分配（p_arena 为空时使用堆）。
+            explicit Object(Arena *p_arena) noexcept
+                : m_members(storage_t::allocator_type(p_arena)), m_index(nullptr), m_index_slots(0), m_keys(nullptr) {}
+            /// @brief 构造函数，从一个键值对 map 创建对象（转移值的所有权，键会拷贝）。
+            Object(const object_t<Element *> &val) noexcept : Object() { insert_all_raw_ptr(val); }
 
             /// @brief 拷贝构造函数，深拷贝另一个 Object。
-            Object(const Object &other) noexcept { copy_and_insert_all(other.m_obj); }
-            Object(const Object *other) noexcept { copy_and_insert_all(other->m_obj); }
+            Object(const Object &other) noexcept : Object() { copy_members(other); }
+            Object(const Object *other) noexcept : Object() { copy_members(*other); }
             /// @brief 移动构造函数。
-            Object(Object &&other) noexcept : m_obj(std::move(other.m_obj)) {}
+            Object(Object &&other) noexcept
+                : m_members(std::move(other.m_members)), m_index(other.m_index),
+                  m_index_slots(other.m_index_slots), m_keys(other.m_keys)
+            {
+                other.m_members.clear();
+                other.m_index = nullptr;
+                other.m_index_slots = 0;
+                other.m_keys = nullptr;
+            }
 
             /// @brief 析构函数，会调用 clear() 来释放所有子元素的内存。
             ~Object() override { clear(); }
@@ -46,72 +88,76 @@ namespace pjh_std
             /// @brief 覆写基类方法，返回 this 指针。
             Object *as_object() override { return this; }
             /// @brief 返回底层的键值对 map。
-            object_t<Element *> as_raw_ptr_map() const noexcept { return m_obj; }
+            object_t<Element *> as_raw_ptr_map() const noexcept { return object_t<Element *>(m_members.begin(), m_members.end()); }
 
         public:
             /// @brief 清空对象，并递归删除所有子元素，释放内存。
             void clear() override
             {
-                for (auto it = m_obj.begin(); it != m_obj.end(); ++it)
-                    (it->second)->clear(), delete it->second;
-                m_obj.clear();
+                for (auto &member : m_members)
+                    Element::release(member.second);
+                m_members.clear();
+                release_index();
+                while (m_keys != nullptr)
+                {
+                    KeyBlock *next = m_keys->next;
+                    ::operator delete(m_keys);
+                    m_keys = next;
+                }
             }
 
             /// @brief 创建并返回当前 Object 对象的深拷贝。
             Object *copy() const noexcept override { return new Object(this); }
 
-            /// @brief 将 Object 序列化为紧凑的 JSON 字符串。
-            string_t serialize() const noexcept override
+            /// @brief 将 Object 以紧凑格式写入 Writer。
+            void serialize_to(Writer &writer) const override
             {
-                std::ostringstream oss;
-                oss << '{';
+                writer.put('{');
                 bool is_first = true;
-                for (const auto &[k, v] : m_obj)
+                for (const auto &[k, v] : m_members)
                 {
                     if (is_first)
                         is_first = false;
                     else
-                        oss << ',';
-                    oss << '\"' << k << '\"' << ':' << v->serialize();
+                        writer.put(',');
+                    escape::write_quoted(writer, k);
+                    writer.put(':');
+                    v->serialize_to(writer);
                 }
-                oss << '}';
-                return oss.str();
+                writer.put('}');
             }
 
-            /// @brief 将 Object 序列化为带缩进的美化 JSON 字符串。
-            string_t pretty_serialize(size_t depth = 0, char table_ch = '\t') const noexcept override
+            /// @brief 将 Object 以带缩进的美化格式写入 Writer。
+            void pretty_serialize_to(Writer &writer, size_t depth = 0, char table_ch = '\t') const override
             {
-                std::ostringstream oss;
-                oss << '{' << '\n';
+                writer.put('{');
+                writer.put('\n');
                 bool is_first = true;
-                for (const auto &[k, v] : m_obj)
+                for (const auto &[k, v] : m_members)
                 {
                     if (is_first)
                         is_first = false;
                     else
-                        oss << ',' << '\n';
+                        writer.put(','), writer.put('\n');
                     // 添加当前层级的缩进
-                    for (size_t idx = 0; idx <= depth; ++idx)
-                        oss << table_ch;
+                    writer.put(table_ch, depth + 1);
                     // 序列化键
-                    oss << '\"' << k << '\"' << ':';
+                    escape::write_quoted(writer, k);
+                    writer.put(':');
                     // 如果值不是简单类型，则换行并再次缩进
                     if (!(v->is_value()))
                     {
-                        oss << '\n';
-                        for (size_t idx = 0; idx <= depth; ++idx)
-                            oss << table_ch;
+                        writer.put('\n');
+                        writer.put(table_ch, depth + 1);
                     }
                     // 递归序列化值，并增加深度
-                    oss << v->pretty_serialize(depth + 1, table_ch);
+                    v->pretty_serialize_to(writer, depth + 1, table_ch);
                 }
 
-                oss << '\n';
+                writer.put('\n');
                 // 添加闭合括号前的缩进
-                for (size_t idx = 0; idx < depth; ++idx)
-                    oss << table_ch;
-                oss << '}';
-                return oss.str();
+                writer.put(table_ch, depth);
+                writer.put('}');
             }
 
         public:
@@ -120,12 +166,16 @@ namespace pjh_std
             {
                 if (this == &other)
                     return true;
-                return m_obj.size() == other.m_obj.size() &&
-                       std::equal(m_obj.begin(), m_obj.end(), other.m_obj.begin(),
-                                  [](
-                                      const std::pair<string_v_t, Element *> &a,
-                                      const std::pair<string_v_t, Element *> b)
-                                  { return a.second && b.second && *(a.second) == *(b.second); });
+                if (m_members.size() != other.m_members.size())
+                    return false;
+                // 与成员顺序无关：逐个按键在另一个对象中查找
+                for (const auto &[k, v] : m_members)
+                {
+                    const Element *rhs = other[k];
+                    if (v == nullptr || rhs == nullptr || *v != *rhs)
+                        return false;
+                }
+                return true;
             }
             bool operator!=(const Object &other) const noexcept { return !((*this) == other); }
 
@@ -140,23 +190,40 @@ namespace pjh_std
 
         public:
             /// @brief 返回对象中的键值对数量。
-            size_t size() const noexcept { return m_obj.size(); }
+            size_t size() const noexcept { return m_members.size(); }
             /// @brief 检查对象是否为空。
-            bool empty() const noexcept { return m_obj.empty(); }
+            bool empty() const noexcept { return m_members.empty(); }
             /// @brief 检查对象是否包含指定的键。
-            bool contains(string_v_t p_key) const noexcept { return m_obj.find(p_key) != m_obj.end(); }
+            bool contains(string_v_t p_key) const noexcept { return find(p_key) != npos; }
+            bool contains(const KeyTable::Key &p_key) const noexcept { return find(p_key) != npos; }
+            /// @brief 遍历成员的起点，按插入顺序，元素为 (键, 值指针)。
+            storage_t::const_iterator begin() const noexcept { return m_members.begin(); }
+            /// @brief 遍历成员的终点。
+            storage_t::const_iterator end() const noexcept { return m_members.end(); }
 
         public:
             /// @brief 通过键访问元素，不进行检查，若键不存在则返回 nullptr。
             Element *operator[](string_v_t p_key)
             {
-                auto it = m_obj.find(p_key);
-                return (it != m_obj.end()) ? it->second : nullptr;
+                size_t pos = find(p_key);
+                return pos != npos ? m_members[pos].second : nullptr;
             }
             const Element *operator[](string_v_t p_key) const
             {
-                auto it = m_obj.find(p_key);
-                return (it != m_obj.end()) ? it->second : nullptr;
+                size_t pos = find(p_key);
+                return pos != npos ? m_members[pos].second : nullptr;
+            }
+
+            /// @brief 通过驻留的键访问元素，不计算哈希，若键不存在则返回 nullptr。
+            Element *operator[](const KeyTable::Key &p_key)
+            {
+                size_t pos = find(p_key);
+                return pos != npos ? m_members[pos].second : nullptr;
+            }
+            const Element *operator[](const KeyTable::Key &p_key) const
+            {
+                size_t pos = find(p_key);
+                return pos != npos ? m_members[pos].second : nullptr;
             }
 
             /// @brief 通过键访问元素，若键不存在则抛出异常。
@@ -176,46 +243,204 @@ namespace pjh_std
                 else
                     throw InvalidKeyException("invalid key!");
             }
+            /// @brief 通过驻留的键访问元素，不计算哈希，若键不存在则抛出异常。
+            Element *get(const KeyTable::Key &p_key)
+            {
+                auto ret = operator[](p_key);
+                if (ret != nullptr)
+                    return ret;
+                else
+                    throw InvalidKeyException("invalid key!");
+            }
+            const Element *get(const KeyTable::Key &p_key) const
+            {
+                auto ret = operator[](p_key);
+                if (ret != nullptr)
+                    return ret;
+                else
+                    throw InvalidKeyException("invalid key!");
+            }
 
         public:
-            /// @brief 插入一个键值对（转移所有权），如果键已存在则会替换并删除旧值。
+            /**
+             * @brief 插入一个键值对（转移值的所有权），如果键已存在则会替换并删除旧值。
+             *        键只保存视图，调用者需保证键的内容与对象同生命周期（例如位于输入或同一 Arena 上）；
+             *        临时的键请使用 insert_raw_ptr_copy_key。
+             */
             void insert_raw_ptr(const string_v_t &p_key, Element *child)
             {
-                auto it = m_obj.find(p_key);
-                if (it != m_obj.end())
-                    delete it->second;
-                m_obj[p_key] = child;
+                size_t pos = find(p_key);
+                if (pos != npos)
+                    replace(pos, child);
+                else
+                    append(p_key, child);
             }
-            /// @brief 插入多个键值对（转移所有权）。
+            /// @brief 同 insert_raw_ptr，但键的内容会拷贝一份到对象自己的存储中（Arena 或堆）。
+            void insert_raw_ptr_copy_key(string_v_t p_key, Element *child)
+            {
+                size_t pos = find(p_key);
+                if (pos != npos)
+                    replace(pos, child);
+                else
+                    append(copy_key(p_key), child);
+            }
+            /// @brief 插入多个键值对（转移值的所有权，键会拷贝）。
             void insert_all_raw_ptr(const object_t<Element *> &other)
             {
                 for (auto &child : other)
-                    insert_raw_ptr(child.first, child.second);
+                    insert_raw_ptr_copy_key(child.first, child.second);
             }
 
-            /// @brief 插入一个键值对（拷贝值）。
-            void copy_and_insert(const string_v_t &property, const Element &child) { insert_raw_ptr(property, child.copy()); }
-            /// @brief 插入多个键值对（拷贝值）。
+            /// @brief 插入一个键值对（拷贝值与键）。
+            void copy_and_insert(const string_v_t &property, const Element &child) { insert_raw_ptr_copy_key(property, child.copy()); }
+            /// @brief 插入多个键值对（拷贝值与键）。
             void copy_and_insert_all(const object_t<Element *> &other) noexcept
             {
                 for (const auto &child : other)
                     copy_and_insert(child.first, *(child.second));
             }
 
-            /// @brief 插入各种基础类型值的便捷方法。
-            void insert(const string_t &p_key, bool p_value) { insert_raw_ptr(p_key, new Value(p_value)); }
-            void insert(const string_t &p_key, int p_value) { insert_raw_ptr(p_key, new Value(p_value)); }
-            void insert(const string_t &p_key, float p_value) { insert_raw_ptr(p_key, new Value(p_value)); }
-            void insert(const string_t &p_key, const char *p_value) { insert_raw_ptr(p_key, new Value(string_t(p_value))); }
-            void insert(const string_t &p_key, const string_t &p_value) { insert_raw_ptr(p_key, new Value(p_value)); }
+            /// @brief 插入各种基础类型值的便捷方法（键会拷贝）。
+            void insert(const string_t &p_key, bool p_value) { insert_raw_ptr_copy_key(p_key, new Value(p_value)); }
+            void insert(const string_t &p_key, int p_value) { insert_raw_ptr_copy_key(p_key, new Value(p_value)); }
+            void insert(const string_t &p_key, int64_t p_value) { insert_raw_ptr_copy_key(p_key, new Value(p_value)); }
+            void insert(const string_t &p_key, uint64_t p_value) { insert_raw_ptr_copy_key(p_key, new Value(p_value)); }
+            void insert(const string_t &p_key, float p_value) { insert_raw_ptr_copy_key(p_key, new Value(p_value)); }
+            void insert(const string_t &p_key, double p_value) { insert_raw_ptr_copy_key(p_key, new Value(p_value)); }
+            void insert(const string_t &p_key, const char *p_value) { insert_raw_ptr_copy_key(p_key, new Value(string_t(p_value))); }
+            void insert(const string_t &p_key, const string_t &p_value) { insert_raw_ptr_copy_key(p_key, new Value(p_value)); }
 
             /// @brief 重载 new 运算符，使用对象池进行内存分配。
             void *operator new(std::size_t n) { return Object::pool.allocate(n); }
             /// @brief 重载 delete 运算符，将内存归还给对象池。
             void operator delete(void *ptr) { Object::pool.deallocate(ptr); }
+
+        private:
+            /// @brief 查找键所在的成员下标，不存在时返回 npos。
+            size_t find(string_v_t p_key) const noexcept
+            {
+                if (m_index == nullptr)
+                {
+                    for (size_t i = 0; i < m_members.size(); ++i)
+                        if (m_members[i].first == p_key)
+                            return i;
+                    return npos;
+                }
+                const size_t mask = m_index_slots - 1;
+                for (size_t slot = StringViewHash()(p_key) & mask; m_index[slot] != 0; slot = (slot + 1) & mask)
+                    if (m_members[m_index[slot] - 1].first == p_key)
+                        return m_index[slot] - 1;
+                return npos;
+            }
+
+            /**
+             * @brief 按驻留的键查找成员下标：线性查找时只比较指针，索引查找时使用 Key 中保存的哈希值。
+             *        成员的键不是同一份驻留内容（例如未经驻留插入）时再按内容比较。
+             */
+            size_t find(const KeyTable::Key &p_key) const noexcept
+            {
+                if (!p_key.valid())
+                    return npos;
+                if (m_index == nullptr)
+                {
+                    for (size_t i = 0; i < m_members.size(); ++i)
+                        if (p_key.same(m_members[i].first))
+                            return i;
+                    return find(p_key.view());
+                }
+                const size_t mask = m_index_slots - 1;
+                for (size_t slot = p_key.hash() & mask; m_index[slot] != 0; slot = (slot + 1) & mask)
+                {
+                    const string_v_t key = m_members[m_index[slot] - 1].first;
+                    if (p_key.same(key) || key == p_key.view())
+                        return m_index[slot] - 1;
+                }
+                return npos;
+            }
+
+            /// @brief 替换已有成员的值，并释放旧值。
+            void replace(size_t p_pos, Element *child)
+            {
+                Element::release(m_members[p_pos].second);
+                Element::note_child(m_members.get_allocator().arena(), child);
+                m_members[p_pos].second = child;
+            }
+
+            /// @brief 追加一个新成员（调用者保证键不存在），必要时建立或扩大索引。
+            void append(string_v_t p_key, Element *child)
+            {
+                Element::note_child(m_members.get_allocator().arena(), child);
+                m_members.emplace_back(p_key, child);
+                if (m_members.size() <= index_threshold)
+                    return;
+                // 负载因子保持在 1/2 以下
+                if (m_index == nullptr || m_members.size() * 2 > m_index_slots)
+                    rebuild_index();
+                else
+                    index(m_members.size() - 1);
+            }
+
+            /// @brief 把第 p_pos 个成员放进索引。
+            void index(size_t p_pos) noexcept
+            {
+                const size_t mask = m_index_slots - 1;
+                size_t slot = StringViewHash()(m_members[p_pos].first) & mask;
+                while (m_index[slot] != 0)
+                    slot = (slot + 1) & mask;
+                m_index[slot] = static_cast<uint32_t>(p_pos + 1);
+            }
+
+            /// @brief 按当前成员数重新分配并填充索引。
+            void rebuild_index()
+            {
+                size_t slots = min_index_slots;
+                while (slots < m_members.size() * 4)
+                    slots *= 2;
+                release_index();
+                m_index = ArenaAllocator<uint32_t>(m_members.get_allocator()).allocate(slots);
+                m_index_slots = slots;
+                std::fill(m_index, m_index + slots, uint32_t(0));
+                for (size_t i = 0; i < m_members.size(); ++i)
+                    index(i);
+            }
+
+            /// @brief 释放索引（Arena 上的索引随 Arena 整体释放）。
+            void release_index() noexcept
+            {
+                if (m_index != nullptr)
+                    ArenaAllocator<uint32_t>(m_members.get_allocator()).deallocate(m_index, m_index_slots);
+                m_index = nullptr;
+                m_index_slots = 0;
+            }
+
+            /// @brief 把键拷贝到对象所在的 Arena 上，堆上的对象则拷贝到随对象释放的键块中。
+            string_v_t copy_key(string_v_t p_key)
+            {
+                char *out;
+                if (Arena *arena = m_members.get_allocator().arena())
+                    out = static_cast<char *>(arena->allocate(p_key.size(), 1));
+                else
+                {
+                    KeyBlock *block = static_cast<KeyBlock *>(::operator new(sizeof(KeyBlock) + p_key.size()));
+                    block->next = m_keys;
+                    m_keys = block;
+                    out = reinterpret_cast<char *>(block + 1);
+                }
+                if (!p_key.empty())
+                    std::memcpy(out, p_key.data(), p_key.size());
+                return string_v_t(out, p_key.size());
+            }
+
+            /// @brief 深拷贝另一个对象的全部成员（键与值），保持其顺序。
+            void copy_members(const Object &other)
+            {
+                m_members.reserve(other.m_members.size());
+                for (const auto &[k, v] : other.m_members)
+                    append(copy_key(k), v->copy());
+            }
         };
         // 静态成员初始化
-        inline ObjectPool<Object> Object::pool;
+        inline ObjectPool<Object, ThreadCachedAllocator<Object>> Object::pool;
     }
 }
 
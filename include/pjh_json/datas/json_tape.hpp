@@ -0,0 +1,504 @@
+#ifndef INCLUDE_JSON_TAPE
+#define INCLUDE_JSON_TAPE
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <pjh_json/helpers/json_definition.hpp>
+#include <pjh_json/helpers/json_exception.hpp>
+
+#include <pjh_json/utils/escape.hpp>
+#include <pjh_json/utils/number.hpp>
+#include <pjh_json/utils/writer.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @enum TapeType
+         * @brief 磁带（Tape）中每个条目的类型标签，存放在条目的最高 8 位。
+         */
+        enum class TapeType : uint8_t
+        {
+            Null,
+            True,
+            False,
+            Int,         // 后随一个条目，存放 int64_t 的原始位
+            UInt,        // 后随一个条目，存放超出 int64_t 范围的 uint64_t
+            Float,       // 后随一个条目，存放 double 的原始位
+            String,      // 负载为字符串池中的偏移
+            ArrayBegin,  // 负载为匹配的 ArrayEnd 之后的下标
+            ArrayEnd,    // 负载为数组元素个数
+            ObjectBegin, // 负载为匹配的 ObjectEnd 之后的下标
+            ObjectEnd,   // 负载为对象键值对个数
+        };
+
+        /**
+         * @class Tape
+         * @brief 扁平的只读 JSON 文档：所有节点按先序依次存放在一段连续的 uint64_t 数组中，
+         *        字符串统一拷贝进一个字符串池。数组与对象的起始条目记录了到匹配结束条目之后的跳转下标，
+         *        因此跳过整个子树是 O(1) 的，访问时也无需逐节点的堆分配与指针追踪。
+         *
+         * 每个条目的布局：高 8 位为 TapeType，低 56 位为负载。
+         * 对象的成员按 “键（String 条目）, 值” 的顺序交替存放，保持原文中的顺序。
+         */
+        class Tape
+        {
+        public:
+            /// @brief 负载所占的位数。
+            static constexpr unsigned payload_bits = 56;
+            /// @brief 负载的掩码。
+            static constexpr uint64_t payload_mask = (uint64_t(1) << payload_bits) - 1;
+
+        private:
+            std::vector<uint64_t> m_entries; // 按先序排列的条目
+            string_t m_strings;              // 字符串池：每个字符串为 “uint64_t 长度 + 字节”
+
+        public:
+            Tape() = default;
+
+        public:
+            /// @brief 检查磁带是否为空。
+            bool empty() const noexcept { return m_entries.empty(); }
+            /// @brief 获取条目数量。
+            size_t size() const noexcept { return m_entries.size(); }
+            /// @brief 获取字符串池的字节数。
+            size_t string_bytes() const noexcept { return m_strings.size(); }
+            /// @brief 清空磁带，保留已分配的容量以便复用。
+            void clear() noexcept
+            {
+                m_entries.clear();
+                m_strings.clear();
+            }
+            /// @brief 预留条目与字符串池的容量。
+            void reserve(size_t p_entries, size_t p_string_bytes)
+            {
+                m_entries.reserve(p_entries);
+                m_strings.reserve(p_string_bytes);
+            }
+
+            /// @brief 以 TapeRef 的形式访问根值。
+            TapeRef root() const;
+            /// @brief 访问根 Object 的成员。
+            TapeRef operator[](string_v_t p_key) const;
+            /// @brief 访问根 Array 的成员。
+            TapeRef operator[](size_t p_index) const;
+
+            /// @brief 获取下标处条目的类型。
+            TapeType type_at(size_t p_index) const noexcept { return static_cast<TapeType>(m_entries[p_index] >> payload_bits); }
+            /// @brief 获取下标处条目的负载。
+            uint64_t payload_at(size_t p_index) const noexcept { return m_entries[p_index] & payload_mask; }
+            /// @brief 获取下标处的原始条目。
+            uint64_t raw_at(size_t p_index) const noexcept { return m_entries[p_index]; }
+
+            /// @brief 获取下标处的值之后（跳过整个子树）的下一个下标。
+            size_t next_index(size_t p_index) const noexcept
+            {
+                switch (type_at(p_index))
+                {
+                case TapeType::ArrayBegin:
+                case TapeType::ObjectBegin:
+                    return static_cast<size_t>(payload_at(p_index));
+                case TapeType::Int:
+                case TapeType::UInt:
+                case TapeType::Float:
+                    return p_index + 2;
+                default:
+                    return p_index + 1;
+                }
+            }
+
+            /// @brief 读取下标处 String 条目所指的字符串。
+            string_v_t string_at(size_t p_index) const noexcept
+            {
+                const size_t offset = static_cast<size_t>(payload_at(p_index));
+                uint64_t length;
+                std::memcpy(&length, m_strings.data() + offset, sizeof(length));
+                return string_v_t(m_strings.data() + offset + sizeof(length), static_cast<size_t>(length));
+            }
+            /// @brief 读取下标处 Int 条目的值。
+            int64_t int_at(size_t p_index) const noexcept { return static_cast<int64_t>(m_entries[p_index + 1]); }
+            /// @brief 读取下标处 UInt 条目的值。
+            uint64_t uint_at(size_t p_index) const noexcept { return m_entries[p_index + 1]; }
+            /// @brief 读取下标处 Float 条目的值。
+            double float_at(size_t p_index) const noexcept
+            {
+                double value;
+                std::memcpy(&value, &m_entries[p_index + 1], sizeof(value));
+                return value;
+            }
+
+        public:
+            // 构建接口：按先序依次追加条目，供解析器使用。
+
+            /// @brief 追加一个不带负载的标量条目（Null / True / False）。
+            void append_literal(TapeType p_type) { push(p_type, 0); }
+            /// @brief 追加一个整数条目。
+            void append_int(int64_t p_value)
+            {
+                push(TapeType::Int, 0);
+                m_entries.push_back(static_cast<uint64_t>(p_value));
+            }
+            /// @brief 追加一个超出 int64_t 范围的无符号整数条目。
+            void append_uint(uint64_t p_value)
+            {
+                push(TapeType::UInt, 0);
+                m_entries.push_back(p_value);
+            }
+            /// @brief 追加一个浮点数条目。
+            void append_float(double p_value)
+            {
+                uint64_t bits;
+                std::memcpy(&bits, &p_value, sizeof(bits));
+                push(TapeType::Float, 0);
+                m_entries.push_back(bits);
+            }
+            /// @brief 按数字的类型追加对应的条目。
+            void append_number(int p_value) { append_int(p_value); }
+            void append_number(int64_t p_value) { append_int(p_value); }
+            void append_number(uint64_t p_value)
+            {
+                if (p_value > static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+                    append_uint(p_value);
+                else
+                    append_int(static_cast<int64_t>(p_value));
+            }
+            void append_number(float p_value) { append_float(p_value); }
+            void append_number(double p_value) { append_float(p_value); }
+            /// @brief 追加一个字符串条目，字符串内容会被拷贝进字符串池。
+            void append_string(string_v_t p_str)
+            {
+                const uint64_t length = p_str.size();
+                push(TapeType::String, m_strings.size());
+                m_strings.append(reinterpret_cast<const char *>(&length), sizeof(length));
+                m_strings.append(p_str.data(), p_str.size());
+            }
+            /// @brief 开始一个数组或对象，返回其起始条目的下标，用于稍后回填跳转下标。
+            size_t begin_container(TapeType p_type)
+            {
+                const size_t index = m_entries.size();
+                push(p_type, 0);
+                return index;
+            }
+            /// @brief 结束由 begin_container 开始的数组或对象。@param p_begin 起始条目下标。@param p_count 元素（或键值对）个数。
+            void end_container(size_t p_begin, size_t p_count)
+            {
+                const TapeType end_type = type_at(p_begin) == TapeType::ArrayBegin ? TapeType::ArrayEnd : TapeType::ObjectEnd;
+                push(end_type, p_count);
+                m_entries[p_begin] = entry(type_at(p_begin), m_entries.size());
+            }
+
+        private:
+            /// @brief 组合类型与负载。
+            static uint64_t entry(TapeType p_type, uint64_t p_payload) noexcept
+            {
+                return (static_cast<uint64_t>(p_type) << payload_bits) | (p_payload & payload_mask);
+            }
+            /// @brief 追加一个条目。
+            void push(TapeType p_type, uint64_t p_payload) { m_entries.push_back(entry(p_type, p_payload)); }
+        };
+
+        /**
+         * @class TapeRef
+         * @brief 指向 Tape 中某个值的只读游标，提供与 Ref 类似的链式访问语法，
+         *        例如 `tape_ref["key"][0].as_int()`。游标本身只是 (Tape 指针, 下标)，可随意拷贝。
+         *        Tape 必须比所有指向它的 TapeRef 活得更久。
+         */
+        class TapeRef
+        {
+        private:
+            const Tape *m_tape; // 所指向的磁带
+            size_t m_index;     // 值的起始条目下标
+
+        public:
+            /**
+             * @class Iterator
+             * @brief 依次遍历数组元素或对象成员的值；遍历对象时可通过 key() 取得当前成员的键。
+             */
+            class Iterator
+            {
+            private:
+                const Tape *m_tape;
+                size_t m_index;   // 当前元素（对象中为当前键）的下标
+                bool m_is_object; // 所遍历的容器是否为对象
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = TapeRef;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = TapeRef;
+
+                Iterator(const Tape *p_tape, size_t p_index, bool p_is_object)
+                    : m_tape(p_tape), m_index(p_index), m_is_object(p_is_object) {}
+
+                /// @brief 当前元素的值。
+                TapeRef operator*() const { return TapeRef(m_tape, m_is_object ? m_index + 1 : m_index); }
+                /// @brief 当前成员的键（仅遍历对象时有效）。
+                string_v_t key() const
+                {
+                    if (!m_is_object)
+                        throw TypeException("Not an object");
+                    return m_tape->string_at(m_index);
+                }
+                /// @brief 判断当前成员的键是否等于 p_key（仅遍历对象时有效）。
+                bool key_equals(string_v_t p_key) const { return key() == p_key; }
+
+                Iterator &operator++()
+                {
+                    m_index = m_tape->next_index(m_is_object ? m_index + 1 : m_index);
+                    return *this;
+                }
+                Iterator operator++(int)
+                {
+                    Iterator old = *this;
+                    ++(*this);
+                    return old;
+                }
+
+                bool operator==(const Iterator &other) const noexcept { return m_index == other.m_index; }
+                bool operator!=(const Iterator &other) const noexcept { return m_index != other.m_index; }
+            };
+
+        public:
+            /// @brief 构造函数。@param p_tape 所指向的磁带。@param p_index 值的起始条目下标。
+            TapeRef(const Tape *p_tape = nullptr, size_t p_index = 0) : m_tape(p_tape), m_index(p_index) {}
+
+            /// @brief 获取值的起始条目下标。
+            size_t index() const noexcept { return m_index; }
+            /// @brief 获取值的类型标签。
+            TapeType type() const
+            {
+                check();
+                return m_tape->type_at(m_index);
+            }
+
+            /// @brief 重载 [] 运算符，用于访问 Object 的成员（线性查找，保持原文顺序）。
+            TapeRef operator[](string_v_t p_key) const
+            {
+                if (!is_object())
+                    throw TypeException("Not an object");
+                const size_t end = m_tape->payload_at(m_index) - 1;
+                for (size_t i = m_index + 1; i < end; i = m_tape->next_index(i + 1))
+                    if (m_tape->string_at(i) == p_key)
+                        return TapeRef(m_tape, i + 1);
+                throw InvalidKeyException("Key not found!");
+            }
+
+            /// @brief 重载 [] 运算符，用于访问 Array 的成员。
+            TapeRef operator[](size_t p_index) const
+            {
+                if (!is_array())
+                    throw TypeException("Not an array");
+                if (p_index >= size())
+                    throw OutOfRangeException("Index out of range!");
+                size_t i = m_index + 1;
+                for (; p_index > 0; --p_index)
+                    i = m_tape->next_index(i);
+                return TapeRef(m_tape, i);
+            }
+
+        public:
+            /// @brief 获取 Array 或 Object 的大小，标量返回 1。
+            size_t size() const
+            {
+                if (is_array() || is_object())
+                    return static_cast<size_t>(m_tape->payload_at(m_tape->payload_at(m_index) - 1));
+                return 1;
+            }
+
+            /// @brief 遍历的起点（仅对 Array / Object 有效）。
+            Iterator begin() const
+            {
+                if (!is_array() && !is_object())
+                    throw TypeException("Not a container");
+                return Iterator(m_tape, m_index + 1, is_object());
+            }
+            /// @brief 遍历的终点。
+            Iterator end() const
+            {
+                if (!is_array() && !is_object())
+                    throw TypeException("Not a container");
+                return Iterator(m_tape, m_tape->payload_at(m_index) - 1, is_object());
+            }
+
+        public:
+            /// @brief 检查值是否为 null。
+            bool is_null() const { return type() == TapeType::Null; }
+            /// @brief 检查值是否为布尔值。
+            bool is_bool() const { return type() == TapeType::True || type() == TapeType::False; }
+            /// @brief 检查值是否为整数。
+            bool is_int() const { return type() == TapeType::Int || type() == TapeType::UInt; }
+            /// @brief 检查值是否为浮点数。
+            bool is_float() const { return type() == TapeType::Float; }
+            /// @brief 检查值是否为字符串。
+            bool is_str() const { return type() == TapeType::String; }
+            /// @brief 检查值是否为数组。
+            bool is_array() const { return type() == TapeType::ArrayBegin; }
+            /// @brief 检查值是否为对象。
+            bool is_object() const { return type() == TapeType::ObjectBegin; }
+
+        public:
+            /// @brief 以布尔值形式获取值。
+            bool as_bool() const
+            {
+                if (is_bool())
+                    return type() == TapeType::True;
+                throw TypeException("Not an bool value");
+            }
+            /// @brief 以整数形式获取值，允许从浮点数转换，超出 int64_t 范围时抛出异常。
+            int64_t as_int() const
+            {
+                if (type() == TapeType::UInt)
+                    throw OutOfRangeException("Integer out of int64 range!");
+                if (is_int())
+                    return m_tape->int_at(m_index);
+                if (is_float())
+                {
+                    int64_t value;
+                    if (!number::truncate_to_int64(m_tape->float_at(m_index), value))
+                        throw OutOfRangeException("Number out of int64 range!");
+                    return value;
+                }
+                throw TypeException("Not an int value");
+            }
+            /// @brief 以 64 位无符号整数形式获取值，负数时抛出异常。
+            uint64_t as_uint64() const
+            {
+                if (type() == TapeType::UInt)
+                    return m_tape->uint_at(m_index);
+                const int64_t value = as_int();
+                if (value < 0)
+                    throw OutOfRangeException("Negative integer out of uint64 range!");
+                return static_cast<uint64_t>(value);
+            }
+            /// @brief 以浮点数形式获取值。
+            double as_float() const
+            {
+                if (is_float())
+                    return m_tape->float_at(m_index);
+                throw TypeException("Not an float value");
+            }
+            /// @brief 以字符串视图形式获取值，视图指向 Tape 的字符串池。
+            string_v_t as_str() const
+            {
+                if (is_str())
+                    return m_tape->string_at(m_index);
+                throw TypeException("Not an string value");
+            }
+
+        public:
+            /// @brief 将游标所指的值序列化为紧凑字符串，格式与 Element::serialize 一致。
+            string_t serialize() const
+            {
+                Writer writer;
+                serialize_to(writer);
+                return writer.str();
+            }
+
+            /// @brief 将游标所指的值以紧凑格式写入 Writer。
+            void serialize_to(Writer &p_writer) const
+            {
+                check();
+                size_t index = m_index;
+                write_value(p_writer, index);
+            }
+
+        private:
+            /// @brief 检查游标是否有效。
+            void check() const
+            {
+                if (m_tape == nullptr)
+                    throw NullPointerException("Null reference");
+            }
+
+            /// @brief 以与 Value 相同的格式写出一个数字。
+            template <typename T>
+            static void write_number(Writer &p_out, T p_number)
+            {
+                char *buffer = p_out.reserve(number::max_format_length);
+                if constexpr (std::is_floating_point_v<T>)
+                    p_out.commit(number::format_floating(buffer, p_number) - buffer);
+                else
+                    p_out.commit(number::format_integer(buffer, p_number) - buffer);
+            }
+
+            /// @brief 递归地序列化 p_index 处的值，并把 p_index 移动到该值之后。
+            void write_value(Writer &p_out, size_t &p_index) const
+            {
+                switch (m_tape->type_at(p_index))
+                {
+                case TapeType::Null:
+                    p_out.write("null", 4);
+                    ++p_index;
+                    return;
+                case TapeType::True:
+                    p_out.write("true", 4);
+                    ++p_index;
+                    return;
+                case TapeType::False:
+                    p_out.write("false", 5);
+                    ++p_index;
+                    return;
+                case TapeType::Int:
+                    write_number(p_out, m_tape->int_at(p_index));
+                    p_index += 2;
+                    return;
+                case TapeType::UInt:
+                    write_number(p_out, m_tape->uint_at(p_index));
+                    p_index += 2;
+                    return;
+                case TapeType::Float:
+                    write_number(p_out, m_tape->float_at(p_index));
+                    p_index += 2;
+                    return;
+                case TapeType::String:
+                    escape::write_quoted(p_out, m_tape->string_at(p_index));
+                    ++p_index;
+                    return;
+                case TapeType::ArrayBegin:
+                case TapeType::ObjectBegin:
+                {
+                    const bool is_obj = m_tape->type_at(p_index) == TapeType::ObjectBegin;
+                    const size_t end = m_tape->payload_at(p_index) - 1;
+                    p_out.put(is_obj ? '{' : '[');
+                    ++p_index;
+                    while (p_index < end)
+                    {
+                        if (is_obj)
+                        {
+                            escape::write_quoted(p_out, m_tape->string_at(p_index));
+                            p_out.put(':');
+                            ++p_index;
+                        }
+                        write_value(p_out, p_index);
+                        if (p_index < end)
+                            p_out.put(',');
+                    }
+                    p_out.put(is_obj ? '}' : ']');
+                    p_index = end + 1;
+                    return;
+                }
+                default:
+                    throw SerializationException("Invalid tape entry");
+                }
+            }
+        };
+
+        inline TapeRef Tape::root() const
+        {
+            if (empty())
+                throw NullPointerException("Empty tape");
+            return TapeRef(this, 0);
+        }
+        inline TapeRef Tape::operator[](string_v_t p_key) const { return root()[p_key]; }
+        inline TapeRef Tape::operator[](size_t p_index) const { return root()[p_index]; }
+    }
+}
+
+#endif // INCLUDE_JSON_TAPE
@@ -1,11 +1,15 @@
 #ifndef INCLUDE_JSON_VALUE
 #define INCLUDE_JSON_VALUE
 
+#include <limits>
+
 #include <pjh_json/helpers/json_definition.hpp>
 #include <pjh_json/helpers/json_exception.hpp>
 
 #include <pjh_json/datas/json_element.hpp>
 
+#include <pjh_json/utils/escape.hpp>
+#include <pjh_json/utils/number.hpp>
 #include <pjh_json/utils/object_pool.hpp>
 
 namespace pjh_std
@@ -15,12 +19,13 @@ namespace pjh_std
         /**
          * @class Value
          * @brief 表示一个 JSON 的基本值，如 null, bool, int, float, string。
+         *        超出 int 范围的整数以 int64_t / uint64_t 存储，float 无法精确表示的小数以 double 存储。
          */
         class Value : public Element
         {
         private:
             value_t m_value;               // 使用 std::variant 存储具体的值
-            static ObjectPool<Value> pool; // 用于 Value 对象的静态对象池
+            static ObjectPool<Value, ThreadCachedAllocator<Value>> pool; // 用于 Value 对象的静态对象池（线程安全）
 
         public:
             /// @brief 默认构造函数，创建一个 null 值。
@@ -29,7 +34,10 @@ namespace pjh_std
             explicit Value(std::nullptr_t) : m_value(nullptr) {}
             explicit Value(bool p_value) : m_value(p_value) {}
             explicit Value(int p_value) : m_value(p_value) {}
+            explicit Value(int64_t p_value) : m_value(p_value) {}
+            explicit Value(uint64_t p_value) : m_value(p_value) {}
             explicit Value(float p_value) : m_value(p_value) {}
+            explicit Value(double p_value) : m_value(p_value) {}
 
             explicit Value(const char *p_value) : m_value(string_t(p_value)) {}
             explicit Value(const string_t &p_value) : m_value(p_value) {}
@@ -42,19 +50,25 @@ namespace pjh_std
             /// @brief 移动构造函数。
             Value(Value &&other) noexcept : m_value(std::move(other.m_value)) { other.m_value = nullptr; }
 
-            /// @brief 拷贝赋值运算符。
+            /// @brief 拷贝赋值运算符。Arena 上的 Value 不会被析构，因此不能被赋予堆上的字符串。
             Value &operator=(const Value &other)
             {
                 if (this != &other)
+                {
+                    check_assignable(other);
                     this->m_value = other.m_value;
+                }
                 return *this;
             }
 
             /// @brief 移动赋值运算符。
-            Value &operator=(Value &&other) noexcept
+            Value &operator=(Value &&other)
             {
                 if (this != &other)
+                {
+                    check_assignable(other);
                     this->m_value = std::move(other.m_value);
+                }
                 return *this;
             }
 
@@ -75,6 +89,14 @@ namespace pjh_std
             }
             ~Value() override = default;
 
+        private:
+            /// @brief Arena 上的 Value 不能持有堆上的字符串（其析构函数不会被调用）。
+            void check_assignable(const Value &other) const
+            {
+                if (in_arena() && other.is_T<string_t>())
+                    throw TypeException("Cannot assign an owning string to a Value on an Arena!");
+            }
+
         public:
             /// @brief 覆写基类方法，表明这是一个 Value 类型。
             bool is_value() const noexcept override { return true; }
@@ -82,14 +104,23 @@ namespace pjh_std
             Value *as_value() override { return this; }
 
         public:
-            /// @brief 比较两个 Value 对象是否相等。
-            bool operator==(Value &other) const noexcept
+            /// @brief 比较两个 Value 对象是否相等。数字按数值比较，与存储所用的具体类型无关。
+            bool operator==(const Value &other) const noexcept
             {
                 if (this == &other)
                     return true;
+                if (is_int() && other.is_int())
+                {
+                    // 两边符号不同则必然不等，否则在同一种 64 位类型下比较
+                    if (is_T<uint64_t>() || other.is_T<uint64_t>())
+                        return fits_uint64() && other.fits_uint64() && raw_uint64() == other.raw_uint64();
+                    return raw_int64() == other.raw_int64();
+                }
+                if (is_float() && other.is_float())
+                    return raw_double() == other.raw_double();
                 return m_value == other.m_value;
             }
-            bool operator!=(Value &other) const noexcept { return !((*this) == other); }
+            bool operator!=(const Value &other) const noexcept { return !((*this) == other); }
 
             /// @brief 比较 Value 和 Element 对象是否相等。
             bool operator==(const Element &other) const noexcept override
@@ -115,10 +146,10 @@ namespace pjh_std
             bool is_null() const noexcept { return is_T<std::nullptr_t>(); }
             /// @brief 检查是否为布尔值。
             bool is_bool() const noexcept { return is_T<bool>(); }
-            /// @brief 检查是否为整数。
-            bool is_int() const noexcept { return is_T<int>(); }
-            /// @brief 检查是否为浮点数。
-            bool is_float() const noexcept { return is_T<float>(); }
+            /// @brief 检查是否为整数（int、int64_t 或 uint64_t）。
+            bool is_int() const noexcept { return is_T<int>() || is_T<int64_t>() || is_T<uint64_t>(); }
+            /// @brief 检查是否为浮点数（float 或 double）。
+            bool is_float() const noexcept { return is_T<float>() || is_T<double>(); }
             /// @brief 检查是否为字符串。
             bool is_str() const noexcept { return is_T<string_t>() || is_T<string_v_t>(); }
 
@@ -131,6 +162,28 @@ namespace pjh_std
                 return m_value.get<T>();
             }
 
+        private:
+            /// @brief 以 int64_t 读取整数（uint64_t 按位转换，调用方需先检查范围）。
+            int64_t raw_int64() const noexcept
+            {
+                if (is_T<int>())
+                    return as_T<int>();
+                if (is_T<int64_t>())
+                    return as_T<int64_t>();
+                return static_cast<int64_t>(as_T<uint64_t>());
+            }
+            /// @brief 以 uint64_t 读取整数（调用方需先检查 fits_uint64）。
+            uint64_t raw_uint64() const noexcept
+            {
+                if (is_T<uint64_t>())
+                    return as_T<uint64_t>();
+                return static_cast<uint64_t>(raw_int64());
+            }
+            /// @brief 整数是否非负（即可以用 uint64_t 表示）。
+            bool fits_uint64() const noexcept { return is_T<uint64_t>() || raw_int64() >= 0; }
+            /// @brief 以 double 读取浮点数。
+            double raw_double() const noexcept { return is_T<float>() ? as_T<float>() : as_T<double>(); }
+
         public:
             /// @brief 获取底层的 std::variant 值。
             value_t get_value() { return m_value; }
@@ -144,26 +197,92 @@ namespace pjh_std
                     throw TypeException("Not bool type!");
             }
 
-            /// @brief 获取整数值，允许从浮点数转换，否则抛出异常。
+            /// @brief 获取整数值，允许从浮点数转换，超出 int 范围时抛出异常。
             int as_int() const
             {
-                if (is_int())
+                if (is_T<int>())
                     return as_T<int>();
+                const int64_t value = as_int64();
+                if (value < (std::numeric_limits<int>::min)() || value > (std::numeric_limits<int>::max)())
+                    throw OutOfRangeException("Integer out of int range!");
+                return static_cast<int>(value);
+            }
+
+            /// @brief 获取 64 位有符号整数值，允许从浮点数转换，超出范围时抛出异常。
+            int64_t as_int64() const
+            {
+                if (is_int())
+                {
+                    if (is_T<uint64_t>() && as_T<uint64_t>() > static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+                        throw OutOfRangeException("Integer out of int64 range!");
+                    return raw_int64();
+                }
+                else if (is_float())
+                {
+                    int64_t value;
+                    if (!number::truncate_to_int64(raw_double(), value))
+                        throw OutOfRangeException("Number out of int64 range!");
+                    return value;
+                }
+                else
+                    throw TypeException("Not int type!");
+            }
+
+            /// @brief 获取 64 位无符号整数值，允许从浮点数转换，负数或超出范围时抛出异常。
+            uint64_t as_uint64() const
+            {
+                if (is_int())
+                {
+                    if (!fits_uint64())
+                        throw OutOfRangeException("Negative integer out of uint64 range!");
+                    return raw_uint64();
+                }
                 else if (is_float())
-                    return (int)as_T<float>();
+                {
+                    if (raw_double() < 0)
+                        throw OutOfRangeException("Negative number out of uint64 range!");
+                    uint64_t value;
+                    if (!number::truncate_to_uint64(raw_double(), value))
+                        throw OutOfRangeException("Number out of uint64 range!");
+                    return value;
+                }
                 else
                     throw TypeException("Not int type!");
             }
 
-            /// @brief 获取浮点数值，若类型不匹配则抛出异常。
+            /// @brief 获取浮点数值（double 会被收窄为 float），若类型不匹配则抛出异常。
             float as_float() const
             {
-                if (is_float())
+                if (is_T<float>())
                     return as_T<float>();
+                else if (is_T<double>())
+                    return static_cast<float>(as_T<double>());
+                else
+                    throw TypeException("Not float type!");
+            }
+
+            /// @brief 获取双精度浮点数值，若类型不匹配则抛出异常。
+            double as_double() const
+            {
+                if (is_float())
+                    return raw_double();
                 else
                     throw TypeException("Not float type!");
             }
 
+            /// @brief 以 double 获取任意数字（超出 53 位的整数会损失精度），若不是数字则抛出异常。
+            double as_number() const
+            {
+                if (is_T<uint64_t>())
+                    return static_cast<double>(as_T<uint64_t>());
+                else if (is_int())
+                    return static_cast<double>(raw_int64());
+                else if (is_float())
+                    return raw_double();
+                else
+                    throw TypeException("Not number type!");
+            }
+
             /// @brief 获取字符串值，若类型不匹配则抛出异常。
             string_t as_str() const
             {
@@ -175,31 +294,48 @@ namespace pjh_std
                     throw TypeException("Not string type!");
             }
 
+            /// @brief 获取字符串值的视图（不拷贝，与 Value 同生命周期），若类型不匹配则抛出异常。
+            string_v_t as_str_view() const
+            {
+                if (is_T<string_t>())
+                    return m_value.get<string_t>();
+                else if (is_T<string_v_t>())
+                    return m_value.get<string_v_t>();
+                else
+                    throw TypeException("Not string type!");
+            }
+
         public:
             /// @brief 创建并返回当前 Value 对象的深拷贝。
             Element *copy() const noexcept override { return new Value(this); }
 
-            /// @brief 将 Value 序列化为紧凑字符串。
-            string_t serialize() const noexcept override
+            /// @brief 将 Value 以紧凑格式写入 Writer。
+            void serialize_to(Writer &writer) const override
             {
-                if (is_int())
-                    return std::to_string(as_int());
-                else if (is_float())
-                    return std::to_string(as_float());
-                else if (is_str())
-                    return "\"" + as_str() + "\"";
+                if (is_int() || is_float())
+                {
+                    // 数字直接格式化进输出缓冲区
+                    char *buffer = writer.reserve(number::max_format_length);
+                    char *end = is_T<uint64_t>() ? number::format_integer(buffer, as_T<uint64_t>())
+                                : is_int()       ? number::format_integer(buffer, raw_int64())
+                                : is_T<float>()  ? number::format_floating(buffer, as_T<float>())
+                                                 : number::format_floating(buffer, as_T<double>());
+                    writer.commit(end - buffer);
+                }
+                else if (is_T<string_t>())
+                    escape::write_quoted(writer, m_value.get<string_t>());
+                else if (is_T<string_v_t>())
+                    escape::write_quoted(writer, as_T<string_v_t>());
                 else if (is_bool())
-                    return as_bool() ? "true" : "false";
+                    writer.write(as_bool() ? string_v_t("true") : string_v_t("false"));
                 else if (is_null())
-                    return "null";
-                else
-                    return "";
+                    writer.write("null", 4);
             }
 
-            /// @brief 将 Value 序列化为美化字符串（与紧凑版相同）。
-            string_t pretty_serialize(size_t depth = 0, char = '\t') const noexcept override
+            /// @brief 将 Value 以美化格式写入 Writer（与紧凑版相同）。
+            void pretty_serialize_to(Writer &writer, size_t = 0, char = '\t') const override
             {
-                return serialize();
+                serialize_to(writer);
             }
 
             /// @brief 重载 new 运算符，使用对象池进行内存分配。
@@ -208,7 +344,7 @@ namespace pjh_std
             void operator delete(void *ptr) { Value::pool.deallocate(ptr); }
         };
         // 静态成员初始化
-        inline ObjectPool<Value> Value::pool;
+        inline ObjectPool<Value, ThreadCachedAllocator<Value>> Value::pool;
     }
 }
 
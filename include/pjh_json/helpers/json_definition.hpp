@@ -1,6 +1,7 @@
 #ifndef INCLUDE_JSON_DEFINITIONS
 #define INCLUDE_JSON_DEFINITIONS
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -21,6 +22,9 @@ namespace pjh_std
         class Value;
         class Object;
         class Array;
+        class Document;
+        class Tape;
+        class TapeRef;
 
         // 为 std::string 定义一个更简洁的别名
         using string_t = std::string;
@@ -28,13 +32,17 @@ namespace pjh_std
         using string_v_t = std::string_view;
 
         // 使用 std::variant 定义 JSON 的值类型，它可以持有多种不同的基础数据类型
+        // 数字按能精确表示它的最窄类型存储：int / int64_t / uint64_t，float / double
         using value_t = Variant<
             std::nullptr_t,
             bool,
             int,
             float,
             string_t,
-            string_v_t>;
+            string_v_t,
+            int64_t,
+            uint64_t,
+            double>;
 
         // JSON 数组的模板别名，底层使用 std::vector
         template <typename T>
@@ -72,6 +80,7 @@ namespace pjh_std
         class OutOfRangeException;
         class InvalidKeyException;
         class SerializationException;
+        class FileException;
 
         // 提前声明并发缓冲和内存管理相关类
         template <typename T>
@@ -84,9 +93,14 @@ namespace pjh_std
         class BlockAllocator;
         template <typename T>
         class FreeListAllocator;
+        template <typename T, size_t BatchSize>
+        class ThreadCachedAllocator;
 
         template <typename T, typename Allocate>
         class ObjectPool;
+
+        // 提前声明文件映射相关类
+        class MappedFile;
     }
 }
 #endif // INCLUDE_JSON_DEFINITIONS
\ No newline at end of file
@@ -1,10 +1,13 @@
 #ifndef INCLUDE_JSON_EXCEPTION
 #define INCLUDE_JSON_EXCEPTION
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <pjh_json/helpers/json_definition.hpp>
 
+#include <pjh_json/utils/simd.hpp>
+
 namespace pjh_std
 {
     namespace json
@@ -31,6 +34,9 @@ namespace pjh_std
         class ParseException : public Exception
         {
         public:
+            /// @brief 未知字节偏移时 offset() 的返回值。
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
             /**
              * @brief 构造函数，包含错误发生的行号和列号。
              * @param p_line 错误发生的行号。
@@ -38,18 +44,64 @@ namespace pjh_std
              * @param msg 具体的错误信息。
              */
             ParseException(size_t p_line, size_t p_col, const std::string &msg)
-                : Exception(
-                      "Parse error at line " + std::to_string(p_line) +
-                      ", column " + std::to_string(p_col) + ": " + msg),
-                  m_line(p_line), m_col(p_col) {}
+                : ParseException(Location{p_line, p_col}, npos, msg) {}
+
+            /**
+             * @brief 构造函数，只需给出错误发生的字节偏移。
+             *        行号和列号直到此时才从原文推算（向量化地统计换行符），
+             *        因此解析的热路径上只需维护当前位置，而无需逐字节统计行列。
+             * @param p_source 被解析的原文。
+             * @param p_offset 错误发生处相对原文开头的字节偏移。
+             * @param msg 具体的错误信息。
+             */
+            ParseException(string_v_t p_source, size_t p_offset, const std::string &msg)
+                : ParseException(locate(p_source, p_offset), p_offset, msg) {}
+
+            /**
+             * @brief 构造函数，直接给出行号、列号与字节偏移（例如把一条记录内的位置换算为整个输入流中的位置）。
+             */
+            ParseException(size_t p_line, size_t p_col, size_t p_offset, const std::string &msg)
+                : ParseException(Location{p_line, p_col}, p_offset, msg) {}
 
             /// @brief 获取错误行号。
             size_t line() const noexcept { return m_line; }
             /// @brief 获取错误列号。
             size_t column() const noexcept { return m_col; }
+            /// @brief 获取错误的字节偏移，未知时为 npos。
+            size_t offset() const noexcept { return m_offset; }
+            /// @brief 获取不含位置前缀的错误信息。
+            const std::string &message() const noexcept { return m_message; }
 
         private:
-            size_t m_line, m_col; // 存储错误位置的行号和列号
+            /// @brief 行号与列号（均从 1 开始）。
+            struct Location
+            {
+                size_t line, col;
+            };
+
+            ParseException(Location p_location, size_t p_offset, const std::string &msg)
+                : Exception(
+                      "Parse error at line " + std::to_string(p_location.line) +
+                      ", column " + std::to_string(p_location.col) + ": " + msg),
+                  m_line(p_location.line), m_col(p_location.col), m_offset(p_offset), m_message(msg) {}
+
+            /// @brief 根据字节偏移推算行号与列号。
+            static Location locate(string_v_t p_source, size_t p_offset) noexcept
+            {
+                p_offset = (std::min)(p_offset, p_source.size());
+                const char *begin = p_source.data();
+                const size_t line = 1 + simd::count_char(simd::detect_level(), begin, begin + p_offset, '\n');
+                // 从出错位置向前找到本行的起点
+                size_t line_start = p_offset;
+                while (line_start > 0 && begin[line_start - 1] != '\n')
+                    --line_start;
+                return {line, p_offset - line_start + 1};
+            }
+
+        private:
+            size_t m_line, m_col;  // 存储错误位置的行号和列号
+            size_t m_offset;       // 错误位置的字节偏移
+            std::string m_message; // 不含位置前缀的错误信息
         };
 
         /**
@@ -107,6 +159,17 @@ namespace pjh_std
                 : Exception("Null pointer error: " + msg) {}
         };
 
+        /**
+         * @class FileException
+         * @brief 打开、读取或映射输入文件失败时抛出的异常。
+         */
+        class FileException : public Exception
+        {
+        public:
+            explicit FileException(const std::string &msg)
+                : Exception("File error: " + msg) {}
+        };
+
         /**
          * @class ThreadException
          * @brief 在多线程操作中发生错误时抛出的异常。
@@ -0,0 +1,222 @@
+#ifndef INCLUDE_JSON_KEY_TABLE
+#define INCLUDE_JSON_KEY_TABLE
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include <pjh_json/helpers/json_definition.hpp>
+
+#include <pjh_json/utils/arena.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class KeyTable
+         * @brief 对象键的驻留表：相同内容的键只保存一份，并得到同一个 Key（稳定的指针与编号）。
+         *
+         * 通过 ParseOptions::key_table 交给 Parser 后，解析出的对象键都指向表中的内容，
+         * 不再依赖输入缓冲区；同一张表可以在多个文档、多个 Parser 乃至多个线程之间共享。
+         * 查找预先驻留好的 Key 时，Object 只需比较指针，并直接使用 Key 中保存的哈希值。
+         * 表只增不减，驻留的内容与表同生命周期；解析为 Document 时文档会保持表存活。
+         * 所有成员函数都是线程安全的。
+         */
+        class KeyTable
+        {
+        public:
+            /**
+             * @class Key
+             * @brief 驻留后的键。同一张表中内容相同的键总是指向同一份内容，因此可以按指针比较。
+             */
+            class Key
+            {
+            private:
+                const char *m_data; // 表中的内容
+                size_t m_size;      // 内容的长度
+                size_t m_hash;      // StringViewHash 计算出的哈希值
+                uint32_t m_id;      // 在表中的编号，按驻留顺序从 0 开始
+
+                friend class KeyTable;
+
+                Key(const char *p_data, size_t p_size, size_t p_hash, uint32_t p_id) noexcept
+                    : m_data(p_data), m_size(p_size), m_hash(p_hash), m_id(p_id) {}
+
+            public:
+                /// @brief 默认构造函数，创建无效的 Key。
+                Key() noexcept : m_data(nullptr), m_size(0), m_hash(0), m_id(0) {}
+
+                /// @brief 是否是驻留表中的键（查找失败时得到无效的 Key）。
+                bool valid() const noexcept { return m_data != nullptr; }
+                /// @brief 键的内容。
+                string_v_t view() const noexcept { return string_v_t(m_data, m_size); }
+                /// @brief 键的哈希值，与 StringViewHash 的结果相同。
+                size_t hash() const noexcept { return m_hash; }
+                /// @brief 键在表中的编号。
+                uint32_t id() const noexcept { return m_id; }
+
+                /// @brief 判断一个键的内容是否就是这份驻留的内容（指针与长度都相同）。
+                bool same(string_v_t p_key) const noexcept { return p_key.data() == m_data && p_key.size() == m_size; }
+
+                bool operator==(const Key &other) const noexcept { return m_data == other.m_data && m_size == other.m_size; }
+                bool operator!=(const Key &other) const noexcept { return !((*this) == other); }
+            };
+
+            /**
+             * @class Cache
+             * @brief 单个线程使用的驻留缓存（例如一个 Parser），不是线程安全的。
+             *        最近用到的键按长度与首尾字符放进一个小的直接映射表，命中时只需一次内容比较，
+             *        既不计算哈希也不加锁；未命中时才交给共享的 KeyTable。
+             */
+            class Cache
+            {
+            public:
+                /// @brief 缓存的槽数。
+                static constexpr size_t slots = 64;
+
+            private:
+                std::shared_ptr<KeyTable> m_table; // 共享的驻留表
+                Key m_slots[slots];                // 最近用到的键
+
+            public:
+                /// @brief 构造函数。@param p_table 共享的驻留表。
+                explicit Cache(std::shared_ptr<KeyTable> p_table) noexcept : m_table(std::move(p_table)), m_slots() {}
+
+                /// @brief 驻留一个键。
+                Key intern(string_v_t p_key)
+                {
+                    Key &cached = m_slots[slot_of(p_key)];
+                    if (cached.valid() && cached.view() == p_key)
+                        return cached;
+                    cached = m_table->intern(p_key);
+                    return cached;
+                }
+
+                /// @brief 获取共享的驻留表。
+                const std::shared_ptr<KeyTable> &table() const noexcept { return m_table; }
+
+            private:
+                static size_t slot_of(string_v_t p_key) noexcept
+                {
+                    if (p_key.empty())
+                        return 0;
+                    const size_t mix = p_key.size() * 31 +
+                                       static_cast<unsigned char>(p_key.front()) * 7 +
+                                       static_cast<unsigned char>(p_key.back());
+                    return mix & (slots - 1);
+                }
+            };
+
+        private:
+            static constexpr size_t min_slots = 64;
+
+            mutable std::shared_mutex m_mutex; // 查找取共享锁，插入取独占锁
+            Arena m_storage;                   // 键的内容
+            std::vector<Key> m_keys;           // 按编号排列的键
+            std::vector<uint32_t> m_slots;     // 开放寻址的哈希索引，槽中存放编号 + 1（0 表示空槽）
+
+        public:
+            /// @brief 构造函数，创建空表。
+            KeyTable() : m_mutex(), m_storage(4096), m_keys(), m_slots() {}
+
+            KeyTable(const KeyTable &) = delete;
+            KeyTable &operator=(const KeyTable &) = delete;
+
+            /// @brief 进程内共享的全局驻留表。
+            static const std::shared_ptr<KeyTable> &global()
+            {
+                static const std::shared_ptr<KeyTable> table = std::make_shared<KeyTable>();
+                return table;
+            }
+
+        public:
+            /// @brief 驻留一个键：已存在时返回已有的 Key，否则拷贝一份内容并分配新的编号。
+            Key intern(string_v_t p_key)
+            {
+                const size_t hash = StringViewHash()(p_key);
+                {
+                    std::shared_lock<std::shared_mutex> lock(m_mutex);
+                    if (const Key *key = lookup(p_key, hash))
+                        return *key;
+                }
+                std::unique_lock<std::shared_mutex> lock(m_mutex);
+                if (const Key *key = lookup(p_key, hash))
+                    return *key;
+                char *data = static_cast<char *>(m_storage.allocate(p_key.size(), 1));
+                if (!p_key.empty())
+                    std::memcpy(data, p_key.data(), p_key.size());
+                m_keys.push_back(Key(data, p_key.size(), hash, static_cast<uint32_t>(m_keys.size())));
+                // 负载因子保持在 1/2 以下
+                if (m_keys.size() * 2 > m_slots.size())
+                    rehash();
+                else
+                    place(m_keys.size() - 1);
+                return m_keys.back();
+            }
+
+            /// @brief 查找一个已驻留的键，不存在时返回无效的 Key。
+            Key find(string_v_t p_key) const
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                const Key *key = lookup(p_key, StringViewHash()(p_key));
+                return key != nullptr ? *key : Key();
+            }
+
+            /// @brief 按编号获取键，编号越界时抛出 std::out_of_range。
+            Key at(uint32_t p_id) const
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                return m_keys.at(p_id);
+            }
+
+            /// @brief 已驻留的键的数量。
+            size_t size() const
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                return m_keys.size();
+            }
+
+        private:
+            /// @brief 在索引中查找键，调用者需持有锁。
+            const Key *lookup(string_v_t p_key, size_t p_hash) const noexcept
+            {
+                if (m_slots.empty())
+                    return nullptr;
+                const size_t mask = m_slots.size() - 1;
+                for (size_t slot = p_hash & mask; m_slots[slot] != 0; slot = (slot + 1) & mask)
+                {
+                    const Key &key = m_keys[m_slots[slot] - 1];
+                    if (key.m_hash == p_hash && key.view() == p_key)
+                        return &key;
+                }
+                return nullptr;
+            }
+
+            /// @brief 把第 p_id 个键放进索引，调用者需持有独占锁。
+            void place(size_t p_id) noexcept
+            {
+                const size_t mask = m_slots.size() - 1;
+                size_t slot = m_keys[p_id].m_hash & mask;
+                while (m_slots[slot] != 0)
+                    slot = (slot + 1) & mask;
+                m_slots[slot] = static_cast<uint32_t>(p_id + 1);
+            }
+
+            /// @brief 按当前键数重新分配并填充索引，调用者需持有独占锁。
+            void rehash()
+            {
+                size_t slots = min_slots;
+                while (slots < m_keys.size() * 4)
+                    slots *= 2;
+                m_slots.assign(slots, 0);
+                for (size_t i = 0; i < m_keys.size(); ++i)
+                    place(i);
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_KEY_TABLE
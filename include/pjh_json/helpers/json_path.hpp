@@ -0,0 +1,757 @@
+#ifndef INCLUDE_JSON_PATH
+#define INCLUDE_JSON_PATH
+
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pjh_json/helpers/json_definition.hpp>
+#include <pjh_json/helpers/json_exception.hpp>
+
+#include <pjh_json/datas/json_array.hpp>
+#include <pjh_json/datas/json_element.hpp>
+#include <pjh_json/datas/json_object.hpp>
+#include <pjh_json/datas/json_tape.hpp>
+#include <pjh_json/datas/json_value.hpp>
+
+#include <pjh_json/utils/number.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class Path
+         * @brief 预先编译的查询路径，编译一次后可以对任意多个文档反复求值。
+         *
+         * 支持两种写法：
+         * - JSON Pointer（RFC 6901），由 pointer() 编译，例如 "/items/0/name"，"~0" 与 "~1" 分别表示 '~' 与 '/'；
+         * - JSONPath 的一个子集，由 compile() 编译，以 '$' 开头，支持
+         *   `.name`、`['name']`、`[0]`（负数从末尾计数）、`.*` / `[*]`、递归下降 `..name` / `..*` / `..[0]`，
+         *   以及过滤器 `[?(@.price < 10)]`：`@` 之后可跟若干 `.name` / `['name']` / `[0]`，
+         *   比较运算为 == != < <= > >=，右侧为数字、字符串、true、false 或 null；省略比较时表示成员存在。
+         *   数字一律按 double 比较，不同类型的值只满足 !=。
+         *
+         * 求值对象可以是 DOM（传入 Element*，成员查找直接走对象的哈希表，不经过 Ref），
+         * 也可以是 TapeRef 或 LazyRef 这样的游标：对 LazyDocument 求值时只扫描路径经过的值，
+         * 未被选中的子树按括号匹配整体跳过，因此只有选中的值才会被转换。
+         * 路径语法错误抛出 ParseException，位置为表达式中的字节偏移；求值时找不到的成员不抛异常，只是没有结果。
+         */
+        class Path
+        {
+        private:
+            /// @brief 路径中一步的类型。
+            enum class StepType
+            {
+                Member,     // JSON Pointer 的一段：对象按键查找，数组按下标查找
+                Key,        // 对象成员
+                Index,      // 数组元素
+                Wildcard,   // 所有子元素
+                Descendant, // 自身及所有后代（后面紧跟的一步作用于其中每一个）
+                Filter      // 满足条件的子元素
+            };
+
+            /// @brief 标量的种类。
+            enum class Kind
+            {
+                None,
+                Null,
+                Bool,
+                Number,
+                String
+            };
+
+            /// @brief 过滤器中的比较运算。
+            enum class Op
+            {
+                Exists,
+                Eq,
+                Ne,
+                Lt,
+                Le,
+                Gt,
+                Ge
+            };
+
+            struct Step
+            {
+                StepType type;
+                string_t key{};    // Member / Key 的键
+                int64_t index = 0; // Member / Index 的下标（Member 不是合法下标时为 -1）
+                size_t filter = 0; // Filter 在 m_filters 中的下标
+            };
+
+            /// @brief 过滤条件：从当前元素出发的相对路径，与一个字面量比较。
+            struct Condition
+            {
+                std::vector<Step> path;
+                Op op = Op::Exists;
+                Kind kind = Kind::None;
+                bool boolean = false;
+                double number = 0;
+                string_t str;
+            };
+
+            /// @brief 被比较的值。字符串视图指向文档。
+            struct Scalar
+            {
+                Kind kind = Kind::None;
+                bool boolean = false;
+                double number = 0;
+                string_v_t str;
+            };
+
+            string_t m_text;                  // 原始表达式
+            std::vector<Step> m_steps;        // 编译后的步骤
+            std::vector<Condition> m_filters; // 过滤条件
+
+        public:
+            /// @brief 默认构造函数，得到只选中根本身的路径。
+            Path() = default;
+
+            /**
+             * @brief 编译一个 JSON Pointer（RFC 6901）。
+             * @param p_pointer 空串表示根，否则必须以 '/' 开头。
+             */
+            static Path pointer(string_v_t p_pointer)
+            {
+                Path path;
+                path.m_text = string_t(p_pointer);
+                if (p_pointer.empty())
+                    return path;
+                if (p_pointer[0] != '/')
+                    throw path.error(0, "JSON pointer must start with '/'");
+                size_t pos = 1;
+                while (true)
+                {
+                    size_t end = p_pointer.find('/', pos);
+                    if (end == string_v_t::npos)
+                        end = p_pointer.size();
+                    Step step{StepType::Member};
+                    for (size_t i = pos; i < end; ++i)
+                    {
+                        if (p_pointer[i] != '~')
+                        {
+                            step.key.push_back(p_pointer[i]);
+                            continue;
+                        }
+                        const char next = i + 1 < end ? p_pointer[i + 1] : '\0';
+                        if (next != '0' && next != '1')
+                            throw path.error(i, "Invalid escape in JSON pointer");
+                        step.key.push_back(next == '0' ? '~' : '/');
+                        ++i;
+                    }
+                    step.index = array_index(step.key);
+                    path.m_steps.push_back(std::move(step));
+                    if (end == p_pointer.size())
+                        return path;
+                    pos = end + 1;
+                }
+            }
+
+            /// @brief 编译一个 JSONPath 表达式（见类说明中支持的子集）。
+            static Path compile(string_v_t p_expression)
+            {
+                Path path;
+                path.m_text = string_t(p_expression);
+                Compiler compiler{path, path.m_text, 0};
+                compiler.run();
+                return path;
+            }
+
+        public:
+            /// @brief 获取原始表达式。
+            const string_t &text() const noexcept { return m_text; }
+            /// @brief 路径是否最多选中一个值（只由键与下标组成）。
+            bool is_singular() const noexcept
+            {
+                for (const Step &step : m_steps)
+                    if (step.type != StepType::Member && step.type != StepType::Key && step.type != StepType::Index)
+                        return false;
+                return true;
+            }
+
+        public:
+            /// @brief 在 DOM 上求值，追加所有选中的元素（对象的成员按 Object 的遍历顺序访问）。
+            void select(Element *p_root, std::vector<Element *> &p_out) const
+            {
+                if (p_root != nullptr)
+                    eval(p_root, 0, [&p_out](Element *p_element)
+                         { return p_out.push_back(p_element), false; });
+            }
+            /// @brief 在 DOM 上求值，返回所有选中的元素。
+            std::vector<Element *> select(Element *p_root) const
+            {
+                std::vector<Element *> out;
+                select(p_root, out);
+                return out;
+            }
+            /// @brief 在 DOM 上求值，返回第一个选中的元素，没有时返回 nullptr。找到后立即停止。
+            Element *find(Element *p_root) const
+            {
+                Element *found = nullptr;
+                if (p_root != nullptr)
+                    eval(p_root, 0, [&found](Element *p_element)
+                         { return found = p_element, true; });
+                return found;
+            }
+
+            /// @brief 在游标（TapeRef / LazyRef）上求值，按原文顺序追加所有选中的值。
+            template <typename Cursor, typename = std::enable_if_t<!std::is_pointer_v<Cursor>>>
+            void select(const Cursor &p_root, std::vector<Cursor> &p_out) const
+            {
+                eval(p_root, 0, [&p_out](const Cursor &p_value)
+                     { return p_out.push_back(p_value), false; });
+            }
+            /// @brief 在游标上求值，返回所有选中的值。
+            template <typename Cursor, typename = std::enable_if_t<!std::is_pointer_v<Cursor>>>
+            std::vector<Cursor> select(const Cursor &p_root) const
+            {
+                std::vector<Cursor> out;
+                select(p_root, out);
+                return out;
+            }
+            /// @brief 在游标上求值，把第一个选中的值写入 p_out 并立即停止。@return 是否找到。
+            template <typename Cursor, typename = std::enable_if_t<!std::is_pointer_v<Cursor>>>
+            bool find(const Cursor &p_root, Cursor &p_out) const
+            {
+                return eval(p_root, 0, [&p_out](const Cursor &p_value)
+                            { return p_out = p_value, true; });
+            }
+
+        private:
+            /// @brief 构造一个位于表达式中 p_pos 处的异常。
+            ParseException error(size_t p_pos, const std::string &msg) const { return ParseException(m_text, p_pos, msg); }
+
+            /// @brief 把 JSON Pointer 的一段解释为数组下标（"0" 或不以 0 开头的数字），不是合法下标时返回 -1。
+            static int64_t array_index(string_v_t p_token) noexcept
+            {
+                if (p_token.empty() || (p_token[0] == '0' && p_token.size() > 1))
+                    return -1;
+                int64_t value = 0;
+                for (char ch : p_token)
+                {
+                    if (ch < '0' || ch > '9' || value > ((std::numeric_limits<int64_t>::max)() - 9) / 10)
+                        return -1;
+                    value = value * 10 + (ch - '0');
+                }
+                return value;
+            }
+
+            /**
+             * @brief 从第 p_step 步开始对 p_node 求值，每选中一个值就调用 p_out；p_out 返回 true 时停止。
+             * @return 是否已经停止。
+             */
+            template <typename Node, typename Out>
+            bool eval(const Node &p_node, size_t p_step, Out &&p_out) const
+            {
+                if (p_step == m_steps.size())
+                    return p_out(p_node);
+                const Step &step = m_steps[p_step];
+                Node next{};
+                switch (step.type)
+                {
+                case StepType::Member:
+                    if (is_object(p_node))
+                        return child(p_node, step.key, next) && eval(next, p_step + 1, p_out);
+                    return step.index >= 0 && element(p_node, step.index, next) && eval(next, p_step + 1, p_out);
+                case StepType::Key:
+                    return child(p_node, step.key, next) && eval(next, p_step + 1, p_out);
+                case StepType::Index:
+                    return element(p_node, step.index, next) && eval(next, p_step + 1, p_out);
+                case StepType::Wildcard:
+                    return each_child(p_node, [&](const Node &p_child)
+                                      { return eval(p_child, p_step + 1, p_out); });
+                case StepType::Descendant:
+                    if (eval(p_node, p_step + 1, p_out))
+                        return true;
+                    return each_child(p_node, [&](const Node &p_child)
+                                      { return eval(p_child, p_step, p_out); });
+                case StepType::Filter:
+                    return each_child(p_node, [&](const Node &p_child)
+                                      { return matches(p_child, m_filters[step.filter]) && eval(p_child, p_step + 1, p_out); });
+                }
+                return false;
+            }
+
+            /// @brief p_node 是否满足过滤条件。
+            template <typename Node>
+            static bool matches(const Node &p_node, const Condition &p_condition)
+            {
+                Node target = p_node;
+                for (const Step &step : p_condition.path)
+                {
+                    Node next{};
+                    if (!(step.type == StepType::Key ? child(target, step.key, next) : element(target, step.index, next)))
+                        return false;
+                    target = next;
+                }
+                if (p_condition.op == Op::Exists)
+                    return true;
+                return compare(scalar(target), p_condition);
+            }
+
+            /// @brief 比较一个值与过滤条件中的字面量。
+            static bool compare(const Scalar &p_value, const Condition &p_condition) noexcept
+            {
+                const Op op = p_condition.op;
+                if (p_value.kind != p_condition.kind)
+                    return op == Op::Ne;
+                int cmp = 0;
+                switch (p_value.kind)
+                {
+                case Kind::Number:
+                    cmp = p_value.number < p_condition.number ? -1 : p_value.number > p_condition.number ? 1
+                                                                                                         : 0;
+                    break;
+                case Kind::String:
+                    cmp = p_value.str.compare(p_condition.str);
+                    break;
+                case Kind::Bool:
+                    cmp = p_value.boolean == p_condition.boolean ? 0 : 1;
+                    [[fallthrough]];
+                default:
+                    // null 与布尔值只能判断相等
+                    if (op != Op::Eq && op != Op::Ne)
+                        return false;
+                    break;
+                }
+                switch (op)
+                {
+                case Op::Eq:
+                    return cmp == 0;
+                case Op::Ne:
+                    return cmp != 0;
+                case Op::Lt:
+                    return cmp < 0;
+                case Op::Le:
+                    return cmp <= 0;
+                case Op::Gt:
+                    return cmp > 0;
+                case Op::Ge:
+                    return cmp >= 0;
+                default:
+                    return false;
+                }
+            }
+
+        private:
+            // DOM 上的访问：先按虚函数判断类型，再直接转换，不经过 dynamic_cast 与 Ref
+
+            static bool is_object(Element *p_node) noexcept { return p_node->is_object(); }
+
+            static bool child(Element *p_node, string_v_t p_key, Element *&p_out)
+            {
+                if (!p_node->is_object())
+                    return false;
+                p_out = (*static_cast<Object *>(p_node))[p_key];
+                return p_out != nullptr;
+            }
+
+            static bool element(Element *p_node, int64_t p_index, Element *&p_out)
+            {
+                if (!p_node->is_array())
+                    return false;
+                Array *arr = static_cast<Array *>(p_node);
+                if (p_index < 0)
+                    p_index += static_cast<int64_t>(arr->size());
+                if (p_index < 0)
+                    return false;
+                p_out = (*arr)[static_cast<size_t>(p_index)];
+                return p_out != nullptr;
+            }
+
+            template <typename Func>
+            static bool each_child(Element *p_node, Func &&p_func)
+            {
+                if (p_node->is_object())
+                {
+                    for (const auto &member : *static_cast<Object *>(p_node))
+                        if (member.second != nullptr && p_func(member.second))
+                            return true;
+                }
+                else if (p_node->is_array())
+                {
+                    Array *arr = static_cast<Array *>(p_node);
+                    for (size_t i = 0; i < arr->size(); ++i)
+                        if (Element *item = (*arr)[i]; item != nullptr && p_func(item))
+                            return true;
+                }
+                return false;
+            }
+
+            static Scalar scalar(Element *p_node)
+            {
+                Scalar out;
+                if (!p_node->is_value())
+                    return out;
+                const Value *value = static_cast<const Value *>(p_node);
+                if (value->is_null())
+                    out.kind = Kind::Null;
+                else if (value->is_bool())
+                {
+                    out.kind = Kind::Bool;
+                    out.boolean = value->as_bool();
+                }
+                else if (value->is_str())
+                {
+                    out.kind = Kind::String;
+                    out.str = value->as_str_view();
+                }
+                else if (value->is_int() || value->is_float())
+                {
+                    out.kind = Kind::Number;
+                    out.number = value->as_number();
+                }
+                return out;
+            }
+
+        private:
+            // 游标（TapeRef / LazyRef）上的访问：只使用两者共同的接口，查找按原文顺序线性进行
+
+            template <typename Cursor>
+            static bool is_object(const Cursor &p_node) { return p_node.is_object(); }
+
+            template <typename Cursor>
+            static bool child(const Cursor &p_node, string_v_t p_key, Cursor &p_out)
+            {
+                if (!p_node.is_object())
+                    return false;
+                for (auto it = p_node.begin(), last = p_node.end(); it != last; ++it)
+                    if (it.key_equals(p_key))
+                    {
+                        p_out = *it;
+                        return true;
+                    }
+                return false;
+            }
+
+            template <typename Cursor>
+            static bool element(const Cursor &p_node, int64_t p_index, Cursor &p_out)
+            {
+                if (!p_node.is_array())
+                    return false;
+                if (p_index < 0)
+                    p_index += static_cast<int64_t>(p_node.size());
+                if (p_index < 0)
+                    return false;
+                for (auto it = p_node.begin(), last = p_node.end(); it != last; ++it, --p_index)
+                    if (p_index == 0)
+                    {
+                        p_out = *it;
+                        return true;
+                    }
+                return false;
+            }
+
+            template <typename Cursor, typename Func>
+            static bool each_child(const Cursor &p_node, Func &&p_func)
+            {
+                const TapeType type = p_node.type();
+                if (type != TapeType::ObjectBegin && type != TapeType::ArrayBegin)
+                    return false;
+                for (auto it = p_node.begin(), last = p_node.end(); it != last; ++it)
+                    if (p_func(*it))
+                        return true;
+                return false;
+            }
+
+            template <typename Cursor>
+            static Scalar scalar(const Cursor &p_node)
+            {
+                Scalar out;
+                switch (p_node.type())
+                {
+                case TapeType::Null:
+                    out.kind = Kind::Null;
+                    break;
+                case TapeType::True:
+                case TapeType::False:
+                    out.kind = Kind::Bool;
+                    out.boolean = p_node.as_bool();
+                    break;
+                case TapeType::Int:
+                    out.kind = Kind::Number;
+                    out.number = static_cast<double>(p_node.as_int());
+                    break;
+                case TapeType::UInt:
+                    out.kind = Kind::Number;
+                    out.number = static_cast<double>(p_node.as_uint64());
+                    break;
+                case TapeType::Float:
+                    out.kind = Kind::Number;
+                    out.number = p_node.as_float();
+                    break;
+                case TapeType::String:
+                    out.kind = Kind::String;
+                    out.str = p_node.as_str();
+                    break;
+                default:
+                    break;
+                }
+                return out;
+            }
+
+        private:
+            /// @brief JSONPath 表达式的递归下降编译器。
+            struct Compiler
+            {
+                Path &path;
+                string_v_t text;
+                size_t pos;
+
+                /// @brief 编译整个表达式。
+                void run()
+                {
+                    expect('$');
+                    while (pos < text.size())
+                    {
+                        const char ch = text[pos];
+                        if (ch == '.')
+                        {
+                            ++pos;
+                            if (at() == '.')
+                            {
+                                ++pos;
+                                add(StepType::Descendant);
+                                if (at() == '[')
+                                {
+                                    bracket(path.m_steps);
+                                    continue;
+                                }
+                            }
+                            dot_member();
+                        }
+                        else if (ch == '[')
+                            bracket(path.m_steps);
+                        else
+                            throw unexpected();
+                    }
+                }
+
+                /// @brief `.` 之后的成员名或 `*`。
+                void dot_member()
+                {
+                    if (at() == '*')
+                    {
+                        ++pos;
+                        add(StepType::Wildcard);
+                        return;
+                    }
+                    Step step{StepType::Key};
+                    step.key = string_t(name());
+                    path.m_steps.push_back(std::move(step));
+                }
+
+                /// @brief 方括号中的选择器：`'name'`、`0`、`*` 或 `?(...)`。
+                void bracket(std::vector<Step> &p_steps)
+                {
+                    ++pos; // '['
+                    skip_whitespace();
+                    const char ch = at();
+                    if (ch == '*')
+                    {
+                        ++pos;
+                        p_steps.push_back(Step{StepType::Wildcard});
+                    }
+                    else if (ch == '\'' || ch == '"')
+                    {
+                        Step step{StepType::Key};
+                        step.key = quoted();
+                        p_steps.push_back(std::move(step));
+                    }
+                    else if (ch == '-' || (ch >= '0' && ch <= '9'))
+                    {
+                        Step step{StepType::Index};
+                        step.index = integer();
+                        p_steps.push_back(std::move(step));
+                    }
+                    else if (ch == '?' && &p_steps == &path.m_steps)
+                    {
+                        ++pos;
+                        Step step{StepType::Filter};
+                        step.filter = path.m_filters.size();
+                        path.m_filters.push_back(filter());
+                        p_steps.push_back(std::move(step));
+                    }
+                    else
+                        throw path.error(pos, "Invalid selector in brackets");
+                    skip_whitespace();
+                    expect(']');
+                }
+
+                /// @brief 过滤器 `(@... op literal)`，'?' 已经消费。
+                Condition filter()
+                {
+                    Condition condition;
+                    expect('(');
+                    skip_whitespace();
+                    expect('@');
+                    while (true)
+                    {
+                        if (at() == '.')
+                        {
+                            ++pos;
+                            Step step{StepType::Key};
+                            step.key = string_t(name());
+                            condition.path.push_back(std::move(step));
+                        }
+                        else if (at() == '[')
+                        {
+                            const size_t start = pos;
+                            bracket(condition.path);
+                            if (condition.path.back().type == StepType::Wildcard)
+                                throw path.error(start, "Wildcards are not allowed in filters");
+                        }
+                        else
+                            break;
+                    }
+                    skip_whitespace();
+                    if (at() != ')')
+                    {
+                        condition.op = compare_op();
+                        skip_whitespace();
+                        literal(condition);
+                        skip_whitespace();
+                    }
+                    expect(')');
+                    return condition;
+                }
+
+                /// @brief 比较运算符。
+                Op compare_op()
+                {
+                    const char ch = at();
+                    const bool eq = pos + 1 < text.size() && text[pos + 1] == '=';
+                    Op op;
+                    if (ch == '=' && eq)
+                        op = Op::Eq;
+                    else if (ch == '!' && eq)
+                        op = Op::Ne;
+                    else if (ch == '<')
+                        op = eq ? Op::Le : Op::Lt;
+                    else if (ch == '>')
+                        op = eq ? Op::Ge : Op::Gt;
+                    else
+                        throw path.error(pos, "Expected comparison operator");
+                    pos += eq ? 2 : 1;
+                    return op;
+                }
+
+                /// @brief 比较的右侧：字符串、数字、true、false 或 null。
+                void literal(Condition &p_condition)
+                {
+                    const char ch = at();
+                    if (ch == '\'' || ch == '"')
+                    {
+                        p_condition.kind = Kind::String;
+                        p_condition.str = quoted();
+                        return;
+                    }
+                    if (keyword("true") || keyword("false"))
+                    {
+                        p_condition.kind = Kind::Bool;
+                        p_condition.boolean = ch == 't';
+                        return;
+                    }
+                    if (keyword("null"))
+                    {
+                        p_condition.kind = Kind::Null;
+                        return;
+                    }
+                    const size_t start = pos;
+                    while (pos < text.size() && (std::isdigit(static_cast<unsigned char>(text[pos])) ||
+                                                 text[pos] == '-' || text[pos] == '+' || text[pos] == '.' || text[pos] == 'e' || text[pos] == 'E'))
+                        ++pos;
+                    if (start == pos || !number::parse_floating(text.data() + start, text.data() + pos, p_condition.number))
+                        throw path.error(start, "Invalid literal in filter");
+                    p_condition.kind = Kind::Number;
+                }
+
+                /// @brief 成员名：直到下一个分隔字符为止，不能为空。
+                string_v_t name()
+                {
+                    const size_t start = pos;
+                    while (pos < text.size())
+                    {
+                        const char ch = text[pos];
+                        if (ch == '.' || ch == '[' || ch == ']' || ch == '(' || ch == ')' || ch == '\'' || ch == '"' ||
+                            ch == '=' || ch == '!' || ch == '<' || ch == '>' || ch == '@' || ch == '*' || ch == ',' ||
+                            ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r')
+                            break;
+                        ++pos;
+                    }
+                    if (start == pos)
+                        throw path.error(pos, "Expected member name");
+                    return text.substr(start, pos - start);
+                }
+
+                /// @brief 以单引号或双引号括起的字符串，'\\' 转义其后的一个字符。
+                string_t quoted()
+                {
+                    const char quote = text[pos];
+                    const size_t start = pos++;
+                    string_t out;
+                    while (pos < text.size() && text[pos] != quote)
+                    {
+                        if (text[pos] == '\\' && pos + 1 < text.size())
+                            ++pos;
+                        out.push_back(text[pos++]);
+                    }
+                    if (pos >= text.size())
+                        throw path.error(start, "Unterminated string in path");
+                    ++pos;
+                    return out;
+                }
+
+                /// @brief 十进制整数下标，可以为负。
+                int64_t integer()
+                {
+                    const size_t start = pos;
+                    if (at() == '-')
+                        ++pos;
+                    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9')
+                        ++pos;
+                    int64_t value = 0;
+                    auto [ptr, ec] = std::from_chars(text.data() + start, text.data() + pos, value);
+                    if (ec != std::errc() || ptr != text.data() + pos)
+                        throw path.error(start, "Invalid array index");
+                    return value;
+                }
+
+                /// @brief 若当前位置是完整的关键字 p_word 则消费它。
+                bool keyword(string_v_t p_word)
+                {
+                    if (text.compare(pos, p_word.size(), p_word) != 0)
+                        return false;
+                    pos += p_word.size();
+                    return true;
+                }
+
+                char at() const noexcept { return pos < text.size() ? text[pos] : '\0'; }
+                void add(StepType p_type) { path.m_steps.push_back(Step{p_type}); }
+                void skip_whitespace() noexcept
+                {
+                    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r'))
+                        ++pos;
+                }
+                void expect(char p_ch)
+                {
+                    if (at() != p_ch)
+                        throw path.error(pos, (std::string) "Expected '" + std::string(1, p_ch) + "' in path");
+                    ++pos;
+                }
+                ParseException unexpected() const
+                {
+                    return path.error(pos, (std::string) "Unexpected character '" + std::string(1, text[pos]) + "' in path");
+                }
+            };
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_PATH
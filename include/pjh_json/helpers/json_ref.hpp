@@ -172,6 +172,20 @@ namespace pjh_std
                     return m_ptr->as_value()->as_int();
                 throw TypeException("Not an int value");
             }
+            /// @brief 以 64 位有符号整数形式获取元素内容。
+            int64_t as_int64() const
+            {
+                if (is_int())
+                    return m_ptr->as_value()->as_int64();
+                throw TypeException("Not an int value");
+            }
+            /// @brief 以 64 位无符号整数形式获取元素内容。
+            uint64_t as_uint64() const
+            {
+                if (is_int())
+                    return m_ptr->as_value()->as_uint64();
+                throw TypeException("Not an int value");
+            }
             /// @brief 以浮点数形式获取元素内容。
             float as_float() const
             {
@@ -179,6 +193,13 @@ namespace pjh_std
                     return m_ptr->as_value()->as_float();
                 throw TypeException("Not an float value");
             }
+            /// @brief 以双精度浮点数形式获取元素内容。
+            double as_double() const
+            {
+                if (is_float())
+                    return m_ptr->as_value()->as_double();
+                throw TypeException("Not an float value");
+            }
             /// @brief 以字符串形式获取元素内容。
             string_t as_str() const
             {
@@ -194,7 +215,9 @@ namespace pjh_std
             /// @brief 重载 << 运算符，以便将 Ref 对象直接输出到流（美化格式）。
             friend std::ostream &operator<<(std::ostream &os, Ref &ref)
             {
-                os << ref.get()->pretty_serialize(0, ' ');
+                StreamSink sink(os);
+                Writer writer(sink);
+                ref.get()->pretty_serialize_to(writer, 0, ' ');
                 return os;
             }
         };
@@ -208,7 +231,7 @@ namespace pjh_std
         {
             auto obj = new Object();
             for (auto &kv : p_list)
-                obj->insert_raw_ptr(kv.first, kv.second.get());
+                obj->insert_raw_ptr_copy_key(kv.first, kv.second.get());
             return Ref(obj);
         }
 
@@ -232,7 +255,10 @@ namespace pjh_std
         inline Ref make_value(std::nullptr_t) { return Ref(new Value(nullptr)); }
         inline Ref make_value(bool p_val) { return Ref(new Value(p_val)); }
         inline Ref make_value(int p_val) { return Ref(new Value(p_val)); }
+        inline Ref make_value(int64_t p_val) { return Ref(new Value(p_val)); }
+        inline Ref make_value(uint64_t p_val) { return Ref(new Value(p_val)); }
         inline Ref make_value(float p_val) { return Ref(new Value(p_val)); }
+        inline Ref make_value(double p_val) { return Ref(new Value(p_val)); }
         inline Ref make_value(const char *p_val) { return Ref(new Value((string_t)p_val)); }
         inline Ref make_value(const string_t p_val) { return Ref(new Value(p_val)); }
     }
@@ -0,0 +1,205 @@
+#ifndef INCLUDE_JSON_ARRAY_SPLITTER
+#define INCLUDE_JSON_ARRAY_SPLITTER
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#include <pjh_json/helpers/json_definition.hpp>
+
+#include <pjh_json/parsers/json_structural_index.hpp>
+
+#include <pjh_json/utils/simd.hpp>
+#include <pjh_json/utils/thread_pool.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class ArraySplitter
+         * @brief 在顶层数组中寻找元素之间的逗号，作为并行解析的切分点。
+         *        与 StructuralIndex 相同，按 64 字节块分类字符并识别转义与字符串内部，
+         *        因此字符串中的逗号、括号和被转义的引号都不会被误认为切分点。
+         *
+         * 分三步进行，其中第一步与第三步可以并行：
+         * 1. 输入被均分为若干段，每段独立扫描：引号的奇偶性与“段首是否位于字符串内部”无关，
+         *    而括号深度的变化只有两种可能（段首在字符串外 / 内），两种都记录下来；
+         * 2. 按顺序累加每段的奇偶性与深度变化，得到每段段首真实的字符串状态与括号深度；
+         * 3. 每段从段首出发，找到第一个位于深度 1 的逗号。
+         */
+        class ArraySplitter
+        {
+        public:
+            /// @brief 表示“没有找到”的偏移量。
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            /**
+             * @brief 把顶层数组 p_input 切分为至多 p_parts 段。
+             * @param p_input 完整的输入文本（以 '[' 开头的顶层数组）。
+             * @param p_parts 期望的段数。
+             * @param p_pool 执行第一步与第三步的线程池，为空时在当前线程中执行。
+             * @param p_commas 输出：作为切分点的逗号偏移，严格递增。
+             * @param p_level 向量化扫描使用的指令集级别。
+             * @return 字符串与括号均正确闭合时返回 true；否则返回 false，此时 p_commas 为空。
+             */
+            static bool split(string_v_t p_input, size_t p_parts, ThreadPool *p_pool, std::vector<size_t> &p_commas,
+                              simd::Level p_level = simd::detect_level())
+            {
+                p_commas.clear();
+                if (p_level > simd::detect_level())
+                    p_level = simd::detect_level();
+                const char *data = p_input.data();
+                const size_t size = p_input.size();
+
+                // 段的长度取 64 的倍数，使每段都从块边界开始
+                size_t chunk = (size / (std::max)(p_parts, size_t(1)) + 63) & ~size_t(63);
+                chunk = (std::max)(chunk, size_t(64));
+                const size_t count = (size + chunk - 1) / chunk;
+
+                // 1. 每段的引号奇偶性，以及段首在字符串外（[0]）/ 内（[1]）时的括号深度变化
+                struct Summary
+                {
+                    bool flips_string = false;
+                    int64_t delta[2] = {0, 0};
+                };
+                std::vector<Summary> summaries(count);
+                run(p_pool, count, [&](size_t idx)
+                    {
+                        Summary &summary = summaries[idx];
+                        const size_t begin = idx * chunk;
+                        const uint64_t in_string = walk(p_level, data, size, begin, (std::min)(begin + chunk, size), 0,
+                                                        [&](const char *p_block, const simd::BlockMasks &p_masks, uint64_t p_in_string, size_t)
+                                                        {
+                                                            for (uint64_t bits = p_masks.op; bits != 0; bits &= bits - 1)
+                                                            {
+                                                                const int bit = simd::trailing_zeros(bits);
+                                                                const int step = bracket_step(p_block[bit]);
+                                                                summary.delta[(p_in_string >> bit) & 1] += step;
+                                                            }
+                                                            return true;
+                                                        });
+                        summary.flips_string = in_string != 0; });
+
+                // 2. 顺序累加，得到每段段首的真实状态
+                std::vector<uint64_t> start_in_string(count);
+                std::vector<int64_t> start_depth(count);
+                uint64_t in_string = 0;
+                int64_t depth = 0;
+                for (size_t idx = 0; idx < count; ++idx)
+                {
+                    start_in_string[idx] = in_string;
+                    start_depth[idx] = depth;
+                    depth += summaries[idx].delta[in_string & 1];
+                    if (summaries[idx].flips_string)
+                        in_string = ~in_string;
+                }
+                if (in_string != 0 || depth != 0)
+                    return false;
+
+                // 3. 每段（第一段除外）从段首找到第一个深度为 1 的逗号，可以越过段尾
+                std::vector<size_t> found(count, npos);
+                run(p_pool, count - 1, [&](size_t idx)
+                    {
+                        const size_t part = idx + 1;
+                        int64_t level = start_depth[part];
+                        if (level < 1)
+                            return;
+                        walk(p_level, data, size, part * chunk, size, start_in_string[part],
+                             [&](const char *p_block, const simd::BlockMasks &p_masks, uint64_t p_in_string, size_t p_offset)
+                             {
+                                 for (uint64_t bits = p_masks.op & ~p_in_string; bits != 0; bits &= bits - 1)
+                                 {
+                                     const int bit = simd::trailing_zeros(bits);
+                                     level += bracket_step(p_block[bit]);
+                                     if (level < 1)
+                                         return false; // 已经到达顶层数组的末尾
+                                     if (level == 1 && p_block[bit] == ',')
+                                     {
+                                         found[part] = p_offset + bit;
+                                         return false;
+                                     }
+                                 }
+                                 return true;
+                             }); });
+
+                // 相邻的段可能找到同一个逗号（元素比段更长），只保留严格递增的部分
+                for (size_t pos : found)
+                    if (pos != npos && (p_commas.empty() || pos > p_commas.back()))
+                        p_commas.push_back(pos);
+                return true;
+            }
+
+        private:
+            /// @brief 括号对深度的影响：'[' '{' 为 +1，']' '}' 为 -1，其余为 0。
+            static int bracket_step(char p_ch) noexcept
+            {
+                switch (p_ch)
+                {
+                case '[':
+                case '{':
+                    return 1;
+                case ']':
+                case '}':
+                    return -1;
+                default:
+                    return 0;
+                }
+            }
+
+            /// @brief 在线程池中（或没有线程池时在当前线程中）对 [0, p_count) 执行 p_func。
+            template <typename Func>
+            static void run(ThreadPool *p_pool, size_t p_count, Func &&p_func)
+            {
+                if (p_pool == nullptr || p_count <= 1)
+                {
+                    for (size_t idx = 0; idx < p_count; ++idx)
+                        p_func(idx);
+                    return;
+                }
+                p_pool->parallel_for(p_count, p_func);
+            }
+
+            /**
+             * @brief 从 p_begin（64 的倍数）开始逐块扫描到 p_end，对每块调用
+             *        p_func(块数据, 分类结果, 字符串内部掩码, 块的偏移)，p_func 返回 false 时提前结束。
+             * @param p_in_string 段首是否位于字符串内部（全 0 或全 1）。
+             * @return 扫描结束时是否位于字符串内部（全 0 或全 1）。
+             */
+            template <typename Func>
+            static uint64_t walk(simd::Level p_level, const char *p_data, size_t p_size, size_t p_begin, size_t p_end,
+                                 uint64_t p_in_string, Func &&p_func)
+            {
+                // 段首之前连续反斜杠的个数为奇数时，段首字符被转义（转义与是否位于字符串内部无关）
+                size_t backslashes = 0;
+                while (backslashes < p_begin && p_data[p_begin - backslashes - 1] == '\\')
+                    ++backslashes;
+                uint64_t prev_escaped = backslashes & 1;
+
+                simd::BlockMasks masks;
+                for (size_t offset = p_begin; offset < p_end; offset += 64)
+                {
+                    // 最后一块不足 64 字节时，拷贝到以空格填充的缓冲区中
+                    char tail[64];
+                    const char *block = p_data + offset;
+                    if (p_size - offset < 64)
+                    {
+                        std::memset(tail, ' ', sizeof(tail));
+                        std::memcpy(tail, block, p_size - offset);
+                        block = tail;
+                    }
+                    simd::classify_block(p_level, block, masks);
+                    const uint64_t escaped = StructuralIndex::find_escaped(masks.backslash, prev_escaped);
+                    const uint64_t in_string = simd::prefix_xor(masks.quote & ~escaped) ^ p_in_string;
+                    p_in_string = uint64_t(static_cast<int64_t>(in_string) >> 63);
+                    if (!p_func(block, masks, in_string, offset))
+                        break;
+                }
+                return p_in_string;
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_ARRAY_SPLITTER
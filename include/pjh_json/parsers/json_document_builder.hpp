@@ -0,0 +1,145 @@
+#ifndef INCLUDE_JSON_DOCUMENT_BUILDER
+#define INCLUDE_JSON_DOCUMENT_BUILDER
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <pjh_json/datas/json_array.hpp>
+#include <pjh_json/datas/json_document.hpp>
+#include <pjh_json/datas/json_object.hpp>
+#include <pjh_json/datas/json_value.hpp>
+
+#include <pjh_json/helpers/json_definition.hpp>
+
+#include <pjh_json/parsers/json_sax.hpp>
+
+#include <pjh_json/utils/arena.hpp>
+#include <pjh_json/utils/number.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class DocumentBuilder
+         * @brief 把 SAX 事件构建为 Document 的处理器，可交给 Parser::parse_sax 或 PushParser。
+         *
+         * 节点与字符串都分配在构建器自己的 Arena 上：事件中的字符串视图只在回调期间有效，
+         * 因此键与字符串值会拷贝一份，结果不依赖输入缓冲区。
+         * 容器在开始时就挂到父容器上，所以只需要一个待用的键和一个打开容器的栈，而不需要递归。
+         */
+        class DocumentBuilder : public SaxHandler
+        {
+        private:
+            /// @brief 一个尚未结束的容器，两个指针中恰有一个非空。
+            struct Open
+            {
+                Object *obj;
+                Array *arr;
+            };
+
+            std::unique_ptr<Arena> m_arena; // 节点与字符串所在的 Arena
+            std::vector<Open> m_stack;      // 尚未结束的容器
+            string_v_t m_key;               // 下一个值在所属对象中的键
+            Element *m_root;                // 根元素
+            size_t m_block_size;            // 每个文档的 Arena 第一个块的大小
+
+        public:
+            /// @brief 构造函数。@param p_block_size Arena 第一个块的大小，可按预期的文档大小给出。
+            explicit DocumentBuilder(size_t p_block_size = Arena::default_block_size)
+                : m_arena(std::make_unique<Arena>(p_block_size)), m_root(nullptr), m_block_size(p_block_size) {}
+
+        public:
+            void on_null() { add(make<Value>()); }
+            void on_bool(bool p_value) { add(make<Value>(p_value)); }
+            void on_int(int64_t p_value)
+            {
+                // 与 Parser 相同：能用 int 表示的整数存为 int
+                if (p_value >= (std::numeric_limits<int>::min)() && p_value <= (std::numeric_limits<int>::max)())
+                    add(make<Value>(static_cast<int>(p_value)));
+                else
+                    add(make<Value>(p_value));
+            }
+            void on_uint(uint64_t p_value) { add(make<Value>(p_value)); }
+            void on_double(double p_value)
+            {
+                // 与 Parser 相同：float 能无损表示时存为 float
+                if (number::fits_float(p_value))
+                    add(make<Value>(static_cast<float>(p_value)));
+                else
+                    add(make<Value>(p_value));
+            }
+            void on_string(string_v_t p_value) { add(make<Value>(copy(p_value))); }
+            void on_key(string_v_t p_key) { m_key = copy(p_key); }
+            void on_start_object()
+            {
+                Object *obj = make<Object>(m_arena.get());
+                add(obj);
+                m_stack.push_back({obj, nullptr});
+            }
+            void on_end_object(size_t) { m_stack.pop_back(); }
+            void on_start_array()
+            {
+                Array *arr = make<Array>(m_arena.get());
+                add(arr);
+                m_stack.push_back({nullptr, arr});
+            }
+            void on_end_array(size_t) { m_stack.pop_back(); }
+
+        public:
+            /// @brief 是否已经得到一个完整的根元素。
+            bool complete() const noexcept { return m_root != nullptr && m_stack.empty(); }
+
+            /**
+             * @brief 取出构建好的文档，构建器随后回到初始状态，可以继续构建下一个文档。
+             *        根元素尚未结束时返回空文档，构建器的状态不变。
+             */
+            Document document()
+            {
+                if (!complete())
+                    return Document();
+                Document doc(m_root, nullptr, std::move(m_arena));
+                reset();
+                return doc;
+            }
+
+            /// @brief 丢弃尚未完成的文档（例如解析出错之后）并回到初始状态；与 PushParser 一起使用时随 PushParser::reset() 调用。
+            void reset()
+            {
+                m_arena = std::make_unique<Arena>(m_block_size);
+                m_stack.clear();
+                m_root = nullptr;
+                m_key = string_v_t();
+            }
+
+        private:
+            /// @brief 在 Arena 上构造一个节点。
+            template <typename T, typename... Args>
+            T *make(Args &&...args) { return Element::create_in<T>(*m_arena, std::forward<Args>(args)...); }
+
+            /// @brief 把字符串拷贝到 Arena 上。
+            string_v_t copy(string_v_t p_str)
+            {
+                char *out = static_cast<char *>(m_arena->allocate(p_str.size(), 1));
+                std::memcpy(out, p_str.data(), p_str.size());
+                return string_v_t(out, p_str.size());
+            }
+
+            /// @brief 把新元素挂到当前容器上（没有容器时作为根元素）。
+            void add(Element *p_element)
+            {
+                if (m_stack.empty())
+                    m_root = p_element;
+                else if (m_stack.back().obj != nullptr)
+                    m_stack.back().obj->insert_raw_ptr(m_key, p_element);
+                else
+                    m_stack.back().arr->append_raw_ptr(p_element);
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_DOCUMENT_BUILDER
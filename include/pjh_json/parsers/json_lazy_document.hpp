@@ -0,0 +1,660 @@
+#ifndef INCLUDE_JSON_LAZY_DOCUMENT
+#define INCLUDE_JSON_LAZY_DOCUMENT
+
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <pjh_json/datas/json_document.hpp>
+#include <pjh_json/datas/json_tape.hpp>
+
+#include <pjh_json/helpers/json_definition.hpp>
+#include <pjh_json/helpers/json_exception.hpp>
+
+#include <pjh_json/parsers/json_options.hpp>
+#include <pjh_json/parsers/json_parser.hpp>
+#include <pjh_json/parsers/json_structural_index.hpp>
+
+#include <pjh_json/utils/arena.hpp>
+#include <pjh_json/utils/escape.hpp>
+#include <pjh_json/utils/mapped_file.hpp>
+#include <pjh_json/utils/number.hpp>
+#include <pjh_json/utils/simd.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        class LazyRef;
+
+        /**
+         * @class LazyDocument
+         * @brief 按需解析的文档：构造时不做任何解析，只有通过 LazyRef 访问到的值才会被扫描和转换。
+         *
+         * 查找对象成员或数组元素时，从容器开头在原文上向前扫描，未命中的子树按括号匹配整体跳过
+         * （StructuralIndex::find_container_end），既不分配节点，也不校验其中的内容。
+         * 因此只读取少数字段时远快于完整解析；语法错误只有在扫描经过它时才会抛出。
+         * 需要整棵子树时可调用 LazyRef::materialize() 得到一个普通的 Document。
+         *
+         * 含转义的字符串解码到文档内部的 Arena 上（每个字符串只解码一次），比较键时则解码到复用的缓冲区中，
+         * 所以同一个 LazyDocument 不能在多个线程中同时访问。
+         * 借用模式下调用方的缓冲区必须比文档以及由它得到的所有视图活得更久。
+         */
+        class LazyDocument
+        {
+            friend class LazyRef;
+
+        private:
+            std::shared_ptr<const void> m_source;    // 保持输入缓冲区存活（拥有模式下的字符串、文件映射等）
+            string_v_t m_input;                      // 原始输入
+            simd::Level m_level;                     // 向量化扫描使用的指令集级别
+            mutable std::unique_ptr<Arena> m_decoded; // 含转义的字符串解码后的副本（按需创建）
+            mutable std::unordered_map<size_t, string_v_t> m_decoded_at; // 已解码的字符串，按开引号在原文中的偏移索引
+            mutable string_t m_scratch;               // 比较键时复用的解码缓冲区
+
+        public:
+            /// @brief 构造函数（借用模式）。@param p_input 调用方持有的 JSON 文本。@param p_options 解析选项（只使用 simd_level）。
+            explicit LazyDocument(string_v_t p_input, const ParseOptions &p_options = ParseOptions())
+                : m_source(), m_input(p_input), m_level((std::min)(p_options.simd_level, simd::detect_level())) {}
+            /// @brief 构造函数。@param p_input JSON 文本（接管所有权）。
+            explicit LazyDocument(string_t &&p_input, const ParseOptions &p_options = ParseOptions())
+                : m_level((std::min)(p_options.simd_level, simd::detect_level()))
+            {
+                auto owned = std::make_shared<const string_t>(std::move(p_input));
+                m_input = *owned;
+                m_source = std::move(owned);
+            }
+            /// @brief 构造函数。@param p_input JSON 文本（会被拷贝一份）。
+            explicit LazyDocument(const char *p_input, const ParseOptions &p_options = ParseOptions())
+                : LazyDocument(string_t(p_input), p_options) {}
+            /// @brief 构造函数。@param p_input JSON 文本。@param p_source 使 p_input 保持有效的所有者。
+            LazyDocument(string_v_t p_input, std::shared_ptr<const void> p_source, const ParseOptions &p_options = ParseOptions())
+                : m_source(std::move(p_source)), m_input(p_input), m_level((std::min)(p_options.simd_level, simd::detect_level())) {}
+
+            LazyDocument(const LazyDocument &) = delete;
+            LazyDocument &operator=(const LazyDocument &) = delete;
+            LazyDocument(LazyDocument &&) noexcept = default;
+            LazyDocument &operator=(LazyDocument &&) noexcept = default;
+
+            /// @brief 以只读内存映射的方式打开一个文件，映射随文档一同释放。
+            static LazyDocument from_file(const std::filesystem::path &p_path, const ParseOptions &p_options = ParseOptions())
+            {
+                auto file = std::make_shared<MappedFile>(p_path);
+                const string_v_t view = file->view();
+                return LazyDocument(view, std::move(file), p_options);
+            }
+
+        public:
+            /// @brief 获取原始输入。
+            string_v_t source() const noexcept { return m_input; }
+            /// @brief 获取根值的游标。
+            LazyRef root() const;
+            /// @brief 访问根 Object 的成员。
+            LazyRef operator[](string_v_t p_key) const;
+            /// @brief 访问根 Array 的成员。
+            LazyRef operator[](size_t p_index) const;
+
+        private:
+            /// @brief 构造一个位于输入中 p_pos 处的解析异常。
+            ParseException error(size_t p_pos, const std::string &msg) const { return ParseException(m_input, p_pos, msg); }
+
+            /// @brief p_pos 处的字符，越界时为 '\0'。
+            char at(size_t p_pos) const noexcept { return p_pos < m_input.size() ? m_input[p_pos] : '\0'; }
+
+            /// @brief 跳过 p_pos 起的空白字符。
+            size_t skip_whitespace(size_t p_pos) const noexcept
+            {
+                const char *begin = m_input.data();
+                if (p_pos >= m_input.size())
+                    return m_input.size();
+                return simd::skip_whitespace(m_level, begin + p_pos, begin + m_input.size()) - begin;
+            }
+
+            /**
+             * @brief 找到 p_pos 处字符串的结束位置。
+             * @param p_pos 开引号的位置。
+             * @param p_escaped 输出：字符串是否含有转义序列。
+             * @return 闭引号之后的位置。
+             */
+            size_t string_end(size_t p_pos, bool &p_escaped) const
+            {
+                const char *begin = m_input.data();
+                const char *end = begin + m_input.size();
+                const char *p = begin + p_pos + 1;
+                p_escaped = false;
+                while (true)
+                {
+                    p = simd::find_quote_or_backslash(m_level, p, end);
+                    if (p >= end)
+                        throw error(m_input.size(), "Unterminated string literal");
+                    if (*p == '"')
+                        return p + 1 - begin;
+                    p_escaped = true;
+                    if (p + 1 >= end)
+                        throw error(m_input.size(), "Unterminated string literal");
+                    p += 2;
+                }
+            }
+
+            /// @brief 获取 [p_pos, p_end) 处字符串的内容，含转义时解码。@param p_scratch 非空时解码到其中，否则解码到文档的 Arena 上。
+            string_v_t string_at(size_t p_pos, size_t p_end, bool p_escaped, string_t *p_scratch) const
+            {
+                const char *in = m_input.data() + p_pos + 1;
+                const char *in_end = m_input.data() + p_end - 1;
+                if (!p_escaped)
+                    return string_v_t(in, in_end - in);
+                char *out;
+                if (p_scratch != nullptr)
+                {
+                    p_scratch->resize(in_end - in);
+                    out = p_scratch->data();
+                }
+                else
+                {
+                    if (!m_decoded)
+                        m_decoded = std::make_unique<Arena>();
+                    out = static_cast<char *>(m_decoded->allocate(in_end - in, 1));
+                }
+                char *const out_begin = out;
+                if (!escape::unescape(in, in_end, out, m_level))
+                    throw error(in - m_input.data(), "Invalid escape sequence");
+                return string_v_t(out_begin, out - out_begin);
+            }
+
+            /// @brief 获取 [p_pos, p_end) 处字符串的内容并交给调用方：含转义时解码到 Arena 上，同一个字符串只解码一次。
+            string_v_t decoded_at(size_t p_pos, size_t p_end, bool p_escaped) const
+            {
+                if (!p_escaped)
+                    return string_at(p_pos, p_end, false, nullptr);
+                const auto found = m_decoded_at.find(p_pos);
+                if (found != m_decoded_at.end())
+                    return found->second;
+                const string_v_t text = string_at(p_pos, p_end, true, nullptr);
+                m_decoded_at.emplace(p_pos, text);
+                return text;
+            }
+
+            /// @brief 判断 [p_pos, p_end) 处的字符串是否等于 p_key，含转义时解码到复用的缓冲区中，不占用 Arena。
+            bool string_equals(size_t p_pos, size_t p_end, bool p_escaped, string_v_t p_key) const
+            {
+                return string_at(p_pos, p_end, p_escaped, &m_scratch) == p_key;
+            }
+
+            /// @brief 跳过 p_pos 处的整个值（不做校验），返回值之后的位置。
+            size_t value_end(size_t p_pos) const
+            {
+                const char ch = at(p_pos);
+                if (ch == '{' || ch == '[')
+                {
+                    const char *begin = m_input.data();
+                    const char *end = begin + m_input.size();
+                    const char *close = StructuralIndex::find_container_end(m_level, begin + p_pos, end);
+                    if (close == nullptr)
+                        throw error(m_input.size(), ch == '{' ? "Expected ',' or '}' in object" : "Expected ',' or ']' in array");
+                    return close - begin;
+                }
+                if (ch == '"')
+                {
+                    bool escaped;
+                    return string_end(p_pos, escaped);
+                }
+                if (p_pos >= m_input.size())
+                    throw TypeException("Unexpected token type");
+                // 数字与字面量：连续的普通字符
+                size_t pos = p_pos;
+                while (pos < m_input.size() && simd::char_classes.table[static_cast<uint8_t>(m_input[pos])] == simd::ClassOther)
+                    ++pos;
+                if (pos == p_pos)
+                    throw error(p_pos, (std::string) "Unexpected character '" + std::string(1, ch) + "'");
+                return pos;
+            }
+
+            /**
+             * @brief 定位对象成员：p_pos 处应为键（或结束的 '}'）。
+             * @param p_key_end 输出：键之后的位置。
+             * @param p_escaped 输出：键是否含有转义。
+             * @return 成员值的位置；到达 '}' 时返回 npos。
+             */
+            size_t member_at(size_t p_pos, size_t &p_key_end, bool &p_escaped) const
+            {
+                if (at(p_pos) == '}')
+                    return npos;
+                if (at(p_pos) != '"')
+                    throw error(p_pos, "Expected string key in object!");
+                p_key_end = string_end(p_pos, p_escaped);
+                const size_t colon = skip_whitespace(p_key_end);
+                if (at(colon) != ':')
+                    throw error(colon, "Expected colon after key!");
+                return skip_whitespace(colon + 1);
+            }
+
+            /// @brief 从上一个值之后的位置前进到下一个键 / 元素；遇到容器结尾时返回 npos。
+            size_t next_item(size_t p_value_end, char p_close) const
+            {
+                size_t pos = skip_whitespace(p_value_end);
+                if (at(pos) == p_close)
+                    return npos;
+                if (at(pos) != ',')
+                    throw error(pos, p_close == '}' ? "Expected ',' or '}' in object" : "Expected ',' or ']' in array");
+                return skip_whitespace(pos + 1);
+            }
+
+            /// @brief 容器中第一个键 / 元素的位置；空容器返回 npos。
+            size_t first_item(size_t p_open) const
+            {
+                const size_t pos = skip_whitespace(p_open + 1);
+                return at(pos) == (at(p_open) == '{' ? '}' : ']') ? npos : pos;
+            }
+
+        private:
+            static constexpr size_t npos = static_cast<size_t>(-1);
+        };
+
+        /**
+         * @class LazyRef
+         * @brief 指向 LazyDocument 中某个值的只读游标，接口与 TapeRef 一致，例如 `doc["key"][0].as_int()`。
+         *        游标只是 (文档指针, 原文偏移)，可随意拷贝；每次访问都在原文上重新扫描，不缓存结果，
+         *        因此反复访问同一个大容器时应先取出子游标，或改用 materialize()。
+         */
+        class LazyRef
+        {
+        private:
+            const LazyDocument *m_doc; // 所属文档
+            size_t m_pos;              // 值在原文中的起始偏移
+
+        public:
+            /**
+             * @class Iterator
+             * @brief 依次遍历数组元素或对象成员的值；遍历对象时可通过 key() 取得当前成员的键。
+             */
+            class Iterator
+            {
+            private:
+                const LazyDocument *m_doc;
+                size_t m_pos;       // 当前元素（对象中为当前键）的位置，结束时为 npos
+                size_t m_value_pos; // 当前元素值的位置
+                size_t m_key_end;   // 当前键之后的位置
+                bool m_escaped;     // 当前键是否含有转义
+                bool m_is_object;   // 所遍历的容器是否为对象
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = LazyRef;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = LazyRef;
+
+                Iterator(const LazyDocument *p_doc, size_t p_pos, bool p_is_object)
+                    : m_doc(p_doc), m_pos(p_pos), m_value_pos(p_pos), m_key_end(0), m_escaped(false), m_is_object(p_is_object) { locate(); }
+
+                /// @brief 当前元素的值。
+                LazyRef operator*() const { return LazyRef(m_doc, m_value_pos); }
+                /// @brief 当前成员的键（仅遍历对象时有效），含转义时解码到文档的 Arena 上（每个键只解码一次）。
+                string_v_t key() const
+                {
+                    if (!m_is_object)
+                        throw TypeException("Not an object");
+                    return m_doc->decoded_at(m_pos, m_key_end, m_escaped);
+                }
+                /// @brief 判断当前成员的键是否等于 p_key（仅遍历对象时有效），不会在文档的 Arena 上分配。
+                bool key_equals(string_v_t p_key) const
+                {
+                    if (!m_is_object)
+                        throw TypeException("Not an object");
+                    return m_doc->string_equals(m_pos, m_key_end, m_escaped, p_key);
+                }
+
+                Iterator &operator++()
+                {
+                    m_pos = m_doc->next_item(m_doc->value_end(m_value_pos), m_is_object ? '}' : ']');
+                    locate();
+                    return *this;
+                }
+                Iterator operator++(int)
+                {
+                    Iterator old = *this;
+                    ++(*this);
+                    return old;
+                }
+
+                bool operator==(const Iterator &other) const noexcept { return m_pos == other.m_pos; }
+                bool operator!=(const Iterator &other) const noexcept { return m_pos != other.m_pos; }
+
+            private:
+                /// @brief 根据 m_pos 定位当前成员的键与值。
+                void locate()
+                {
+                    if (m_pos == LazyDocument::npos)
+                        return;
+                    if (m_is_object)
+                    {
+                        m_value_pos = m_doc->member_at(m_pos, m_key_end, m_escaped);
+                        if (m_value_pos == LazyDocument::npos)
+                            m_pos = LazyDocument::npos;
+                    }
+                    else
+                        m_value_pos = m_pos;
+                }
+            };
+
+        public:
+            /// @brief 构造函数。@param p_doc 所属文档。@param p_pos 值在原文中的起始偏移。
+            LazyRef(const LazyDocument *p_doc = nullptr, size_t p_pos = 0) : m_doc(p_doc), m_pos(p_pos) {}
+
+            /// @brief 获取值在原文中的起始偏移。
+            size_t offset() const noexcept { return m_pos; }
+            /// @brief 获取值在原文中的完整文本（不做校验）。
+            string_v_t raw() const
+            {
+                check();
+                return m_doc->m_input.substr(m_pos, m_doc->value_end(m_pos) - m_pos);
+            }
+
+            /// @brief 获取值的类型标签，数字按 Parser 的规则分为 Int / UInt / Float。
+            TapeType type() const
+            {
+                check();
+                switch (m_doc->at(m_pos))
+                {
+                case '{':
+                    return TapeType::ObjectBegin;
+                case '[':
+                    return TapeType::ArrayBegin;
+                case '"':
+                    return TapeType::String;
+                case 't':
+                    literal("true", "Invalid boolean literal");
+                    return TapeType::True;
+                case 'f':
+                    literal("false", "Invalid boolean literal");
+                    return TapeType::False;
+                case 'n':
+                    literal("null", "Invalid null literal");
+                    return TapeType::Null;
+                case '\0':
+                    if (m_pos >= m_doc->m_input.size())
+                        throw TypeException("Unexpected token type");
+                    break;
+                default:
+                    break;
+                }
+                return number_type();
+            }
+
+            /// @brief 重载 [] 运算符，按原文顺序查找 Object 的成员，未命中的值整体跳过。
+            LazyRef operator[](string_v_t p_key) const
+            {
+                if (!is_object())
+                    throw TypeException("Not an object");
+                size_t pos = m_doc->first_item(m_pos);
+                while (pos != LazyDocument::npos)
+                {
+                    size_t key_end;
+                    bool escaped;
+                    const size_t value = m_doc->member_at(pos, key_end, escaped);
+                    if (value == LazyDocument::npos)
+                        break;
+                    if (m_doc->string_equals(pos, key_end, escaped, p_key))
+                        return LazyRef(m_doc, value);
+                    pos = m_doc->next_item(m_doc->value_end(value), '}');
+                }
+                throw InvalidKeyException("Key not found!");
+            }
+
+            /// @brief 重载 [] 运算符，访问 Array 的成员，之前的元素整体跳过。
+            LazyRef operator[](size_t p_index) const
+            {
+                if (!is_array())
+                    throw TypeException("Not an array");
+                size_t pos = m_doc->first_item(m_pos);
+                for (; pos != LazyDocument::npos && p_index > 0; --p_index)
+                    pos = m_doc->next_item(m_doc->value_end(pos), ']');
+                if (pos == LazyDocument::npos)
+                    throw OutOfRangeException("Index out of range!");
+                return LazyRef(m_doc, pos);
+            }
+
+        public:
+            /// @brief 获取 Array 或 Object 的大小（需要扫描整个容器），标量返回 1。
+            size_t size() const
+            {
+                if (!is_array() && !is_object())
+                    return 1;
+                size_t count = 0;
+                for (auto it = begin(), last = end(); it != last; ++it)
+                    ++count;
+                return count;
+            }
+
+            /// @brief 遍历的起点（仅对 Array / Object 有效）。
+            Iterator begin() const
+            {
+                if (!is_array() && !is_object())
+                    throw TypeException("Not a container");
+                return Iterator(m_doc, m_doc->first_item(m_pos), is_object());
+            }
+            /// @brief 遍历的终点。
+            Iterator end() const
+            {
+                if (!is_array() && !is_object())
+                    throw TypeException("Not a container");
+                return Iterator(m_doc, LazyDocument::npos, is_object());
+            }
+
+        public:
+            /// @brief 检查值是否为 null。
+            bool is_null() const { return type() == TapeType::Null; }
+            /// @brief 检查值是否为布尔值。
+            bool is_bool() const { return type() == TapeType::True || type() == TapeType::False; }
+            /// @brief 检查值是否为整数。
+            bool is_int() const { return type() == TapeType::Int || type() == TapeType::UInt; }
+            /// @brief 检查值是否为浮点数。
+            bool is_float() const { return type() == TapeType::Float; }
+            /// @brief 检查值是否为字符串。
+            bool is_str() const { return type() == TapeType::String; }
+            /// @brief 检查值是否为数组。
+            bool is_array() const { return type() == TapeType::ArrayBegin; }
+            /// @brief 检查值是否为对象。
+            bool is_object() const { return type() == TapeType::ObjectBegin; }
+
+        public:
+            /// @brief 以布尔值形式获取值。
+            bool as_bool() const
+            {
+                if (is_bool())
+                    return type() == TapeType::True;
+                throw TypeException("Not an bool value");
+            }
+            /// @brief 以整数形式获取值，允许从浮点数转换，超出 int64_t 范围时抛出异常。
+            int64_t as_int() const
+            {
+                const TapeType t = type();
+                if (t == TapeType::UInt)
+                    throw OutOfRangeException("Integer out of int64 range!");
+                if (t == TapeType::Int)
+                {
+                    int64_t value = 0;
+                    const string_v_t text = number_text();
+                    std::from_chars(text.data(), text.data() + text.size(), value);
+                    return value;
+                }
+                if (t == TapeType::Float)
+                {
+                    int64_t value;
+                    if (!number::truncate_to_int64(float_value(), value))
+                        throw OutOfRangeException("Number out of int64 range!");
+                    return value;
+                }
+                throw TypeException("Not an int value");
+            }
+            /// @brief 以 64 位无符号整数形式获取值，负数时抛出异常。
+            uint64_t as_uint64() const
+            {
+                if (type() == TapeType::UInt)
+                {
+                    uint64_t value = 0;
+                    const string_v_t text = number_text();
+                    std::from_chars(text.data(), text.data() + text.size(), value);
+                    return value;
+                }
+                const int64_t value = as_int();
+                if (value < 0)
+                    throw OutOfRangeException("Negative integer out of uint64 range!");
+                return static_cast<uint64_t>(value);
+            }
+            /// @brief 以浮点数形式获取值。
+            double as_float() const
+            {
+                if (is_float())
+                    return float_value();
+                throw TypeException("Not an float value");
+            }
+            /// @brief 以字符串视图形式获取值：不含转义时指向原文，含转义时指向文档内部解码后的副本（只解码一次）。
+            string_v_t as_str() const
+            {
+                if (!is_str())
+                    throw TypeException("Not an string value");
+                bool escaped;
+                const size_t end = m_doc->string_end(m_pos, escaped);
+                return m_doc->decoded_at(m_pos, end, escaped);
+            }
+
+        public:
+            /**
+             * @brief 把游标所指的子树完整解析为一个 Document（节点位于文档自己的 Arena 上）。
+             *        字符串直接指向原文，因此结果同样要求 LazyDocument 的输入保持存活；
+             *        拥有模式下 Document 会共享输入的所有权。
+             */
+            Document materialize() const
+            {
+                const string_v_t text = raw();
+                auto arena = std::make_unique<Arena>();
+                ParseOptions options;
+                options.simd_level = m_doc->m_level;
+                Parser parser(text, options);
+                Element *root = nullptr;
+                try
+                {
+                    root = parser.parse_in(*arena).get();
+                }
+                catch (const ParseException &e)
+                {
+                    // 把子树内的位置换算回整个输入
+                    if (e.offset() == ParseException::npos)
+                        throw;
+                    throw m_doc->error(m_pos + e.offset(), e.message());
+                }
+                return Document(root, m_doc->m_source, std::move(arena));
+            }
+
+            /// @brief 将游标所指的值序列化为紧凑字符串，格式与 Element::serialize 一致。
+            string_t serialize() const
+            {
+                Document doc = materialize();
+                return doc.get()->serialize();
+            }
+
+        private:
+            /// @brief 检查游标是否有效。
+            void check() const
+            {
+                if (m_doc == nullptr)
+                    throw NullPointerException("Null reference");
+            }
+
+            /// @brief 校验 m_pos 处的字面量。
+            void literal(const char *p_text, const char *p_msg) const
+            {
+                const size_t len = std::strlen(p_text);
+                if (m_doc->m_input.compare(m_pos, len, p_text) != 0 ||
+                    simd::char_classes.table[static_cast<uint8_t>(m_doc->at(m_pos + len))] == simd::ClassOther)
+                    throw m_doc->error(m_pos, p_msg);
+            }
+
+            /// @brief 数字的原文。
+            string_v_t number_text() const { return m_doc->m_input.substr(m_pos, m_doc->value_end(m_pos) - m_pos); }
+
+            /// @brief 按 JSON 数字语法校验原文，并按 Parser 的规则确定类型。
+            TapeType number_type() const
+            {
+                const string_v_t text = number_text();
+                const char *begin = text.data();
+                const char *end = begin + text.size();
+                const char *p = begin;
+                auto digits = [&p, end]()
+                {
+                    const char *start = p;
+                    while (p < end && *p >= '0' && *p <= '9')
+                        ++p;
+                    return p != start;
+                };
+                if (p < end && *p == '-')
+                    ++p;
+                if (p == end || !(*p >= '0' && *p <= '9'))
+                {
+                    if (p == begin)
+                        throw m_doc->error(m_pos, (std::string) "Unexpected character '" + std::string(1, *begin) + "'");
+                    throw m_doc->error(m_pos + (p - begin), "Invalid number: expected digit");
+                }
+                digits();
+                bool is_float = false;
+                if (p < end && *p == '.')
+                {
+                    ++p;
+                    if (!digits())
+                        throw m_doc->error(m_pos + (p - begin), "Invalid number: expected digit after '.'");
+                    is_float = true;
+                }
+                if (p < end && (*p == 'e' || *p == 'E'))
+                {
+                    ++p;
+                    if (p < end && (*p == '+' || *p == '-'))
+                        ++p;
+                    if (!digits())
+                        throw m_doc->error(m_pos + (p - begin), "Invalid number: expected digit in exponent");
+                    is_float = true;
+                }
+                if (p != end)
+                    throw m_doc->error(m_pos + (p - begin), (std::string) "Unexpected character '" + std::string(1, *p) + "'");
+                if (is_float)
+                    return TapeType::Float;
+
+                // 整数依次尝试 int64_t、uint64_t，都放不下时退化为浮点数
+                int64_t value;
+                auto [ptr, ec] = std::from_chars(begin, end, value);
+                if (ec == std::errc() && ptr == end)
+                    return TapeType::Int;
+                if (*begin != '-')
+                {
+                    uint64_t uvalue;
+                    auto [uptr, uec] = std::from_chars(begin, end, uvalue);
+                    if (uec == std::errc() && uptr == end)
+                        return TapeType::UInt;
+                }
+                return TapeType::Float;
+            }
+
+            /// @brief 把数字原文转换为浮点数。
+            double float_value() const
+            {
+                const string_v_t text = number_text();
+                double value;
+                if (!number::parse_floating(text.data(), text.data() + text.size(), value))
+                    throw m_doc->error(m_pos, "Invalid float: " + std::string(text));
+                return value;
+            }
+        };
+
+        inline LazyRef LazyDocument::root() const { return LazyRef(this, skip_whitespace(0)); }
+        inline LazyRef LazyDocument::operator[](string_v_t p_key) const { return root()[p_key]; }
+        inline LazyRef LazyDocument::operator[](size_t p_index) const { return root()[p_index]; }
+    }
+}
+
+#endif // INCLUDE_JSON_LAZY_DOCUMENT
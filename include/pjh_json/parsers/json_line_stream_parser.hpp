@@ -0,0 +1,434 @@
+#ifndef INCLUDE_JSON_LINE_STREAM_PARSER
+#define INCLUDE_JSON_LINE_STREAM_PARSER
+
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <pjh_json/datas/json_document.hpp>
+
+#include <pjh_json/helpers/json_definition.hpp>
+#include <pjh_json/helpers/json_exception.hpp>
+#include <pjh_json/helpers/json_ref.hpp>
+
+#include <pjh_json/parsers/json_options.hpp>
+#include <pjh_json/parsers/json_parser.hpp>
+
+#include <pjh_json/utils/arena.hpp>
+#include <pjh_json/utils/channel.hpp>
+#include <pjh_json/utils/simd.hpp>
+#include <pjh_json/utils/thread_pool.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @struct LineStreamOptions
+         * @brief LineStreamParser 的选项。
+         */
+        struct LineStreamOptions
+        {
+            /// @brief 每次从输入读取的字节数。单条记录比它更长时，读取块会自动加倍。
+            size_t block_size = 4 * 1024 * 1024;
+            /// @brief 交给一个工作线程的一批记录的大致字节数，同一批记录共用一个 Arena。
+            size_t batch_size = 256 * 1024;
+            /// @brief 解析记录的工作线程数，为 0 时取硬件线程数。
+            size_t threads = 0;
+            /// @brief 是否按输入中的顺序交付记录。关闭后按解析完成的顺序交付，少一些等待。
+            bool ordered = true;
+            /// @brief 解析每条记录时使用的选项（pipelined 会被忽略）。
+            ParseOptions parse;
+        };
+
+        /**
+         * @struct LineRecord
+         * @brief LineStreamParser 交付的一条记录。
+         */
+        struct LineRecord
+        {
+            size_t line = 0;                       // 记录所在的行号（从 0 开始，空行同样计数）
+            Element *element = nullptr;            // 记录的根元素，由 batch 负责释放
+            std::shared_ptr<const Document> batch; // 持有记录节点所在的 Arena 与输入块，记录在它释放前有效
+
+            /// @brief 以 Ref 访问记录的根元素（Ref 的拷贝会深拷贝元素，因此记录本身只保存指针）。
+            Ref value() const { return Ref(element); }
+        };
+
+        /**
+         * @class LineStreamParser
+         * @brief NDJSON / JSON Lines 的流式读取器：每行一条 JSON 记录。
+         *
+         * 当前线程按大块读取文件或文件描述符，用向量化的换行符查找切出各行，
+         * 把若干行打包成一批交给线程池解析，再通过 next() / for_each() 依次交付。
+         * - 记录直接在读取块上以借用模式解析，不为每行拷贝字符串；
+         *   只有跨越块边界的那条不完整记录会被拷贝到下一块的开头。
+         * - 同一批记录解析到同一个 Arena 上，由 LineRecord::batch 共享持有，连同其所在的读取块一起释放。
+         * - 空行（只含空白）被跳过。某行解析失败（包括一条记录之后还有多余内容）时，next() 在轮到该行时抛出 ParseException，
+         *   其行号、列号与字节偏移都换算为整个输入中的位置；调用方捕获后可以继续调用 next()。
+         */
+        class LineStreamParser
+        {
+        private:
+            /// @brief 一个读取块，记录的 string_view 指向其中。
+            struct Block
+            {
+                std::unique_ptr<char[]> data;
+                size_t size = 0;
+            };
+
+            /// @brief 一条记录的解析结果。
+            struct Slot
+            {
+                size_t line;
+                Element *value;
+                std::exception_ptr error;
+            };
+
+            /// @brief 交给工作线程的一批记录。
+            struct Batch
+            {
+                size_t seq = 0;                                    // 批次序号
+                std::shared_ptr<Block> block;                      // 记录所在的读取块
+                size_t base = 0;                                   // 读取块在输入流中的偏移
+                std::vector<std::pair<size_t, string_v_t>> lines;  // 行号与该行的内容
+                size_t bytes = 0;                                  // 各行的总字节数
+                std::vector<Slot> slots;                           // 解析结果
+                std::shared_ptr<const Document> doc;               // 持有本批的 Arena 与读取块
+                std::exception_ptr failure;                        // 整批失败（例如内存不足）
+                size_t cursor = 0;                                 // 下一条要交付的记录
+            };
+
+            LineStreamOptions m_options;
+            int m_fd;       // 输入的文件描述符
+            bool m_owns_fd; // 是否由本对象负责关闭 m_fd
+            bool m_eof;     // 输入是否已读完
+
+            std::shared_ptr<Block> m_carry_block; // 上一块末尾不完整的记录所在的块
+            size_t m_carry_offset;                // 不完整记录在该块中的起点
+            size_t m_carry_size;                  // 不完整记录的长度
+            size_t m_stream_offset;               // m_carry_offset 在输入流中的偏移
+            size_t m_line;                        // 下一行的行号
+
+            std::deque<std::shared_ptr<Batch>> m_pending;       // 已切分、尚未提交的批次
+            size_t m_next_seq;                                  // 下一个切分出的批次的序号
+            size_t m_deliver_seq;                               // 顺序交付时下一个应交付的批次
+            size_t m_in_flight;                                 // 已提交、尚未交付的批次数
+            size_t m_max_in_flight;                             // 同时在途的批次上限
+            std::map<size_t, std::shared_ptr<Batch>> m_arrived; // 顺序交付时提前完成的批次
+            std::shared_ptr<Batch> m_current;                   // 正在交付的批次
+
+            // 线程池最后声明、最先析构：保证仍在运行的任务结束前，它们引用的通道依然存在
+            Channel<std::shared_ptr<Batch>> m_done;
+            ThreadPool m_pool;
+
+        public:
+            /// @brief 构造函数，打开文件，失败时抛出 FileException。@param p_path 文件路径。
+            explicit LineStreamParser(const std::filesystem::path &p_path, const LineStreamOptions &p_options = LineStreamOptions())
+                : LineStreamParser(open_file(p_path), true, p_options) {}
+            /// @brief 构造函数，从已打开的文件描述符读取（不负责关闭）。@param p_fd 文件描述符，例如管道或标准输入。
+            explicit LineStreamParser(int p_fd, const LineStreamOptions &p_options = LineStreamOptions())
+                : LineStreamParser(p_fd, false, p_options) {}
+
+            LineStreamParser(const LineStreamParser &) = delete;
+            LineStreamParser &operator=(const LineStreamParser &) = delete;
+
+            /// @brief 析构函数，等待在途的批次解析结束，并关闭自己打开的文件。
+            ~LineStreamParser()
+            {
+                if (m_owns_fd)
+#if defined(_WIN32)
+                    ::_close(m_fd);
+#else
+                    ::close(m_fd);
+#endif
+            }
+
+        public:
+            /**
+             * @brief 取出下一条记录。
+             * @param p_record 输出的记录。
+             * @return 输入已全部交付时返回 false。
+             */
+            bool next(LineRecord &p_record)
+            {
+                while (true)
+                {
+                    if (m_current != nullptr && m_current->cursor < m_current->slots.size())
+                    {
+                        const Slot &slot = m_current->slots[m_current->cursor++];
+                        if (slot.error)
+                            std::rethrow_exception(slot.error);
+                        p_record.line = slot.line;
+                        p_record.element = slot.value;
+                        p_record.batch = m_current->doc;
+                        return true;
+                    }
+                    m_current.reset();
+                    submit_batches();
+                    if (m_in_flight == 0)
+                        return false;
+                    m_current = receive();
+                }
+            }
+
+            /**
+             * @brief 依次对每条记录调用 p_func(const LineRecord &)。某行解析失败时抛出异常并停止。
+             * @return 交付的记录数。
+             */
+            template <typename Func>
+            size_t for_each(Func &&p_func)
+            {
+                LineRecord record;
+                size_t count = 0;
+                while (next(record))
+                {
+                    p_func(static_cast<const LineRecord &>(record));
+                    ++count;
+                }
+                return count;
+            }
+
+        private:
+            LineStreamParser(int p_fd, bool p_owns_fd, const LineStreamOptions &p_options)
+                : m_options(p_options), m_fd(p_fd), m_owns_fd(p_owns_fd), m_eof(false),
+                  m_carry_block(), m_carry_offset(0), m_carry_size(0), m_stream_offset(0), m_line(0),
+                  m_next_seq(0), m_deliver_seq(0), m_in_flight(0), m_max_in_flight(0), m_pool(p_options.threads)
+            {
+                m_options.parse.pipelined = false;
+                m_options.block_size = (std::max)(m_options.block_size, size_t(4096));
+                m_max_in_flight = 2 * m_pool.size() + 2;
+            }
+
+            /// @brief 打开文件并返回文件描述符。
+            static int open_file(const std::filesystem::path &p_path)
+            {
+#if defined(_WIN32)
+                const int fd = ::_wopen(p_path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+                const int fd = ::open(p_path.c_str(), O_RDONLY);
+#endif
+                if (fd < 0)
+                    throw FileException("cannot open '" + p_path.string() + "'");
+                return fd;
+            }
+
+            /// @brief 从输入读取至多 p_size 字节，返回实际读取的字节数（0 表示输入结束）。
+            size_t read_some(char *p_data, size_t p_size)
+            {
+                while (true)
+                {
+#if defined(_WIN32)
+                    const int chunk = p_size > 0x40000000 ? 0x40000000 : static_cast<int>(p_size);
+                    const int got = ::_read(m_fd, p_data, chunk);
+#else
+                    const ssize_t got = ::read(m_fd, p_data, p_size);
+#endif
+                    if (got >= 0)
+                        return static_cast<size_t>(got);
+                    if (errno != EINTR)
+                        throw FileException(std::string("read failed: ") + std::strerror(errno));
+                }
+            }
+
+            /// @brief 在不超过在途上限的前提下提交批次，待提交的批次用完时读取下一块。
+            void submit_batches()
+            {
+                while (m_in_flight < m_max_in_flight)
+                {
+                    if (m_pending.empty() && !read_block())
+                        return;
+                    if (m_pending.empty())
+                        continue;
+                    std::shared_ptr<Batch> batch = std::move(m_pending.front());
+                    m_pending.pop_front();
+                    ++m_in_flight;
+                    m_pool.submit([this, batch]()
+                                  { parse_batch(*batch);
+                                    m_done.push(batch); });
+                }
+            }
+
+            /// @brief 取回一个解析完成的批次：顺序交付时等待序号最小的那一批。
+            std::shared_ptr<Batch> receive()
+            {
+                std::shared_ptr<Batch> batch;
+                if (!m_options.ordered)
+                    batch = pop_done();
+                else
+                {
+                    auto found = m_arrived.find(m_deliver_seq);
+                    while (found == m_arrived.end())
+                    {
+                        std::shared_ptr<Batch> arrived = pop_done();
+                        const size_t seq = arrived->seq;
+                        found = m_arrived.emplace(seq, std::move(arrived)).first;
+                        if (seq != m_deliver_seq)
+                            found = m_arrived.end();
+                    }
+                    batch = std::move(found->second);
+                    m_arrived.erase(found);
+                    ++m_deliver_seq;
+                }
+                --m_in_flight;
+                if (batch->failure)
+                    std::rethrow_exception(batch->failure);
+                return batch;
+            }
+
+            /// @brief 从完成通道中取出一个批次（阻塞）。
+            std::shared_ptr<Batch> pop_done()
+            {
+                std::shared_ptr<Batch> batch = m_done.peek();
+                m_done.pop();
+                return batch;
+            }
+
+            /**
+             * @brief 读取下一块并切分为批次。块以上一块末尾不完整的记录开头，
+             *        读到至少一个换行符（或输入结束）为止；单条记录比块更长时把块加倍。
+             * @return 输入已经全部切分完毕时返回 false。
+             */
+            bool read_block()
+            {
+                if (m_eof && m_carry_size == 0)
+                    return false;
+
+                auto block = std::make_shared<Block>();
+                size_t capacity = (std::max)(m_options.block_size, m_carry_size * 2);
+                block->data.reset(new char[capacity]);
+                if (m_carry_size != 0)
+                    std::memcpy(block->data.get(), m_carry_block->data.get() + m_carry_offset, m_carry_size);
+                block->size = m_carry_size;
+                const size_t base = m_stream_offset;
+                m_carry_block.reset();
+
+                // 新读入的部分里找不到换行符时继续读，块满了就加倍
+                size_t scanned = block->size;
+                size_t complete = 0;
+                while (true)
+                {
+                    while (block->size < capacity && !m_eof)
+                    {
+                        const size_t got = read_some(block->data.get() + block->size, capacity - block->size);
+                        if (got == 0)
+                            m_eof = true;
+                        block->size += got;
+                    }
+                    const char *data = block->data.get();
+                    size_t last = block->size;
+                    while (last > scanned && data[last - 1] != '\n')
+                        --last;
+                    if (last > scanned || m_eof)
+                    {
+                        complete = m_eof ? block->size : last;
+                        break;
+                    }
+                    scanned = block->size;
+                    capacity *= 2;
+                    std::unique_ptr<char[]> grown(new char[capacity]);
+                    std::memcpy(grown.get(), data, block->size);
+                    block->data = std::move(grown);
+                }
+
+                m_carry_block = block;
+                m_carry_offset = complete;
+                m_carry_size = block->size - complete;
+                m_stream_offset = base + complete;
+                split_lines(block, base, complete);
+                return true;
+            }
+
+            /// @brief 把块中 [0, p_complete) 的完整行按 batch_size 打包为批次，追加到待提交队列。
+            void split_lines(const std::shared_ptr<Block> &p_block, size_t p_base, size_t p_complete)
+            {
+                const simd::Level level = m_options.parse.simd_level;
+                const char *data = p_block->data.get();
+                const char *end = data + p_complete;
+                std::shared_ptr<Batch> batch;
+                for (const char *line = data; line < end;)
+                {
+                    const char *newline = simd::find_char(level, line, end, '\n');
+                    // 只含空白的行不构成记录，但仍然占用一个行号
+                    if (simd::skip_whitespace(level, line, newline) != newline)
+                    {
+                        if (batch == nullptr)
+                        {
+                            batch = std::make_shared<Batch>();
+                            batch->seq = m_next_seq++;
+                            batch->block = p_block;
+                            batch->base = p_base;
+                        }
+                        batch->lines.emplace_back(m_line, string_v_t(line, static_cast<size_t>(newline - line)));
+                        batch->bytes += static_cast<size_t>(newline - line);
+                        if (batch->bytes >= m_options.batch_size)
+                            m_pending.push_back(std::move(batch));
+                    }
+                    ++m_line;
+                    line = newline + 1;
+                }
+                if (batch != nullptr)
+                    m_pending.push_back(std::move(batch));
+            }
+
+            /// @brief 工作线程：把一批记录解析到同一个 Arena 上。
+            void parse_batch(Batch &p_batch)
+            {
+                try
+                {
+                    auto arena = std::make_unique<Arena>((std::min)((std::max)(p_batch.bytes * 2, Arena::default_block_size), Arena::max_block_size));
+                    Array *records = Element::create_in<Array>(*arena, arena.get());
+                    records->reserve(p_batch.lines.size());
+                    p_batch.slots.reserve(p_batch.lines.size());
+                    for (const auto &[line, text] : p_batch.lines)
+                    {
+                        try
+                        {
+                            Parser parser(text, m_options.parse);
+                            // 每行只能有一条记录，值之后多余的内容按错误处理，而不是悄悄丢弃
+                            Element *value = parser.parse_in(*arena, true).get();
+                            records->append_raw_ptr(value);
+                            p_batch.slots.push_back({line, value, nullptr});
+                        }
+                        catch (const ParseException &e)
+                        {
+                            // 把行内的位置换算为整个输入中的位置
+                            const size_t offset = e.offset() == ParseException::npos
+                                                      ? ParseException::npos
+                                                      : p_batch.base + static_cast<size_t>(text.data() - p_batch.block->data.get()) + e.offset();
+                            p_batch.slots.push_back({line, nullptr, std::make_exception_ptr(ParseException(line + 1, e.column(), offset, e.message()))});
+                        }
+                        catch (...)
+                        {
+                            p_batch.slots.push_back({line, nullptr, std::current_exception()});
+                        }
+                    }
+                    // 文档的根是本批全部记录组成的数组，输入块随文档一起释放
+                    p_batch.doc = std::make_shared<const Document>(records, p_batch.block, std::move(arena));
+                }
+                catch (...)
+                {
+                    p_batch.failure = std::current_exception();
+                }
+                p_batch.block.reset();
+                p_batch.lines.clear();
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_LINE_STREAM_PARSER
@@ -0,0 +1,38 @@
+#ifndef INCLUDE_JSON_OPTIONS
+#define INCLUDE_JSON_OPTIONS
+
+#include <memory>
+#include <vector>
+
+#include <pjh_json/helpers/json_definition.hpp>
+#include <pjh_json/helpers/json_key_table.hpp>
+
+#include <pjh_json/utils/simd.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @struct ParseOptions
+         * @brief 解析选项，由 Parser 转交给 Tokenizer。所有选项默认关闭，保持与原有行为一致。
+         */
+        struct ParseOptions
+        {
+            /// @brief 先用 SIMD 建立结构字符索引，再由 Tokenizer 按索引跳转，而不是逐字节扫描。
+            bool structural_index = false;
+            /// @brief 向量化扫描使用的指令集级别，默认取 CPU 支持的最高级别。
+            simd::Level simd_level = simd::detect_level();
+            /// @brief 解析前向量化地校验输入是否为合法的 UTF-8，遇到非法序列时抛出带字节偏移的 ParseException。
+            bool validate_utf8 = false;
+            /// @brief 在后台线程中运行词法分析，与构建结果的当前线程组成两级流水线，适合较大的输入；只有一个硬件线程时忽略。
+            bool pipelined = false;
+            /// @brief 非空时只解析根对象中这些键的成员，其余成员不构建也不产生事件，其值由 Tokenizer::skip_value 整体跳过（不做校验）。
+            std::vector<string_t> key_allowlist;
+            /// @brief 非空时把解析出的对象键驻留到这张表中（可以是 KeyTable::global()），对象键指向表中的内容而不是输入。
+            std::shared_ptr<KeyTable> key_table;
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_OPTIONS
@@ -1,22 +1,39 @@
 #ifndef INCLUDE_JSON_PARSER
 #define INCLUDE_JSON_PARSER
 
-// #include <thread>
+#include <algorithm>
 #include <charconv>
+#include <limits>
+#include <memory>
+#include <filesystem>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include <pjh_json/datas/json_element.hpp>
 #include <pjh_json/datas/json_value.hpp>
 #include <pjh_json/datas/json_array.hpp>
 #include <pjh_json/datas/json_object.hpp>
+#include <pjh_json/datas/json_document.hpp>
+#include <pjh_json/datas/json_tape.hpp>
 
+#include <pjh_json/helpers/json_key_table.hpp>
 #include <pjh_json/helpers/json_ref.hpp>
 #include <pjh_json/helpers/json_ref.hpp>
 
+#include <pjh_json/parsers/json_array_splitter.hpp>
+#include <pjh_json/parsers/json_options.hpp>
+#include <pjh_json/parsers/json_sax.hpp>
+#include <pjh_json/parsers/json_token_pipeline.hpp>
 #include <pjh_json/parsers/json_tokenizer.hpp>
 
 #include <pjh_json/utils/channel.hpp>
+#include <pjh_json/utils/escape.hpp>
 #include <pjh_json/utils/object_pool.hpp>
 #include <pjh_json/utils/lock_free_ring_buffer.hpp>
+#include <pjh_json/utils/mapped_file.hpp>
+#include <pjh_json/utils/number.hpp>
+#include <pjh_json/utils/thread_pool.hpp>
 
 namespace pjh_std
 {
@@ -25,159 +42,629 @@ namespace pjh_std
         /**
          * @class Parser
          * @brief 语法分析器，采用递归下降的方式将 Token 流解析成一棵由 Element 构成的 JSON 树。
+         *        同一套递归下降（walk_value）也可以输出为 Tape（parse_to_tape），或只产生 SAX 事件（parse_sax）。
          *
          * 注意！如果需要跨 Parser 生命周期使用解析的数据，必须避免 Parser 的析构！
          * Parser 中保留有数据里 string_view 的原始指针！
+         *
+         * 使用 string_v_t / (const char *, size_t) 构造时为借用模式：不拷贝输入，
+         * 解析结果中的 string_view 直接指向调用方的缓冲区，此时需要保证的是该缓冲区（而非 Parser）的生命周期。
+         *
+         * 含转义序列的字符串会被解码：堆模式下值持有解码后的副本，对象键则解码到 Parser 自己的 Arena 上，
+         * 因此含转义的键同样要求 Parser 存活；解析为 Document 时一律解码到文档的 Arena 上。
+         * 设置了 ParseOptions::key_table 时对象键都驻留到该表中，只要求表存活（Document 会保持表存活）。
          */
         class Parser
         {
         private:
-            // LockFreeRingBuffer<Token> m_buffer;
-            Tokenizer m_tokenizer; // 内嵌一个词法分析器
+            Tokenizer m_tokenizer;                   // 内嵌一个词法分析器
+            bool m_pipelined;                        // 是否在后台线程中运行词法分析
+            TokenPipeline *m_pipeline;               // 当前解析使用的流水线，为空时直接读取 m_tokenizer
+            Arena *m_arena;                          // 节点分配所用的 Arena，为空时节点分配在堆上
+            std::unique_ptr<Arena> m_decoded;        // 堆模式下解码后的对象键（与 Parser 同生命周期，按需创建）
+            string_t m_scratch;                      // 解析 Tape 或驻留键时解码字符串用的临时缓冲区
+            std::vector<string_t> m_key_allowlist;   // 根对象中需要解析的键，为空时解析全部成员
+            std::unique_ptr<KeyTable::Cache> m_keys; // 对象键的驻留缓存，未设置 key_table 时为空
 
         public:
-            /// @brief 构造函数。@param p_str 要解析的 JSON 字符串。
-            Parser(const std::string &p_str /*, size_t capacity = 16384*/)
-                : m_tokenizer(p_str) /*, m_buffer(capacity)*/ {}
-            /// @brief 构造函数。@param p_tokenizer 外部传入的词法分析器。
-            Parser(Tokenizer &p_tokenizer /*, size_t capacity*/)
-                : m_tokenizer(p_tokenizer) /*, m_buffer(capacity)*/ {}
+            /// @brief 构造函数。@param p_str 要解析的 JSON 字符串（会被拷贝一份）。@param p_options 解析选项。
+            Parser(const std::string &p_str, const ParseOptions &p_options = ParseOptions())
+                : m_tokenizer(p_str, p_options), m_pipelined(p_options.pipelined), m_pipeline(nullptr), m_arena(nullptr),
+                  m_key_allowlist(p_options.key_allowlist), m_keys(make_key_cache(p_options)) {}
+            /// @brief 构造函数。@param p_str 要解析的 JSON 字符串（接管所有权，不拷贝）。
+            Parser(std::string &&p_str, const ParseOptions &p_options = ParseOptions())
+                : m_tokenizer(std::move(p_str), p_options), m_pipelined(p_options.pipelined), m_pipeline(nullptr), m_arena(nullptr),
+                  m_key_allowlist(p_options.key_allowlist), m_keys(make_key_cache(p_options)) {}
+            /// @brief 构造函数。@param p_str 要解析的 JSON 字符串（会被拷贝一份）。
+            Parser(const char *p_str, const ParseOptions &p_options = ParseOptions())
+                : m_tokenizer(p_str, p_options), m_pipelined(p_options.pipelined), m_pipeline(nullptr), m_arena(nullptr),
+                  m_key_allowlist(p_options.key_allowlist), m_keys(make_key_cache(p_options)) {}
+            /// @brief 构造函数（借用模式）。@param p_view 调用方持有的 JSON 文本，必须比解析结果活得更久。
+            explicit Parser(string_v_t p_view, const ParseOptions &p_options = ParseOptions())
+                : m_tokenizer(p_view, p_options), m_pipelined(p_options.pipelined), m_pipeline(nullptr), m_arena(nullptr),
+                  m_key_allowlist(p_options.key_allowlist), m_keys(make_key_cache(p_options)) {}
+            /// @brief 构造函数（借用模式）。@param p_data 调用方持有的缓冲区起始地址。@param p_size 缓冲区长度。
+            Parser(const char *p_data, size_t p_size, const ParseOptions &p_options = ParseOptions())
+                : m_tokenizer(p_data, p_size, p_options), m_pipelined(p_options.pipelined), m_pipeline(nullptr), m_arena(nullptr),
+                  m_key_allowlist(p_options.key_allowlist), m_keys(make_key_cache(p_options)) {}
+            /// @brief 构造函数。@param p_tokenizer 外部传入的词法分析器（拷贝，借用模式下不会拷贝输入）。
+            Parser(Tokenizer &p_tokenizer)
+                : m_tokenizer(p_tokenizer), m_pipelined(false), m_pipeline(nullptr), m_arena(nullptr) {}
+            /// @brief 构造函数。@param p_tokenizer 外部传入的词法分析器（移动）。
+            Parser(Tokenizer &&p_tokenizer)
+                : m_tokenizer(std::move(p_tokenizer)), m_pipelined(false), m_pipeline(nullptr), m_arena(nullptr) {}
 
             /// @brief 解析的入口函数，开始整个解析过程。
-            Ref parse() { return Ref(parse_value()); }
-
-            // 多线程版本，但是性能不如单线程改回去了
-            // Ref parse()
-            // {
-            //     std::thread producer_thread(
-            //         [&]()
-            //         {
-            //             try
-            //             {
-            //                 while (true)
-            //                 {
-            //                     Token token = m_tokenizer.peek();
-            //                     if (token.type == TokenType::End)
-            //                         break;
-            //                     while (!m_buffer.push(token))
-            //                     {
-            //                         std::this_thread::sleep_for(std::chrono::microseconds(10));
-            //                         // std::cout << "full!" << std::endl;
-            //                     }
-            //                     m_tokenizer.consume();
-            //                 }
-            //             }
-            //             catch (const std::exception &e)
-            //             {
-            //                 // std::cout << e.what() << std::endl;
-            //                 throw ThreadException(e.what());
-            //             }
-            //         });
-
-            //     Ref root = Ref(parse_value());
-            //     producer_thread.join();
-            //     return root;
-            // }
+            Ref parse()
+            {
+                return run([this]()
+                           { return Ref(parse_value()); });
+            }
+
+            /**
+             * @brief 解析为一个 Document：所有节点分配在文档自己的 Arena 上，文档销毁时整体释放。
+             *        拥有模式下文档与 Parser 共享输入副本，因此结果可以比 Parser 活得更久；
+             *        借用模式下调用方的缓冲区仍需比文档活得更久。
+             */
+            Document parse_document() { return parse_into_document(m_tokenizer.source_owner()); }
+
+            /**
+             * @brief 以只读内存映射的方式打开并解析一个文件，不把文件读入字符串。
+             * @param p_path 文件路径。
+             * @param p_options 解析选项。
+             * @return 解析结果。文档中的 string_view 直接指向映射区域，映射随 Document 一同释放。
+             */
+            static Document parse_file(const std::filesystem::path &p_path, const ParseOptions &p_options = ParseOptions())
+            {
+                auto file = std::make_shared<MappedFile>(p_path);
+                Parser parser(file->view(), p_options);
+                return parser.parse_into_document(std::move(file));
+            }
+
+            /**
+             * @brief 解析到调用方提供的 Arena 上：节点、容器与含转义的字符串都分配在 p_arena 上，
+             *        结果的生命周期只取决于 p_arena 与输入缓冲区（拥有模式下即 Parser 内部的副本）。
+             *        适合把许多小文档（例如逐行的记录）放进同一个 Arena，分摊申请内存块的开销。
+             * @param p_whole_input 为 true 时值之后只允许空白，否则抛出 ParseException（与 PushParser 的规则相同）。
+             */
+            Ref parse_in(Arena &p_arena, bool p_whole_input = false)
+            {
+                m_arena = &p_arena;
+                Element *root = nullptr;
+                try
+                {
+                    root = run([this, p_whole_input]()
+                               {
+                                   Element *value = parse_value();
+                                   if (p_whole_input && peek().type != TokenType::End)
+                                       throw error(peek(), "Unexpected content after the JSON value");
+                                   return value; });
+                }
+                catch (...)
+                {
+                    m_arena = nullptr;
+                    throw;
+                }
+                m_arena = nullptr;
+                return Ref(root);
+            }
+
+            /// @brief 并行解析时每段至少包含的字节数，更小的输入不值得切分。
+            static constexpr size_t parallel_min_chunk = 256 * 1024;
+
+            /**
+             * @brief 并行解析一个顶层数组（借用模式）：先用结构扫描找到顶层元素之间的逗号，
+             *        把数组切成若干段交给线程池，每段由独立的 Parser 解析到自己的 Arena 上，
+             *        最后按顺序拼接成同一个 Array，各段的 Arena 由文档的 Arena 接管。
+             *        输入不是顶层数组、太小或线程池只有一个线程时退回单线程的 parse_document()；
+             *        任何一段出错时重新单线程解析，因此抛出的异常与单线程解析完全一致。
+             * @param p_input 调用方持有的 JSON 文本，必须比返回的文档活得更久。
+             * @param p_pool 执行扫描与解析的线程池，可在多次解析之间复用；也可以在这个线程池自己的任务中调用，
+             *        工作线程都在忙时由调用线程完成剩余的部分。
+             * @param p_options 解析选项（pipelined 会被忽略）。
+             */
+            static Document parse_parallel(string_v_t p_input, ThreadPool &p_pool, const ParseOptions &p_options = ParseOptions())
+            {
+                return parse_parallel_into(p_input, p_pool, p_options, nullptr);
+            }
+            /// @brief 并行解析一个顶层数组，临时创建 p_threads 个线程（为 0 时取硬件线程数）。
+            static Document parse_parallel(string_v_t p_input, size_t p_threads = 0, const ParseOptions &p_options = ParseOptions())
+            {
+                ThreadPool pool(p_threads);
+                return parse_parallel_into(p_input, pool, p_options, nullptr);
+            }
+            /// @brief 以内存映射的方式打开文件并并行解析，映射随 Document 一同释放。
+            static Document parse_file_parallel(const std::filesystem::path &p_path, ThreadPool &p_pool, const ParseOptions &p_options = ParseOptions())
+            {
+                auto file = std::make_shared<MappedFile>(p_path);
+                const string_v_t view = file->view();
+                return parse_parallel_into(view, p_pool, p_options, std::move(file));
+            }
+
+            /**
+             * @brief 将输入解析为扁平的 Tape 而不是 Element 树。
+             *        所有节点依次写入同一段连续数组，字符串拷贝进 Tape 的字符串池，
+             *        因此结果不依赖输入缓冲区的生命周期，也没有逐节点的堆分配。
+             */
+            Tape parse_to_tape()
+            {
+                Tape tape;
+                // 粗略估计：每 8 个字节的输入约产生一个条目
+                tape.reserve(m_tokenizer.source().size() / 8 + 4, m_tokenizer.source().size() / 2);
+                TapeBuilder builder{*this, tape};
+                run([&]()
+                    { walk_root(builder); });
+                return tape;
+            }
+
+            /**
+             * @brief 以 SAX 方式解析：不构建任何节点，按文档顺序把事件交给 p_handler（见 SaxHandler）。
+             *        借用模式下整个过程不分配内存（解码含转义的字符串时复用同一个缓冲区）。
+             *        语法错误照常抛出异常，此前的事件已经交给处理器。
+             * @param p_handler 处理器，通常派生自 SaxHandler 并只定义关心的回调。
+             */
+            template <typename Handler>
+            void parse_sax(Handler &p_handler)
+            {
+                SaxBuilder<Handler> builder{*this, p_handler};
+                run([&]()
+                    { walk_root(builder); });
+            }
 
         private:
             /// @brief 查看下一个 Token。
-            Token peek() { return m_tokenizer.peek(); }
+            Token peek() { return m_pipeline != nullptr ? m_pipeline->peek() : m_tokenizer.peek(); }
             /// @brief 消费当前 Token。
-            void consume() { m_tokenizer.consume(); }
-            // 多线程版本的跨线程交互数据
-            // Token peek()
-            // {
-            //     std::optional<Token> token;
-            //     while (!(token = m_buffer.peek()).has_value())
-            //     {
-            //         std::this_thread::sleep_for(std::chrono::microseconds(10));
-            //         // std::cout << "empty!" << std::endl;
-            //     }
-            //     return token.value();
-            // }
-            // void consume()
-            // {
-            //     while (!m_buffer.pop())
-            //     {
-            //         std::this_thread::sleep_for(std::chrono::microseconds(10));
-            //         // std::cout << "empty!" << std::endl;
-            //     }
-            // }
-
-            /// @brief 解析一个通用的 JSON 值（可能是 object, array, string, number, bool, null）。
-            /// 这是递归下降的核心分发函数。
-            Element *parse_value()
+            void consume()
             {
-                Token token = peek();
+                if (m_pipeline != nullptr)
+                    m_pipeline->consume();
+                else
+                    m_tokenizer.consume();
+            }
 
-                switch (token.type)
+            /**
+             * @brief 执行一次解析：开启了流水线选项且有多个硬件线程时，词法分析在后台线程中进行，
+             *        当前线程通过 TokenPipeline 读取 Token；无论成功与否，返回前后台线程都已退出。
+             */
+            template <typename Func>
+            auto run(Func &&p_func) -> decltype(p_func())
+            {
+                // 单核机器上两个线程只会互相抢占，直接退回单线程
+                if (!m_pipelined || std::thread::hardware_concurrency() < 2)
+                    return p_func();
+                TokenPipeline pipeline(m_tokenizer);
+                struct Reset
                 {
-                case TokenType::ObjectBegin:
-                    return Parser::parse_object();
-                case TokenType::ArrayBegin:
-                    return Parser::parse_array();
-                case TokenType::Integer:
+                    TokenPipeline *&ptr;
+                    ~Reset() { ptr = nullptr; }
+                } reset{m_pipeline};
+                m_pipeline = &pipeline;
+                return p_func();
+            }
+
+            /// @brief 按解析选项创建对象键的驻留缓存（没有 key_table 时为空）。
+            static std::unique_ptr<KeyTable::Cache> make_key_cache(const ParseOptions &p_options)
+            {
+                if (p_options.key_table == nullptr)
+                    return nullptr;
+                return std::make_unique<KeyTable::Cache>(p_options.key_table);
+            }
+
+            /// @brief 根据输入大小选择 Arena 第一个块的大小：节点约占输入的数倍，尽量减少换块次数。
+            static size_t arena_block_size(size_t p_input_size) noexcept
+            {
+                return (std::min)((std::max)(p_input_size * 2, Arena::default_block_size), Arena::max_block_size);
+            }
+
+            /// @brief parse_parallel 的实现，p_source 为需要随文档存活的输入缓冲区。
+            static Document parse_parallel_into(string_v_t p_input, ThreadPool &p_pool, const ParseOptions &p_options,
+                                                std::shared_ptr<const void> p_source)
+            {
+                ParseOptions options = p_options;
+                options.pipelined = false;
+                auto serial = [&]()
                 {
-                    int val;
-                    // 使用 C++17 的 from_chars 高效转换
-                    auto [ptr, ec] = std::from_chars(token.value.data(), token.value.data() + token.value.size(), val);
-                    if (ec != std::errc())
-                    {
-                        throw Exception("Invalid integer: " + std::string(token.value));
-                    }
+                    Parser parser(p_input, options);
+                    return parser.parse_into_document(p_source);
+                };
+
+                const size_t parts = (std::min)(p_pool.size(), p_input.size() / parallel_min_chunk);
+                const size_t open = p_input.find_first_not_of(" \t\n\r");
+                const size_t close = p_input.find_last_not_of(" \t\n\r");
+                std::vector<size_t> commas;
+                if (parts < 2 || open == string_v_t::npos || p_input[open] != '[' || p_input[close] != ']' ||
+                    !ArraySplitter::split(p_input, parts, &p_pool, commas, options.simd_level))
+                    return serial();
+
+                // 第 idx 段是两个切分逗号之间的文本（不含逗号本身）
+                const size_t ranges = commas.size() + 1;
+                std::vector<std::vector<Element *>> elements(ranges);
+                std::vector<std::unique_ptr<Arena>> arenas(ranges);
+                try
+                {
+                    p_pool.parallel_for(ranges, [&](size_t idx)
+                                        {
+                        const size_t begin = idx == 0 ? open + 1 : commas[idx - 1] + 1;
+                        const size_t end = idx + 1 == ranges ? close : commas[idx];
+                        arenas[idx] = std::make_unique<Arena>(arena_block_size(end - begin));
+                        Parser parser(p_input.substr(begin, end - begin), options);
+                        parser.m_arena = arenas[idx].get();
+                        parser.parse_elements(elements[idx], ranges == 1); });
+                }
+                catch (const Exception &)
+                {
+                    // 异常类型与错误位置以单线程解析为准
+                    return serial();
+                }
+
+                size_t total = 0;
+                for (const auto &part : elements)
+                    total += part.size();
+                auto arena = std::make_unique<Arena>();
+                Array *root = Element::create_in<Array>(*arena, arena.get());
+                root->reserve(total);
+                for (const auto &part : elements)
+                    for (Element *element : part)
+                        root->append_raw_ptr(element);
+                for (auto &part_arena : arenas)
+                    arena->adopt(std::move(part_arena));
+                Document doc(root, std::move(p_source), std::move(arena));
+                doc.retain_keys(options.key_table);
+                return doc;
+            }
+
+            /**
+             * @brief 解析以逗号分隔的一串值（并行解析中顶层数组的一段），依次追加到 p_out。
+             * @param p_allow_empty 是否允许没有任何值（整个数组只有一段时即为空数组）。
+             */
+            void parse_elements(std::vector<Element *> &p_out, bool p_allow_empty)
+            {
+                if (p_allow_empty && peek().type == TokenType::End)
+                    return;
+                while (true)
+                {
+                    DomBuilder builder{*this};
+                    p_out.push_back(walk_value(builder));
+                    Token token = peek();
+                    if (token.type == TokenType::End)
+                        return;
+                    if (token.type != TokenType::Comma)
+                        throw error(token, "Expected ',' or ']' in array");
                     consume();
-                    return new Value(val);
                 }
-                case TokenType::Float:
+            }
+
+            /// @brief 在新的 Arena 上解析，并让文档持有 p_source 以保证输入缓冲区存活。
+            Document parse_into_document(std::shared_ptr<const void> p_source)
+            {
+                auto arena = std::make_unique<Arena>(arena_block_size(m_tokenizer.source().size()));
+                m_arena = arena.get();
+                Element *root = nullptr;
+                try
+                {
+                    root = run([this]()
+                               { return parse_value(); });
+                }
+                catch (...)
+                {
+                    m_arena = nullptr;
+                    throw;
+                }
+                m_arena = nullptr;
+                Document doc(root, std::move(p_source), std::move(arena));
+                if (m_keys != nullptr)
+                    doc.retain_keys(m_keys->table());
+                return doc;
+            }
+
+            /// @brief 创建一个节点：设置了 Arena 时分配在 Arena 上，否则分配在堆上。
+            template <typename T, typename... Args>
+            T *make(Args &&...args)
+            {
+                if (m_arena == nullptr)
+                    return new T(std::forward<Args>(args)...);
+                return Element::create_in<T>(*m_arena, std::forward<Args>(args)...);
+            }
+
+            /// @brief 构造一个位于 token 起始处的解析异常，行列号只在出错时才推算。
+            ParseException error(const Token &token, const std::string &msg) const { return error(token.value.data(), msg); }
+            /// @brief 构造一个位于输入中 p_pos 处的解析异常。
+            ParseException error(const char *p_pos, const std::string &msg) const
+            {
+                string_v_t source = m_tokenizer.source();
+                return ParseException(source, static_cast<size_t>(p_pos - source.data()), msg);
+            }
+
+            /// @brief 把字符串 Token 的内容解码到 p_out（至少预留 token.value.size() 字节），返回写入结束的位置。
+            char *unescape_to(const Token &token, char *p_out) const
+            {
+                const char *in = token.value.data();
+                if (!escape::unescape(in, in + token.value.size(), p_out, m_tokenizer.simd_level()))
+                    throw error(in, "Invalid unicode surrogate pair");
+                return p_out;
+            }
+
+            /**
+             * @brief 获取字符串 Token 解码后的内容。不含转义时直接返回输入中的视图；
+             *        含转义时解码到 Arena 上（解析为 Document 时是文档的 Arena，否则是 Parser 自己的）。
+             */
+            string_v_t decode(const Token &token)
+            {
+                if (!token.escaped)
+                    return token.value;
+                Arena *arena = m_arena;
+                if (arena == nullptr)
                 {
-                    try
+                    if (!m_decoded)
+                        m_decoded = std::make_unique<Arena>();
+                    arena = m_decoded.get();
+                }
+                char *out = static_cast<char *>(arena->allocate(token.value.size(), 1));
+                return string_v_t(out, unescape_to(token, out) - out);
+            }
+
+            /// @brief 获取对象键解码后的内容：设置了 key_table 时返回驻留表中的内容，否则同 decode()。
+            string_v_t decode_key(const Token &token)
+            {
+                if (m_keys == nullptr)
+                    return decode(token);
+                return m_keys->intern(decode_to_scratch(token)).view();
+            }
+
+            /// @brief 获取字符串 Token 解码后的内容，含转义时解码到临时缓冲区（下一次解码前有效）。
+            string_v_t decode_to_scratch(const Token &token)
+            {
+                if (!token.escaped)
+                    return token.value;
+                m_scratch.resize(token.value.size());
+                return string_v_t(m_scratch.data(), unescape_to(token, m_scratch.data()) - m_scratch.data());
+            }
+            /**
+             * @brief 把数字 Token 转换为能精确表示它的最窄类型，并以该类型调用 p_func：
+             *        整数依次尝试 int、int64_t、uint64_t（超出 64 位时退化为 double）；
+             *        小数在 float 能无损表示时（见 number::fits_float）用 float，否则用 double。
+             */
+            template <typename Func>
+            decltype(auto) visit_number(const Token &token, Func &&p_func) const
+            {
+                const char *begin = token.value.data();
+                const char *end = begin + token.value.size();
+                if (token.type == TokenType::Integer)
+                {
+                    int64_t val;
+                    // 使用 C++17 的 from_chars 高效转换
+                    auto [ptr, ec] = std::from_chars(begin, end, val);
+                    if (ec == std::errc() && ptr == end)
                     {
-                        // stof 需要一个有所有权的 string，所以创建一个临时对象
-                        std::string temp_str(token.value);
-                        float val = std::stof(temp_str);
-                        consume();
-                        return new Value(val);
+                        if (val >= (std::numeric_limits<int>::min)() && val <= (std::numeric_limits<int>::max)())
+                            return p_func(static_cast<int>(val));
+                        return p_func(val);
                     }
-                    catch (...)
+                    if (ec != std::errc::result_out_of_range)
+                        throw error(token, "Invalid integer: " + std::string(token.value));
+                    if (*begin != '-')
                     {
-                        throw Exception("Invalid float: " + std::string(token.value));
+                        uint64_t uval;
+                        auto [uptr, uec] = std::from_chars(begin, end, uval);
+                        if (uec == std::errc() && uptr == end)
+                            return p_func(uval);
                     }
                 }
+
+                double val;
+                if (!number::parse_floating(begin, end, val))
+                    throw error(token, "Invalid float: " + std::string(token.value));
+                if (token.type == TokenType::Float && number::fits_float(val))
+                    return p_func(static_cast<float>(val));
+                return p_func(val);
+            }
+
+            /// @brief 解析作为根的 JSON 值（可能是 object, array, string, number, bool, null），构建为 Element 树。
+            Element *parse_value()
+            {
+                DomBuilder builder{*this};
+                return walk_root(builder);
+            }
+
+            /// @brief 没有结果的构建器（SAX 与 Tape）使用的占位值。
+            struct Unit
+            {
+            };
+
+            /**
+             * @brief 构建 Element 树的构建器：节点按 make() 分配在 Arena 或堆上。
+             *        不含转义的字符串直接引用输入，含转义的才需要解码出一份新的内容。
+             */
+            struct DomBuilder
+            {
+                Parser &parser;
+
+                Element *null() { return parser.make<Value>(); }
+                Element *boolean(bool p_value) { return parser.make<Value>(p_value); }
+                template <typename Number>
+                Element *number(Number p_value) { return parser.make<Value>(p_value); }
+                Element *string(const Token &token)
+                {
+                    if (!token.escaped || parser.m_arena != nullptr)
+                        return parser.make<Value>(parser.decode(token));
+                    string_t decoded(token.value.size(), '\0');
+                    decoded.resize(parser.unescape_to(token, decoded.data()) - decoded.data());
+                    // 只有堆模式会走到这里：Arena 上的 Value 不能持有堆上的字符串
+                    return new Value(std::move(decoded));
+                }
+                string_v_t key(const Token &token) { return parser.decode_key(token); }
+
+                Object *begin_object() { return parser.make<Object>(parser.m_arena); }
+                void member(Object *obj, string_v_t key, Element *value) { obj->insert_raw_ptr(key, value); }
+                Element *end_object(Object *obj, size_t) { return obj; }
+
+                Array *begin_array() { return parser.make<Array>(parser.m_arena); }
+                void element(Array *arr, Element *value) { arr->append_raw_ptr(value); }
+                Element *end_array(Array *arr, size_t) { return arr; }
+            };
+
+            /// @brief 按先序把节点追加到 Tape 的构建器，字符串拷贝进 Tape 的字符串池。
+            struct TapeBuilder
+            {
+                Parser &parser;
+                Tape &tape;
+
+                Unit null() { return tape.append_literal(TapeType::Null), Unit{}; }
+                Unit boolean(bool p_value) { return tape.append_literal(p_value ? TapeType::True : TapeType::False), Unit{}; }
+                template <typename Number>
+                Unit number(Number p_value) { return tape.append_number(p_value), Unit{}; }
+                Unit string(const Token &token) { return tape.append_string(parser.decode_to_scratch(token)), Unit{}; }
+                Unit key(const Token &token) { return string(token); }
+
+                size_t begin_object() { return tape.begin_container(TapeType::ObjectBegin); }
+                void member(size_t, Unit, Unit) {}
+                Unit end_object(size_t p_begin, size_t p_count) { return tape.end_container(p_begin, p_count), Unit{}; }
+
+                size_t begin_array() { return tape.begin_container(TapeType::ArrayBegin); }
+                void element(size_t, Unit) {}
+                Unit end_array(size_t p_begin, size_t p_count) { return tape.end_container(p_begin, p_count), Unit{}; }
+            };
+
+            /// @brief 把事件转交给 SAX 处理器的构建器，字符串解码到临时缓冲区。
+            template <typename Handler>
+            struct SaxBuilder
+            {
+                Parser &parser;
+                Handler &handler;
+
+                Unit null() { return handler.on_null(), Unit{}; }
+                Unit boolean(bool p_value) { return handler.on_bool(p_value), Unit{}; }
+                template <typename Number>
+                Unit number(Number p_value)
+                {
+                    if constexpr (std::is_floating_point_v<Number>)
+                        handler.on_double(static_cast<double>(p_value));
+                    else if constexpr (std::is_unsigned_v<Number>)
+                        handler.on_uint(p_value);
+                    else
+                        handler.on_int(static_cast<int64_t>(p_value));
+                    return Unit{};
+                }
+                Unit string(const Token &token) { return handler.on_string(parser.decode_to_scratch(token)), Unit{}; }
+                Unit key(const Token &token) { return handler.on_key(parser.decode_to_scratch(token)), Unit{}; }
+
+                Unit begin_object() { return handler.on_start_object(), Unit{}; }
+                void member(Unit, Unit, Unit) {}
+                Unit end_object(Unit, size_t p_count) { return handler.on_end_object(p_count), Unit{}; }
+
+                Unit begin_array() { return handler.on_start_array(), Unit{}; }
+                void element(Unit, Unit) {}
+                Unit end_array(Unit, size_t p_count) { return handler.on_end_array(p_count), Unit{}; }
+            };
+
+            /// @brief 识别作为根的值：设置了键白名单且根为对象时，只解析白名单中的成员。
+            template <typename Builder>
+            auto walk_root(Builder &p_builder) -> decltype(p_builder.null())
+            {
+                if (!m_key_allowlist.empty() && peek().type == TokenType::ObjectBegin)
+                    return walk_object<Builder, true>(p_builder);
+                return walk_value(p_builder);
+            }
+
+            /// @brief 键是否在白名单中。
+            bool allowed(const Token &key_token)
+            {
+                const string_v_t key = decode_to_scratch(key_token);
+                return std::find(m_key_allowlist.begin(), m_key_allowlist.end(), key) != m_key_allowlist.end();
+            }
+
+            /// @brief 跳过当前 Token 开始的整个值，不交给构建器。
+            void skip_value()
+            {
+                if (m_pipeline == nullptr)
+                    return m_tokenizer.skip_value();
+
+                // 流水线中的 Token 已由后台线程读出，只能逐个丢弃，按括号计数找到值的结尾
+                const TokenType first = peek().type;
+                if (first != TokenType::ObjectBegin && first != TokenType::ArrayBegin)
+                {
+                    if (first != TokenType::String && first != TokenType::Integer && first != TokenType::Float &&
+                        first != TokenType::Bool && first != TokenType::Null)
+                        throw TypeException("Unexpected token type");
+                    return consume();
+                }
+                size_t depth = 0;
+                do
+                {
+                    const Token token = peek();
+                    if (token.type == TokenType::ObjectBegin || token.type == TokenType::ArrayBegin)
+                        ++depth;
+                    else if (token.type == TokenType::ObjectEnd || token.type == TokenType::ArrayEnd)
+                        --depth;
+                    else if (token.type == TokenType::End)
+                        throw error(token, first == TokenType::ObjectBegin ? "Expected ',' or '}' in object" : "Expected ',' or ']' in array");
+                    consume();
+                } while (depth > 0);
+            }
+
+            /**
+             * @brief 递归下降的核心分发函数：按 Token 流识别一个 JSON 值，把结果交给构建器 p_builder。
+             *        DOM、Tape 与 SAX 三种输出共用这一份语法分析，只是构建器不同。
+             *        构建器对标量返回值，对容器先 begin_*() 得到句柄，再逐个 member() / element()，最后 end_*()。
+             */
+            template <typename Builder>
+            auto walk_value(Builder &p_builder) -> decltype(p_builder.null())
+            {
+                Token token = peek();
+
+                switch (token.type)
+                {
+                case TokenType::ObjectBegin:
+                    return walk_object(p_builder);
+                case TokenType::ArrayBegin:
+                    return walk_array(p_builder);
+                case TokenType::Integer:
+                case TokenType::Float:
+                {
+                    auto val = visit_number(token, [&p_builder](auto number)
+                                            { return p_builder.number(number); });
+                    consume();
+                    return val;
+                }
                 case TokenType::Bool:
                 {
-                    bool val = token.value[0] == 't';
+                    auto val = p_builder.boolean(token.value[0] == 't');
                     consume();
-                    return new Value(val);
+                    return val;
                 }
                 case TokenType::String:
                 {
-                    auto val = token.value;
-                    // string_t copied_str(token.value);
+                    auto val = p_builder.string(token);
                     consume();
-                    return new Value(val);
-                    // return new Value(std::move(copied_str));
+                    return val;
                 }
                 case TokenType::Null:
+                {
+                    auto val = p_builder.null();
                     consume();
-                    return new Value();
+                    return val;
+                }
                 default:
                     throw TypeException("Unexpected token type");
                 }
             }
 
-            /// @brief 解析一个 JSON 对象。
-            Object *parse_object()
+            /// @brief 识别一个 JSON 对象。@tparam Filtered 是否按键白名单过滤成员（只用于根对象）。
+            template <typename Builder, bool Filtered = false>
+            auto walk_object(Builder &p_builder) -> decltype(p_builder.null())
             {
                 // 1. 消费 '{'
                 consume();
 
-                Object *obj = new Object();
+                auto obj = p_builder.begin_object();
+                size_t count = 0;
 
                 // 2. 处理空对象 {} 的情况
                 if (peek().type == TokenType::ObjectEnd)
                 {
                     consume();
-                    return obj;
+                    return p_builder.end_object(obj, count);
                 }
 
                 // 3. 循环解析键值对
@@ -186,17 +673,27 @@ namespace pjh_std
                     // 3.1 解析键（必须是字符串）
                     Token key_token = peek();
                     if (key_token.type != TokenType::String)
-                        throw Exception("Expected string key in object!");
-                    auto key = key_token.value;
+                        throw error(key_token, "Expected string key in object!");
+                    // 不在白名单中的成员既不交给构建器，也不解析它的值
+                    const bool skipped = Filtered && !allowed(key_token);
+                    decltype(p_builder.key(key_token)) key{};
+                    if (!skipped)
+                        key = p_builder.key(key_token);
                     consume();
 
                     // 3.2 消费 ':'
                     if (peek().type != TokenType::Colon)
-                        throw Exception("Expected colon after key!");
+                        throw error(peek(), "Expected colon after key!");
                     consume();
 
                     // 3.3 递归解析值，并插入到对象中
-                    obj->insert_raw_ptr(key, parse_value());
+                    if (skipped)
+                        skip_value();
+                    else
+                    {
+                        p_builder.member(obj, key, walk_value(p_builder));
+                        ++count;
+                    }
 
                     // 3.4 查看下一个 token 是 '}' 还是 ','
                     Token next_token = peek();
@@ -208,31 +705,34 @@ namespace pjh_std
                     else if (next_token.type == TokenType::Comma)
                         consume(); // 消费 ','，继续循环
                     else
-                        throw Exception("Expected ',' or '}' in object");
+                        throw error(next_token, "Expected ',' or '}' in object");
                 }
 
-                return obj;
+                return p_builder.end_object(obj, count);
             }
 
-            /// @brief 解析一个 JSON 数组。
-            Array *parse_array()
+            /// @brief 识别一个 JSON 数组。
+            template <typename Builder>
+            auto walk_array(Builder &p_builder) -> decltype(p_builder.null())
             {
                 // 1. 消费 '['
                 consume();
-                Array *arr = new Array();
+                auto arr = p_builder.begin_array();
+                size_t count = 0;
 
                 // 2. 处理空数组 [] 的情况
                 if (peek().type == TokenType::ArrayEnd)
                 {
                     consume();
-                    return arr;
+                    return p_builder.end_array(arr, count);
                 }
 
                 // 3. 循环解析数组成员
                 while (true)
                 {
                     // 3.1 递归解析数组成员的值
-                    arr->append_raw_ptr(parse_value());
+                    p_builder.element(arr, walk_value(p_builder));
+                    ++count;
 
                     // 3.2 查看下一个 token 是 ']' 还是 ','
                     Token next_token = peek();
@@ -244,10 +744,10 @@ namespace pjh_std
                     else if (next_token.type == TokenType::Comma)
                         consume(); // 消费 ','，继续循环
                     else
-                        throw Exception("Expected ',' or ']' in array");
+                        throw error(next_token, "Expected ',' or ']' in array");
                 }
 
-                return arr;
+                return p_builder.end_array(arr, count);
             }
         };
     }
@@ -0,0 +1,572 @@
+#ifndef INCLUDE_JSON_PUSH_PARSER
+#define INCLUDE_JSON_PUSH_PARSER
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <pjh_json/helpers/json_definition.hpp>
+#include <pjh_json/helpers/json_exception.hpp>
+
+#include <pjh_json/parsers/json_options.hpp>
+#include <pjh_json/parsers/json_sax.hpp>
+#include <pjh_json/parsers/json_tokenizer.hpp>
+
+#include <pjh_json/utils/escape.hpp>
+#include <pjh_json/utils/number.hpp>
+#include <pjh_json/utils/simd.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class PushParser
+         * @brief 增量（推送式）解析器：输入按块陆续到达，每块通过 feed() 交给解析器，全部送完后调用 finish()。
+         *        每块中完整的 Token 立即转为 SAX 事件交给处理器（见 SaxHandler），因此解析可以与接收重叠进行；
+         *        需要 DOM 时把 DocumentBuilder 作为处理器即可。
+         *
+         * - 语法状态保存在显式的栈中而不是递归调用里，因此可以在任意字节处暂停与继续；
+         * - Token 直接在调用方的块上识别，只有被块边界截断的那个 Token 会拷贝到内部缓冲区，
+         *   下一块到达后补齐再处理；很长的字符串跨越多块时，已扫描过的部分不会重复扫描；
+         * - 事件与错误信息和 Parser::parse_sax 一致，出错位置（行、列、字节偏移）按整个输入流计算；
+         * - 顶层值结束之后只允许出现空白。ParseOptions 中只有 simd_level 生效。
+         * 出错后解析器的状态不再可用，需要 reset() 之后才能解析新的输入；处理器自己保存的状态
+         * （例如 DocumentBuilder 中构建了一半的文档）不受影响，需要由调用方一并重置。
+         */
+        template <typename Handler>
+        class PushParser
+        {
+        private:
+            /// @brief 下一个 Token 应当是什么。
+            enum class Expect : uint8_t
+            {
+                Value,           // 任意值（顶层、冒号之后、数组中的逗号之后）
+                ValueOrArrayEnd, // '[' 之后
+                KeyOrObjectEnd,  // '{' 之后
+                Key,             // 对象中的逗号之后
+                Colon,           // 键之后
+                CommaOrEnd,      // 容器中的一个值之后
+                Done             // 顶层值已经结束
+            };
+
+            /// @brief 一次词法分析的结果。
+            enum class Lex : uint8_t
+            {
+                Token,    // 识别出一个完整的 Token
+                NeedMore, // Token 被缓冲区末尾截断
+                Empty     // 剩余部分只有空白
+            };
+
+            /// @brief 一个尚未结束的容器。
+            struct Frame
+            {
+                bool object;  // 是否为对象
+                size_t count; // 已结束的成员（键值对）个数
+            };
+
+            Handler &m_handler;         // 事件处理器
+            simd::Level m_level;        // 向量化扫描使用的指令集级别
+            Expect m_expect;            // 语法状态
+            std::vector<Frame> m_stack; // 尚未结束的容器
+
+            string_t m_partial;      // 被块边界截断的 Token
+            size_t m_partial_offset; // m_partial[0] 在输入流中的偏移
+            size_t m_resume;         // 截断的字符串已扫描到的位置（相对于 m_partial 开头）
+            bool m_resume_escaped;   // 截断的字符串在已扫描的部分中是否含有转义
+            string_t m_scratch;      // 解码含转义的字符串用的临时缓冲区
+
+            size_t m_offset;     // 已经送入的字节总数
+            size_t m_line;       // 已计入行号的字节之后所在的行（从 1 开始）
+            size_t m_line_start; // 该行的起点在输入流中的偏移
+
+            const char *m_base;   // 正在分析的缓冲区（当前块或 m_partial），用于换算出错位置
+            size_t m_base_offset; // m_base 在输入流中的偏移
+
+        public:
+            /// @brief 构造函数。@param p_handler 事件处理器，必须比解析器活得更久。@param p_options 解析选项。
+            explicit PushParser(Handler &p_handler, const ParseOptions &p_options = ParseOptions())
+                : m_handler(p_handler), m_level((std::min)(p_options.simd_level, simd::detect_level()))
+            {
+                reset();
+            }
+
+            PushParser(const PushParser &) = delete;
+            PushParser &operator=(const PushParser &) = delete;
+
+        public:
+            /**
+             * @brief 送入下一块输入，块中完整的 Token 立即产生事件。函数返回后调用方可以复用或释放这块内存。
+             * @param p_data 块的起始地址。
+             * @param p_size 块的长度，可以为 0。
+             */
+            void feed(const char *p_data, size_t p_size)
+            {
+                const char *end = p_data + p_size;
+                const size_t chunk_offset = m_offset;
+                const char *pos = p_data;
+                if (!m_partial.empty())
+                {
+                    pos = complete_partial(p_data, end);
+                    if (pos == nullptr)
+                    {
+                        m_offset += p_size;
+                        return;
+                    }
+                }
+
+                m_base = p_data;
+                m_base_offset = chunk_offset;
+                const char *consumed = end;
+                Token token;
+                const char *next = nullptr;
+                while (true)
+                {
+                    const Lex result = lex(pos, end, false, 0, token, next);
+                    if (result == Lex::Empty)
+                        break;
+                    if (result == Lex::NeedMore)
+                    {
+                        // 只拷贝被截断的 Token，下一块到达后补齐
+                        m_partial.assign(next, end);
+                        m_partial_offset = chunk_offset + static_cast<size_t>(next - p_data);
+                        consumed = next;
+                        break;
+                    }
+                    dispatch(token);
+                    pos = next;
+                }
+                advance_lines(p_data, consumed, chunk_offset);
+                m_offset += p_size;
+            }
+            /// @brief 送入下一块输入。
+            void feed(string_v_t p_chunk) { feed(p_chunk.data(), p_chunk.size()); }
+
+            /**
+             * @brief 输入结束：处理末尾被截断的 Token（例如结尾的数字），并检查顶层值是否完整。
+             *        不完整时抛出与 Parser 在同一位置遇到输入结尾时相同的异常。
+             */
+            void finish()
+            {
+                if (!m_partial.empty())
+                {
+                    m_base = m_partial.data();
+                    m_base_offset = m_partial_offset;
+                    Token token;
+                    const char *next = nullptr;
+                    lex(m_partial.data(), m_partial.data() + m_partial.size(), true, m_resume, token, next);
+                    dispatch(token);
+                    advance_lines(m_partial.data(), m_partial.data() + m_partial.size(), m_partial_offset);
+                    m_partial.clear();
+                }
+                m_base = nullptr;
+                m_base_offset = m_offset;
+                dispatch(Token{TokenType::End, string_v_t()});
+            }
+
+            /// @brief 回到初始状态，以便解析新的输入。处理器不变，也不会被重置（DocumentBuilder 需另外调用其 reset()）。
+            void reset()
+            {
+                m_expect = Expect::Value;
+                m_stack.clear();
+                m_partial.clear();
+                m_partial_offset = 0;
+                m_resume = 0;
+                m_resume_escaped = false;
+                m_offset = 0;
+                m_line = 1;
+                m_line_start = 0;
+                m_base = nullptr;
+                m_base_offset = 0;
+            }
+
+            /// @brief 顶层值是否已经完整地产生了全部事件。
+            bool done() const noexcept { return m_expect == Expect::Done; }
+            /// @brief 当前尚未结束的容器层数。
+            size_t depth() const noexcept { return m_stack.size(); }
+            /// @brief 已经送入的字节总数。
+            size_t offset() const noexcept { return m_offset; }
+
+        private:
+            /**
+             * @brief 用新块的开头补齐被截断的 Token。为了只拷贝这个 Token 需要的部分，
+             *        每次从新块中多取一倍的字节，直到 Token 完整或新块用完。
+             * @return 补齐后新块中剩余部分的起点；新块用完仍未补齐时返回 nullptr。
+             */
+            const char *complete_partial(const char *p_data, const char *p_end)
+            {
+                const size_t old_size = m_partial.size();
+                const char *src = p_data;
+                size_t step = 64;
+                while (true)
+                {
+                    const size_t take = (std::min)(step, static_cast<size_t>(p_end - src));
+                    m_partial.append(src, take);
+                    src += take;
+                    step *= 2;
+
+                    m_base = m_partial.data();
+                    m_base_offset = m_partial_offset;
+                    Token token;
+                    const char *next = nullptr;
+                    if (lex(m_partial.data(), m_partial.data() + m_partial.size(), false, m_resume, token, next) == Lex::Token)
+                    {
+                        const size_t used = static_cast<size_t>(next - m_partial.data());
+                        dispatch(token);
+                        // 之前各块中的这部分字节直到现在才计入行号
+                        advance_lines(m_partial.data(), m_partial.data() + old_size, m_partial_offset);
+                        m_partial.clear();
+                        m_resume = 0;
+                        m_resume_escaped = false;
+                        return p_data + (used - old_size);
+                    }
+                    if (src == p_end)
+                        return nullptr;
+                }
+            }
+
+            /**
+             * @brief 从 p_begin 开始跳过空白并识别一个 Token，规则与 Tokenizer 相同。
+             * @param p_final 输入是否到此为止：为 true 时被截断的 Token 按 Tokenizer 的方式报错，而不是返回 NeedMore。
+             * @param p_resume 字符串从开头起已经扫描过的字节数（0 表示从头扫描）。
+             * @param p_next 返回 Token 时为 Token 之后的位置；返回 NeedMore 时为被截断 Token 的起点。
+             */
+            Lex lex(const char *p_begin, const char *p_end, bool p_final, size_t p_resume, Token &p_token, const char *&p_next)
+            {
+                const char *pos = p_begin;
+                if (pos != p_end && simd::char_classes.table[static_cast<uint8_t>(*pos)] == simd::ClassWhitespace)
+                    pos = simd::skip_whitespace(m_level, pos + 1, p_end);
+                if (pos == p_end)
+                {
+                    p_next = p_end;
+                    return Lex::Empty;
+                }
+                p_next = pos;
+
+                switch (*pos)
+                {
+                case '{':
+                    return single(TokenType::ObjectBegin, pos, p_token, p_next);
+                case '}':
+                    return single(TokenType::ObjectEnd, pos, p_token, p_next);
+                case '[':
+                    return single(TokenType::ArrayBegin, pos, p_token, p_next);
+                case ']':
+                    return single(TokenType::ArrayEnd, pos, p_token, p_next);
+                case ':':
+                    return single(TokenType::Colon, pos, p_token, p_next);
+                case ',':
+                    return single(TokenType::Comma, pos, p_token, p_next);
+                case '"':
+                    return lex_string(pos, p_end, p_final, p_resume, p_token, p_next);
+                case 't':
+                case 'f':
+                    return lex_literal(TokenType::Bool, *pos == 't' ? "true" : "false", "Invalid boolean literal", pos, p_end, p_final, p_token, p_next);
+                case 'n':
+                    return lex_literal(TokenType::Null, "null", "Invalid null literal", pos, p_end, p_final, p_token, p_next);
+                default:
+                    if (static_cast<unsigned char>(*pos - '0') < 10 || *pos == '-')
+                        return lex_number(pos, p_end, p_final, p_token, p_next);
+                    throw error(pos, (std::string) "Unexpected character '" + std::string(1, *pos) + "'");
+                }
+            }
+
+            /// @brief 单字符的结构 Token。
+            static Lex single(TokenType p_type, const char *p_pos, Token &p_token, const char *&p_next)
+            {
+                p_token = {p_type, string_v_t(p_pos, 1)};
+                p_next = p_pos + 1;
+                return Lex::Token;
+            }
+
+            /// @brief 识别字符串 Token，从 p_resume 处继续扫描并校验转义序列。
+            Lex lex_string(const char *p_pos, const char *p_end, bool p_final, size_t p_resume, Token &p_token, const char *&p_next)
+            {
+                const char *cur = p_pos + (std::max)(p_resume, size_t(1));
+                bool escaped = p_resume > 1 && m_resume_escaped;
+                while (true)
+                {
+                    cur = simd::find_quote_or_backslash(m_level, cur, p_end);
+                    if (cur == p_end)
+                        break;
+                    if (*cur == '"')
+                    {
+                        p_token = {TokenType::String, string_v_t(p_pos + 1, static_cast<size_t>(cur - p_pos - 1)), escaped};
+                        p_next = cur + 1;
+                        return Lex::Token;
+                    }
+                    // 转义序列被截断时，下次从反斜杠处重新校验
+                    if (p_end - cur < 2 || (cur[1] == 'u' && p_end - cur < 6 && !p_final))
+                    {
+                        if (p_final)
+                            throw error(p_end, "Unterminated string literal");
+                        break;
+                    }
+                    if (cur[1] == 'u')
+                    {
+                        uint32_t code;
+                        if (!escape::read_hex4(cur + 2, p_end, code))
+                            throw error(cur, "Invalid unicode escape sequence");
+                        cur += 6;
+                    }
+                    else if (escape::simple_unescape(cur[1]) != 0)
+                        cur += 2;
+                    else
+                        throw error(cur, (std::string) "Invalid escape character '" + std::string(1, cur[1]) + "'");
+                    escaped = true;
+                }
+                if (p_final)
+                    throw error(p_end, "Unterminated string literal");
+                m_resume = static_cast<size_t>(cur - p_pos);
+                m_resume_escaped = escaped;
+                return Lex::NeedMore;
+            }
+
+            /// @brief 识别 true / false / null。
+            Lex lex_literal(TokenType p_type, string_v_t p_word, const char *p_message,
+                            const char *p_pos, const char *p_end, bool p_final, Token &p_token, const char *&p_next)
+            {
+                const size_t available = static_cast<size_t>(p_end - p_pos);
+                if (available >= p_word.size())
+                {
+                    if (string_v_t(p_pos, p_word.size()) != p_word)
+                        throw error(p_pos, p_message);
+                    p_token = {p_type, string_v_t(p_pos, p_word.size())};
+                    p_next = p_pos + p_word.size();
+                    return Lex::Token;
+                }
+                if (p_final || string_v_t(p_pos, available) != p_word.substr(0, available))
+                    throw error(p_pos, p_message);
+                return Lex::NeedMore;
+            }
+
+            /// @brief 识别数字 Token。数字一直延伸到缓冲区末尾时，后面可能还有数字，因此需要下一块。
+            Lex lex_number(const char *p_pos, const char *p_end, bool p_final, Token &p_token, const char *&p_next)
+            {
+                const char *cur = p_pos;
+                bool is_float = false;
+                auto skip_digits = [&]()
+                {
+                    const char *start = cur;
+                    while (cur != p_end && static_cast<unsigned char>(*cur - '0') < 10)
+                        ++cur;
+                    return cur != start;
+                };
+
+                if (*cur == '-')
+                    ++cur;
+                bool digits = skip_digits();
+                if (cur == p_end && !p_final)
+                    return Lex::NeedMore;
+                if (!digits)
+                    throw error(cur, "Invalid number: expected digit");
+
+                if (*cur == '.')
+                {
+                    is_float = true;
+                    ++cur;
+                    digits = skip_digits();
+                    if (cur == p_end && !p_final)
+                        return Lex::NeedMore;
+                    if (!digits)
+                        throw error(cur, "Invalid number: expected digit after '.'");
+                }
+
+                if (cur != p_end && (*cur == 'e' || *cur == 'E'))
+                {
+                    is_float = true;
+                    ++cur;
+                    if (cur != p_end && (*cur == '+' || *cur == '-'))
+                        ++cur;
+                    digits = skip_digits();
+                    if (cur == p_end && !p_final)
+                        return Lex::NeedMore;
+                    if (!digits)
+                        throw error(cur, "Invalid number: expected digit in exponent");
+                }
+
+                p_token = {is_float ? TokenType::Float : TokenType::Integer, string_v_t(p_pos, static_cast<size_t>(cur - p_pos))};
+                p_next = cur;
+                return Lex::Token;
+            }
+
+            /// @brief 按语法状态处理一个 Token，错误信息与 Parser 相同。
+            void dispatch(const Token &p_token)
+            {
+                switch (m_expect)
+                {
+                case Expect::ValueOrArrayEnd:
+                    if (p_token.type == TokenType::ArrayEnd)
+                        return close();
+                    [[fallthrough]];
+                case Expect::Value:
+                    return value(p_token);
+                case Expect::KeyOrObjectEnd:
+                    if (p_token.type == TokenType::ObjectEnd)
+                        return close();
+                    [[fallthrough]];
+                case Expect::Key:
+                    if (p_token.type != TokenType::String)
+                        throw error(p_token.value.data(), "Expected string key in object!");
+                    m_handler.on_key(decode(p_token));
+                    m_expect = Expect::Colon;
+                    return;
+                case Expect::Colon:
+                    if (p_token.type != TokenType::Colon)
+                        throw error(p_token.value.data(), "Expected colon after key!");
+                    m_expect = Expect::Value;
+                    return;
+                case Expect::CommaOrEnd:
+                    if (m_stack.back().object)
+                    {
+                        if (p_token.type == TokenType::ObjectEnd)
+                            return close();
+                        if (p_token.type != TokenType::Comma)
+                            throw error(p_token.value.data(), "Expected ',' or '}' in object");
+                        m_expect = Expect::Key;
+                    }
+                    else
+                    {
+                        if (p_token.type == TokenType::ArrayEnd)
+                            return close();
+                        if (p_token.type != TokenType::Comma)
+                            throw error(p_token.value.data(), "Expected ',' or ']' in array");
+                        m_expect = Expect::Value;
+                    }
+                    return;
+                case Expect::Done:
+                    if (p_token.type != TokenType::End)
+                        throw error(p_token.value.data(), "Unexpected content after the JSON value");
+                    return;
+                }
+            }
+
+            /// @brief 处理一个值的第一个 Token：标量直接产生事件，容器入栈。
+            void value(const Token &p_token)
+            {
+                switch (p_token.type)
+                {
+                case TokenType::ObjectBegin:
+                    m_handler.on_start_object();
+                    m_stack.push_back({true, 0});
+                    m_expect = Expect::KeyOrObjectEnd;
+                    return;
+                case TokenType::ArrayBegin:
+                    m_handler.on_start_array();
+                    m_stack.push_back({false, 0});
+                    m_expect = Expect::ValueOrArrayEnd;
+                    return;
+                case TokenType::Integer:
+                case TokenType::Float:
+                    number(p_token);
+                    break;
+                case TokenType::Bool:
+                    m_handler.on_bool(p_token.value[0] == 't');
+                    break;
+                case TokenType::String:
+                    m_handler.on_string(decode(p_token));
+                    break;
+                case TokenType::Null:
+                    m_handler.on_null();
+                    break;
+                default:
+                    throw TypeException("Unexpected token type");
+                }
+                end_value();
+            }
+
+            /// @brief 结束栈顶的容器。
+            void close()
+            {
+                const Frame frame = m_stack.back();
+                m_stack.pop_back();
+                if (frame.object)
+                    m_handler.on_end_object(frame.count);
+                else
+                    m_handler.on_end_array(frame.count);
+                end_value();
+            }
+
+            /// @brief 一个值结束之后：计入所在容器，或者顶层值结束。
+            void end_value()
+            {
+                if (m_stack.empty())
+                {
+                    m_expect = Expect::Done;
+                    return;
+                }
+                ++m_stack.back().count;
+                m_expect = Expect::CommaOrEnd;
+            }
+
+            /// @brief 转换数字 Token，与 Parser 一样依次尝试 int64_t、uint64_t 与 double。
+            void number(const Token &p_token)
+            {
+                const char *begin = p_token.value.data();
+                const char *end = begin + p_token.value.size();
+                if (p_token.type == TokenType::Integer)
+                {
+                    int64_t val;
+                    auto [ptr, ec] = std::from_chars(begin, end, val);
+                    if (ec == std::errc() && ptr == end)
+                        return m_handler.on_int(val);
+                    if (ec != std::errc::result_out_of_range)
+                        throw error(begin, "Invalid integer: " + std::string(p_token.value));
+                    if (*begin != '-')
+                    {
+                        uint64_t uval;
+                        auto [uptr, uec] = std::from_chars(begin, end, uval);
+                        if (uec == std::errc() && uptr == end)
+                            return m_handler.on_uint(uval);
+                    }
+                }
+                double val;
+                if (!number::parse_floating(begin, end, val))
+                    throw error(begin, "Invalid float: " + std::string(p_token.value));
+                m_handler.on_double(val);
+            }
+
+            /// @brief 获取字符串 Token 解码后的内容，含转义时解码到临时缓冲区。
+            string_v_t decode(const Token &p_token)
+            {
+                if (!p_token.escaped)
+                    return p_token.value;
+                m_scratch.resize(p_token.value.size());
+                const char *in = p_token.value.data();
+                char *out = m_scratch.data();
+                if (!escape::unescape(in, in + p_token.value.size(), out, m_level))
+                    throw error(in, "Invalid unicode surrogate pair");
+                return string_v_t(m_scratch.data(), static_cast<size_t>(out - m_scratch.data()));
+            }
+
+            /// @brief 把 [p_begin, p_end) 中的换行计入行号，p_offset 为 p_begin 在输入流中的偏移。
+            void advance_lines(const char *p_begin, const char *p_end, size_t p_offset)
+            {
+                const size_t lines = simd::count_char(m_level, p_begin, p_end, '\n');
+                if (lines == 0)
+                    return;
+                m_line += lines;
+                const char *line_start = p_end;
+                while (line_start[-1] != '\n')
+                    --line_start;
+                m_line_start = p_offset + static_cast<size_t>(line_start - p_begin);
+            }
+
+            /// @brief 构造一个位于当前缓冲区 p_pos 处的解析异常，行列号按整个输入流计算。
+            ParseException error(const char *p_pos, const std::string &p_message) const
+            {
+                const size_t offset = m_base_offset + static_cast<size_t>(p_pos - m_base);
+                const size_t line = m_line + simd::count_char(m_level, m_base, p_pos, '\n');
+                const char *line_start = p_pos;
+                while (line_start > m_base && line_start[-1] != '\n')
+                    --line_start;
+                const size_t column = line_start > m_base ? static_cast<size_t>(p_pos - line_start) + 1 : offset - m_line_start + 1;
+                return ParseException(line, column, offset, p_message);
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_PUSH_PARSER
@@ -0,0 +1,41 @@
+#ifndef INCLUDE_JSON_SAX
+#define INCLUDE_JSON_SAX
+
+#include <cstdint>
+
+#include <pjh_json/helpers/json_definition.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class SaxHandler
+         * @brief Parser::parse_sax 的事件处理器基类，所有回调默认什么也不做。
+         *
+         * 派生类只需定义关心的回调（同名函数会隐藏基类的版本），Parser 按处理器的静态类型直接调用，
+         * 不经过虚函数，也不构建任何节点。回调按文档顺序触发：
+         * - 对象：on_start_object()，每个成员依次为 on_key() 与成员值的事件，最后 on_end_object(成员数)；
+         * - 数组：on_start_array()，各元素的事件，最后 on_end_array(元素数)；
+         * - 数字：能用 int64_t 表示的整数调用 on_int，只能用 uint64_t 表示的调用 on_uint，其余调用 on_double。
+         * 传给 on_key / on_string 的视图已经解码了转义序列，只在本次回调期间有效：
+         * 不含转义时指向输入，含转义时指向 Parser 内部反复使用的缓冲区。
+         */
+        struct SaxHandler
+        {
+            void on_null() {}
+            void on_bool(bool) {}
+            void on_int(int64_t) {}
+            void on_uint(uint64_t) {}
+            void on_double(double) {}
+            void on_string(string_v_t) {}
+            void on_key(string_v_t) {}
+            void on_start_object() {}
+            void on_end_object(size_t) {}
+            void on_start_array() {}
+            void on_end_array(size_t) {}
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_SAX
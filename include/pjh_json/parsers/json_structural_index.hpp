@@ -0,0 +1,254 @@
+#ifndef INCLUDE_JSON_STRUCTURAL_INDEX
+#define INCLUDE_JSON_STRUCTURAL_INDEX
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <pjh_json/helpers/json_definition.hpp>
+
+#include <pjh_json/utils/object_pool.hpp>
+#include <pjh_json/utils/simd.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class StructuralIndex
+         * @brief 结构字符索引（simdjson 风格的第一阶段）。
+         *        以 64 字节为一块向量化地扫描整个输入，记录所有“需要 Tokenizer 停下来”的位置：
+         *        - 字符串外的结构字符 `{}[]:,`；
+         *        - 所有未被转义的引号（字符串的开头与结尾）；
+         *        - 字符串外每个标量（数字 / true / false / null）的第一个字节。
+         *        之后 Tokenizer 只需按顺序跳到这些位置，无需逐字节跳过空白和字符串内容。
+         */
+        class StructuralIndex
+        {
+        public:
+            /// @brief 位置数组类型。扩容时不清零，写入由 flatten 负责。
+            using positions_t = std::vector<uint32_t, DefaultInitAllocator<uint32_t>>;
+
+        private:
+            positions_t m_positions;        // 按升序排列的结构位置
+            bool m_unclosed_string = false; // 输入结束时是否仍处于字符串内部
+            size_t m_utf8_error = npos;     // 第一个非法 UTF-8 序列的偏移（未校验或全部合法时为 npos）
+
+        public:
+            /// @brief 单个索引能够覆盖的最大输入长度（位置以 32 位存储）。
+            static constexpr size_t max_input_size = std::numeric_limits<uint32_t>::max();
+            /// @brief 表示“没有错误”的偏移量。
+            static constexpr size_t npos = static_cast<size_t>(-1);
+            /// @brief 与建立索引交替进行的 UTF-8 校验每次覆盖的字节数，保证被校验的数据仍在缓存中。
+            static constexpr size_t utf8_chunk_size = 16 * 1024;
+
+            StructuralIndex() = default;
+            /// @brief 构造并立即建立索引。@param p_input 输入文本。@param p_level 使用的指令集级别。
+            explicit StructuralIndex(string_v_t p_input, simd::Level p_level = simd::detect_level()) { build(p_input, p_level); }
+
+        public:
+            /// @brief 结构位置的数量。
+            size_t size() const noexcept { return m_positions.size(); }
+            /// @brief 检查索引是否为空。
+            bool empty() const noexcept { return m_positions.empty(); }
+            /// @brief 获取第 idx 个结构位置。
+            uint32_t operator[](size_t idx) const noexcept { return m_positions[idx]; }
+            /// @brief 获取所有结构位置。
+            const positions_t &positions() const noexcept { return m_positions; }
+            /// @brief 输入中是否存在未闭合的字符串。
+            bool unclosed_string() const noexcept { return m_unclosed_string; }
+            /// @brief 第一个非法 UTF-8 序列的字节偏移，没有开启校验或输入合法时为 npos。
+            size_t utf8_error() const noexcept { return m_utf8_error; }
+
+        public:
+            /**
+             * @brief 为输入建立结构索引。
+             * @param p_input 输入文本，长度不能超过 max_input_size。
+             * @param p_level 期望使用的指令集级别，超过 CPU 实际支持的级别时会自动降级。
+             * @param p_validate_utf8 是否同时校验 UTF-8。校验按 utf8_chunk_size 分段，与分类交替进行，
+             *        每段数据只需从内存读入缓存一次；结果通过 utf8_error() 获取。
+             *        发现非法序列后立即停止，此时索引只覆盖错误之前的部分。
+             */
+            void build(string_v_t p_input, simd::Level p_level = simd::detect_level(), bool p_validate_utf8 = false)
+            {
+                if (p_level > simd::detect_level())
+                    p_level = simd::detect_level();
+
+                m_positions.clear();
+                m_positions.resize(p_input.size() / 8 + 64);
+                size_t count = 0;
+
+                uint64_t prev_escaped = 0;   // 上一块末尾的反斜杠是否转义了本块第一个字符（0 或 1）
+                uint64_t prev_in_string = 0; // 上一块结束时是否处于字符串内部（全 0 或全 1）
+                uint64_t prev_scalar = 0;    // 上一块最后一个字节是否属于标量（0 或 1）
+
+                const char *data = p_input.data();
+                const size_t size = p_input.size();
+                size_t offset = 0;
+                simd::BlockMasks masks;
+                m_utf8_error = npos;
+                size_t validated = 0; // UTF-8 校验已经覆盖到的位置
+
+                while (offset < size)
+                {
+                    if (p_validate_utf8 && offset + 64 > validated)
+                    {
+                        validate_utf8_chunk(p_level, data, size, validated, p_validate_utf8);
+                        // 输入非法时解析必然失败，不必再为剩余部分建立索引
+                        if (m_utf8_error != npos)
+                            break;
+                    }
+
+                    // 最后一块不足 64 字节时，拷贝到以空格填充的缓冲区中
+                    char tail[64];
+                    const char *block = data + offset;
+                    if (size - offset < 64)
+                    {
+                        std::memset(tail, ' ', sizeof(tail));
+                        std::memcpy(tail, block, size - offset);
+                        block = tail;
+                    }
+                    simd::classify_block(p_level, block, masks);
+
+                    // 1. 找出被转义的字符，并剔除被转义的引号
+                    const uint64_t escaped = find_escaped(masks.backslash, prev_escaped);
+                    const uint64_t quote = masks.quote & ~escaped;
+
+                    // 2. 由引号位置计算字符串内部掩码（包含开引号，不包含闭引号）
+                    const uint64_t in_string = simd::prefix_xor(quote) ^ prev_in_string;
+                    prev_in_string = uint64_t(static_cast<int64_t>(in_string) >> 63);
+
+                    // 3. 字符串外的结构字符，以及每段标量的起始字节
+                    const uint64_t op = masks.op & ~in_string;
+                    const uint64_t scalar = ~(masks.op | masks.whitespace | quote | in_string);
+                    const uint64_t scalar_start = scalar & ~((scalar << 1) | prev_scalar);
+                    prev_scalar = scalar >> 63;
+
+                    flatten(op | quote | scalar_start, offset, count);
+                    offset += 64;
+                }
+
+                // 填充区域全是空格，不会产生越过末尾的结构位置
+                m_positions.resize(count);
+                m_unclosed_string = prev_in_string != 0;
+            }
+
+        private:
+            /**
+             * @brief 校验从 p_validated 开始的下一段输入，并把 p_validated 推进到该段末尾。
+             *        段的末尾退回到字符边界，使多字节序列不会被拆到两段中；发现错误后记录偏移并停止校验。
+             */
+            void validate_utf8_chunk(simd::Level p_level, const char *p_data, size_t p_size, size_t &p_validated, bool &p_validate)
+            {
+                size_t chunk_end = (std::min)(p_validated + utf8_chunk_size, p_size);
+                for (int step = 0; step < 3 && chunk_end < p_size && chunk_end > p_validated &&
+                                   (static_cast<uint8_t>(p_data[chunk_end]) & 0xC0) == 0x80;
+                     ++step)
+                    --chunk_end;
+                const char *bad = simd::find_utf8_error(p_level, p_data + p_validated, p_data + chunk_end);
+                if (bad != p_data + chunk_end)
+                {
+                    m_utf8_error = static_cast<size_t>(bad - p_data);
+                    p_validate = false;
+                }
+                p_validated = chunk_end;
+            }
+
+        public:
+            /**
+             * @brief 计算被反斜杠转义的字符掩码（无分支版本）。
+             *        连续的反斜杠两两抵消，只有奇数长度的反斜杠序列才会转义其后的字符。
+             *        通过把“从奇数位开始的序列”加到反斜杠掩码上，借助进位快速区分序列的奇偶。
+             */
+            static uint64_t find_escaped(uint64_t p_backslash, uint64_t &p_prev_escaped) noexcept
+            {
+                // 若本块第一个字符已被上一块转义，那它即使是反斜杠也不再作为转义符
+                p_backslash &= ~p_prev_escaped;
+                const uint64_t follows_escape = (p_backslash << 1) | p_prev_escaped;
+
+                const uint64_t even_bits = 0x5555555555555555ULL;
+                const uint64_t odd_sequence_starts = p_backslash & ~even_bits & ~follows_escape;
+                const uint64_t sequences_starting_on_even_bits = odd_sequence_starts + p_backslash;
+                // 加法溢出意味着块末尾的反斜杠序列转义了下一块的第一个字符
+                p_prev_escaped = sequences_starting_on_even_bits < odd_sequence_starts ? 1 : 0;
+                const uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+
+                return (even_bits ^ invert_mask) & follows_escape;
+            }
+
+            /**
+             * @brief 找到与 p_begin 处的 '[' 或 '{' 匹配的结束括号，用于不解析地跳过整个子树。
+             *        与建立索引相同，按 64 字节块分类字符并识别转义与字符串内部，
+             *        因此字符串中的括号和被转义的引号都不会被计入；子树的内容不做校验。
+             * @param p_level 使用的指令集级别（不能超过 CPU 实际支持的级别）。
+             * @param p_begin 指向容器的开括号。
+             * @param p_end 输入的结束位置。
+             * @return 匹配的结束括号之后的位置；括号没有闭合时返回 nullptr。
+             */
+            static const char *find_container_end(simd::Level p_level, const char *p_begin, const char *p_end) noexcept
+            {
+                uint64_t prev_escaped = 0;
+                uint64_t prev_in_string = 0;
+                int64_t depth = 0;
+                simd::BlockMasks masks;
+                for (const char *offset = p_begin; offset < p_end; offset += 64)
+                {
+                    // 最后一块不足 64 字节时，拷贝到以空格填充的缓冲区中
+                    char tail[64];
+                    const char *block = offset;
+                    if (p_end - offset < 64)
+                    {
+                        std::memset(tail, ' ', sizeof(tail));
+                        std::memcpy(tail, offset, static_cast<size_t>(p_end - offset));
+                        block = tail;
+                    }
+                    simd::classify_block(p_level, block, masks);
+                    const uint64_t escaped = find_escaped(masks.backslash, prev_escaped);
+                    const uint64_t in_string = simd::prefix_xor(masks.quote & ~escaped) ^ prev_in_string;
+                    prev_in_string = uint64_t(static_cast<int64_t>(in_string) >> 63);
+                    for (uint64_t bits = masks.op & ~in_string; bits != 0; bits &= bits - 1)
+                    {
+                        const int bit = simd::trailing_zeros(bits);
+                        const char ch = block[bit];
+                        if (ch == '[' || ch == '{')
+                            ++depth;
+                        else if ((ch == ']' || ch == '}') && --depth == 0)
+                            return offset + bit + 1;
+                    }
+                }
+                return nullptr;
+            }
+
+        private:
+            /// @brief 将掩码中所有置位的位置写入索引。@param p_count 已写入的数量，会被更新。
+            void flatten(uint64_t p_bits, size_t p_base, size_t &p_count)
+            {
+                if (p_bits == 0)
+                    return;
+                // 按最坏情况（64 个）预留空间，之后用裸指针写入
+                if (p_count + 64 > m_positions.size())
+                    m_positions.resize((std::max)(m_positions.size() * 2, p_count + 64));
+                uint32_t *out = m_positions.data() + p_count;
+                const uint32_t base = static_cast<uint32_t>(p_base);
+                const int count = simd::popcount(p_bits);
+
+                // 每次无条件写出 8 个位置，多写的部分会在之后被覆盖。
+                // 这样循环次数只取决于 count / 8，避免了逐位循环带来的大量分支预测失败。
+                // 最高位兜底保证 trailing_zeros 的参数不为 0。
+                for (int written = 0; written < count; written += 8)
+                {
+                    for (int lane = 0; lane < 8; ++lane)
+                    {
+                        out[written + lane] = base + static_cast<uint32_t>(simd::trailing_zeros(p_bits | (uint64_t(1) << 63)));
+                        p_bits &= p_bits - 1;
+                    }
+                }
+                p_count += count;
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_STRUCTURAL_INDEX
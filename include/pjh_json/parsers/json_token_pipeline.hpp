@@ -0,0 +1,149 @@
+#ifndef INCLUDE_JSON_TOKEN_PIPELINE
+#define INCLUDE_JSON_TOKEN_PIPELINE
+
+#include <exception>
+#include <thread>
+
+#include <pjh_json/helpers/json_definition.hpp>
+
+#include <pjh_json/parsers/json_tokenizer.hpp>
+
+#include <pjh_json/utils/lock_free_ring_buffer.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @struct TokenBlock
+         * @brief 生产者与消费者之间一次交接的一批 Token（约 4 KB）。
+         *        error 非空表示词法分析在这批 Token 之后失败，消费者读完它们时重新抛出该异常。
+         */
+        struct TokenBlock
+        {
+            static constexpr size_t capacity = 4096 / sizeof(Token);
+
+            Token tokens[capacity];
+            size_t count = 0;
+            std::exception_ptr error;
+        };
+
+        /**
+         * @class TokenPipeline
+         * @brief 两线程流水线：后台线程运行 Tokenizer，按 TokenBlock 批量写入环形缓冲区；
+         *        当前线程像读取 Tokenizer 一样通过 peek() / consume() 读取 Token 并构建结果。
+         *        析构时关闭缓冲区并等待后台线程退出，因此消费者提前出错时不会遗留线程。
+         */
+        class TokenPipeline
+        {
+        public:
+            /// @brief 环形缓冲区中的块数（可同时在途的块数为其减一）。
+            static constexpr size_t default_blocks = 16;
+
+        private:
+            LockFreeRingBuffer<TokenBlock> m_ring; // 交接 Token 块的环形缓冲区
+            TokenBlock *m_block;                   // 消费者当前读取的块
+            size_t m_index;                        // 当前 Token 在块中的下标
+            std::thread m_producer;                // 运行 Tokenizer 的后台线程
+
+        public:
+            /**
+             * @brief 构造函数，立即启动后台线程。
+             * @param p_tokenizer 词法分析器，流水线存续期间只能由后台线程使用。
+             * @param p_blocks 环形缓冲区中的块数。
+             */
+            explicit TokenPipeline(Tokenizer &p_tokenizer, size_t p_blocks = default_blocks)
+                : m_ring(p_blocks < 2 ? 2 : p_blocks), m_block(nullptr), m_index(0)
+            {
+                m_producer = std::thread([this, &p_tokenizer]()
+                                         { produce(p_tokenizer); });
+                try
+                {
+                    next_block();
+                }
+                catch (...)
+                {
+                    // 构造失败时析构函数不会执行，需要在这里回收后台线程
+                    m_ring.close();
+                    m_producer.join();
+                    throw;
+                }
+            }
+
+            TokenPipeline(const TokenPipeline &) = delete;
+            TokenPipeline &operator=(const TokenPipeline &) = delete;
+
+            /// @brief 析构函数，通知后台线程停止并等待其退出。
+            ~TokenPipeline()
+            {
+                m_ring.close();
+                if (m_producer.joinable())
+                    m_producer.join();
+            }
+
+        public:
+            /// @brief 查看当前的 Token。
+            const Token &peek() const noexcept { return m_block->tokens[m_index]; }
+
+            /// @brief 消费当前的 Token。到达 End 之后保持停在 End 上，与 Tokenizer 的行为一致。
+            void consume()
+            {
+                if (m_block->tokens[m_index].type == TokenType::End)
+                    return;
+                if (++m_index == m_block->count)
+                {
+                    // 词法错误发生在这批 Token 之后：在“读取下一个 Token”时抛出，与单线程时的位置一致
+                    if (m_block->error)
+                        std::rethrow_exception(m_block->error);
+                    m_ring.release_read();
+                    next_block();
+                }
+            }
+
+        private:
+            /// @brief 等待并切换到下一个块。
+            void next_block()
+            {
+                m_block = m_ring.acquire_read();
+                m_index = 0;
+                if (m_block->count == 0)
+                    std::rethrow_exception(m_block->error);
+            }
+
+            /// @brief 后台线程：持续读取 Token 直到 End 或出错，出错时把异常随最后一个块交给消费者。
+            void produce(Tokenizer &p_tokenizer)
+            {
+                while (TokenBlock *block = m_ring.acquire_write())
+                {
+                    block->count = 0;
+                    block->error = nullptr;
+                    bool finished = false;
+                    try
+                    {
+                        while (block->count < TokenBlock::capacity)
+                        {
+                            const Token &token = p_tokenizer.peek();
+                            block->tokens[block->count++] = token;
+                            if (token.type == TokenType::End)
+                            {
+                                finished = true;
+                                break;
+                            }
+                            p_tokenizer.consume();
+                        }
+                    }
+                    catch (...)
+                    {
+                        block->error = std::current_exception();
+                        finished = true;
+                    }
+                    m_ring.commit_write();
+                    if (finished)
+                        return;
+                }
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_TOKEN_PIPELINE
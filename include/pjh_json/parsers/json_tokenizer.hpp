@@ -1,11 +1,18 @@
 #ifndef INCLUDE_JSON_TOKENIZER
 #define INCLUDE_JSON_TOKENIZER
 
+#include <algorithm>
+#include <memory>
 #include <string>
 
 #include <pjh_json/helpers/json_definition.hpp>
 #include <pjh_json/helpers/json_exception.hpp>
 
+#include <pjh_json/parsers/json_options.hpp>
+#include <pjh_json/parsers/json_structural_index.hpp>
+
+#include <pjh_json/utils/escape.hpp>
+
 namespace pjh_std
 {
     namespace json
@@ -33,6 +40,7 @@ namespace pjh_std
         {
             TokenType type;
             std::string_view value;
+            bool escaped = false; // 字符串 Token 是否含有转义序列（不含时可以直接零拷贝地使用 value）
         };
 
         /**
@@ -42,43 +50,209 @@ namespace pjh_std
         class Tokenizer
         {
         private:
-            std::string m_str; // 要解析的原始字符串
-            size_t m_pos;      // 当前解析位置
+            std::shared_ptr<const string_t> m_owned; // 拥有模式下持有的只读输入副本（借用模式下为空）
+            string_v_t m_str;                        // 要解析的原始字符串视图，指向 m_owned 或调用方的缓冲区
+            bool m_is_owner;                         // 是否为拥有模式
+            size_t m_pos;                            // 当前解析位置
 
-            size_t line;   // 当前行号
-            size_t column; // 当前列号
+            simd::Level m_level;     // 向量化扫描使用的指令集级别
+            bool m_indexed;          // 是否按结构索引跳转
+            StructuralIndex m_index; // 结构字符索引
+            size_t m_index_pos;      // 下一个待读取的索引项
 
             Token m_current_token; // 当前已解析出的 Token
 
         public:
-            /// @brief 构造函数。@param p_str 要解析的 JSON 字符串。
-            Tokenizer(const std::string &p_str)
-                : m_str(p_str), m_pos(0),
-                  line(1), column(1) { consume(); } // 初始化时即读取第一个 token
+            /// @brief 构造函数（拥有模式），拷贝一份输入。@param p_str 要解析的 JSON 字符串。
+            Tokenizer(const std::string &p_str, const ParseOptions &p_options = ParseOptions())
+                : m_owned(std::make_shared<const string_t>(p_str)), m_str(*m_owned), m_is_owner(true), m_pos(0),
+                  m_level(simd::Level::Scalar), m_indexed(false), m_index_pos(0) { init(p_options); } // 初始化时即读取第一个 token
+            /// @brief 构造函数（拥有模式），接管传入字符串的所有权，不发生拷贝。
+            Tokenizer(std::string &&p_str, const ParseOptions &p_options = ParseOptions())
+                : m_owned(std::make_shared<const string_t>(std::move(p_str))), m_str(*m_owned), m_is_owner(true), m_pos(0),
+                  m_level(simd::Level::Scalar), m_indexed(false), m_index_pos(0) { init(p_options); }
+            /// @brief 构造函数（拥有模式），从 C 字符串拷贝一份输入。
+            Tokenizer(const char *p_str, const ParseOptions &p_options = ParseOptions())
+                : Tokenizer(string_t(p_str), p_options) {}
+
+            /**
+             * @brief 构造函数（借用模式），直接在调用方的缓冲区上进行词法分析，不拷贝输入。
+             * @param p_view 要解析的 JSON 文本。
+             *
+             * 注意！借用模式下，Token 以及解析出的 Value 中的 string_view 都直接指向 p_view 所指的内存，
+             * 调用方必须保证该缓冲区在 Tokenizer、Parser 以及所有解析结果的生命周期内保持有效且不被修改。
+             */
+            explicit Tokenizer(string_v_t p_view, const ParseOptions &p_options = ParseOptions())
+                : m_owned(), m_str(p_view), m_is_owner(false), m_pos(0),
+                  m_level(simd::Level::Scalar), m_indexed(false), m_index_pos(0) { init(p_options); }
+            /// @brief 构造函数（借用模式），等价于 Tokenizer(string_v_t(p_data, p_size))。
+            Tokenizer(const char *p_data, size_t p_size, const ParseOptions &p_options = ParseOptions())
+                : Tokenizer(string_v_t(p_data, p_size), p_options) {}
+
+            /// @brief 拷贝构造函数。拥有模式下与原对象共享同一份只读输入，因此视图无需重定位。
             Tokenizer(const Tokenizer &other) = default;
+            /// @brief 移动构造函数。
+            Tokenizer(Tokenizer &&other) noexcept = default;
+            Tokenizer &operator=(const Tokenizer &) = delete;
+            Tokenizer &operator=(Tokenizer &&) = delete;
             ~Tokenizer() = default;
 
+            /// @brief 获取正在解析的原始输入。
+            string_v_t source() const noexcept { return m_str; }
+            /// @brief 是否为拥有模式（持有输入副本）。
+            bool is_owner() const noexcept { return m_is_owner; }
+            /// @brief 获取输入副本的共享所有权（借用模式下为空），用于让解析结果延长输入的生命周期。
+            std::shared_ptr<const void> source_owner() const noexcept { return m_owned; }
+            /// @brief 获取向量化扫描使用的指令集级别。
+            simd::Level simd_level() const noexcept { return m_level; }
+
             /// @brief 查看当前的 Token，但不移动解析位置。
             const Token peek() const noexcept { return m_current_token; }
             /// @brief 消费当前的 Token，并读取下一个 Token。
             void consume() { m_current_token = read_next_token(); }
 
+            /**
+             * @brief 跳过当前 Token 开始的整个值，之后的当前 Token 为该值之后的第一个 Token。
+             *        对象与数组不逐个产生 Token，而是从开括号起按括号匹配直接跳到结束括号之后
+             *        （StructuralIndex::find_container_end，能识别字符串与转义），因此其中的内容不做校验；
+             *        标量与字符串已经作为当前 Token 读入，消费即可。
+             */
+            void skip_value()
+            {
+                const Token token = m_current_token;
+                if (token.type != TokenType::ObjectBegin && token.type != TokenType::ArrayBegin)
+                {
+                    if (token.type != TokenType::String && token.type != TokenType::Integer && token.type != TokenType::Float &&
+                        token.type != TokenType::Bool && token.type != TokenType::Null)
+                        throw TypeException("Unexpected token type");
+                    consume();
+                    return;
+                }
+
+                const char *begin = m_str.data();
+                const char *close = StructuralIndex::find_container_end(m_level, token.value.data(), begin + m_str.size());
+                if (close == nullptr)
+                {
+                    m_pos = m_str.size();
+                    throw error(token.type == TokenType::ObjectBegin ? "Expected ',' or '}' in object" : "Expected ',' or ']' in array");
+                }
+                m_pos = static_cast<size_t>(close - begin);
+                // 按索引读取时，跳过所有位于子树内部的索引项
+                if (m_indexed)
+                {
+                    const auto &positions = m_index.positions();
+                    m_index_pos = std::lower_bound(positions.begin() + m_index_pos, positions.end(), static_cast<uint32_t>(m_pos)) - positions.begin();
+                }
+                consume();
+            }
+
         private:
+            /// @brief 按选项完成初始化（必要时建立结构索引），并读取第一个 Token。
+            void init(const ParseOptions &p_options)
+            {
+                m_level = (std::min)(p_options.simd_level, simd::detect_level());
+                // 索引以 32 位存储位置，超大输入退回逐字节扫描
+                if (p_options.structural_index && m_str.size() <= StructuralIndex::max_input_size)
+                {
+                    // UTF-8 校验与索引的建立交替进行
+                    m_index.build(m_str, p_options.simd_level, p_options.validate_utf8);
+                    m_indexed = true;
+                    if (m_index.utf8_error() != StructuralIndex::npos)
+                    {
+                        m_pos = m_index.utf8_error();
+                        throw error("Invalid UTF-8 sequence");
+                    }
+                }
+                else if (p_options.validate_utf8)
+                {
+                    const char *begin = m_str.data();
+                    const char *bad = simd::find_utf8_error(m_level, begin, begin + m_str.size());
+                    if (bad != begin + m_str.size())
+                    {
+                        m_pos = static_cast<size_t>(bad - begin);
+                        throw error("Invalid UTF-8 sequence");
+                    }
+                }
+                consume();
+            }
+
+            /// @brief 构造一个位于当前位置的解析异常，行列号由异常根据偏移量推算。
+            ParseException error(const std::string &msg) const { return ParseException(m_str, m_pos, msg); }
+
             /// @brief 检查是否已到达字符串末尾。
             bool eof() const noexcept { return m_pos >= m_str.size(); }
             /// @brief 查看当前位置的字符，但不移动位置。
             char peek_char() const { return m_str[m_pos]; }
             /// @brief 获取当前位置的字符，并移动位置。
-            char get_char() { return column++, m_str[m_pos++]; }
+            char get_char() { return m_str[m_pos++]; }
 
             /// @brief 读取并返回下一个有效的 Token。
             Token read_next_token()
             {
+                if (m_indexed)
+                    return read_next_indexed_token();
+
                 // 1. 跳过所有空白字符
                 skip_white_space();
                 if (eof())
-                    return {TokenType::End, ""}; // 如果已到末尾，返回 End Token
+                    return {TokenType::End, string_v_t(m_str.data() + m_pos, 0)}; // 如果已到末尾，返回 End Token
+
+                return read_token();
+            }
+
+            /// @brief 按结构索引读取下一个 Token：直接跳到下一个结构位置，无需扫描空白与字符串内容。
+            Token read_next_indexed_token()
+            {
+                if (m_index_pos >= m_index.size())
+                {
+                    m_pos = m_str.size();
+                    return {TokenType::End, string_v_t(m_str.data() + m_pos, 0)};
+                }
+
+                const size_t start_pos = m_index[m_index_pos++];
+                m_pos = start_pos;
 
+                // 1. 字符串：开引号之后的下一个索引项必然是与之配对的闭引号
+                if (m_str[start_pos] == '"')
+                {
+                    if (m_index_pos >= m_index.size())
+                    {
+                        m_pos = m_str.size();
+                        throw error("Unterminated string literal");
+                    }
+                    const size_t end_pos = m_index[m_index_pos++];
+                    // 索引跳过了字符串内容，这里向量化地查找并校验其中的转义序列
+                    const char *begin = m_str.data();
+                    bool escaped = false;
+                    m_pos = start_pos + 1;
+                    while ((m_pos = simd::find_quote_or_backslash(m_level, begin + m_pos, begin + end_pos) - begin) < end_pos)
+                    {
+                        escaped = true;
+                        skip_escape();
+                    }
+                    m_pos = end_pos + 1;
+                    return {TokenType::String, std::string_view(m_str.data() + start_pos + 1, end_pos - start_pos - 1), escaped};
+                }
+
+                // 2. 结构字符与标量沿用逐字节的解析逻辑
+                Token token = read_token();
+
+                // 3. 标量之后只能是空白或结构字符，否则如 "truex" 中多余的字母、"[1\]" 中的反斜杠不会出现在索引里而被悄悄跳过
+                if (token.type != TokenType::ObjectBegin && token.type != TokenType::ObjectEnd &&
+                    token.type != TokenType::ArrayBegin && token.type != TokenType::ArrayEnd &&
+                    token.type != TokenType::Colon && token.type != TokenType::Comma && !eof())
+                {
+                    const char next_ch = peek_char();
+                    const uint8_t next_class = simd::char_classes.table[static_cast<uint8_t>(next_ch)];
+                    if (next_class != simd::ClassWhitespace && next_class != simd::ClassOp)
+                        throw error((std::string) "Unexpected character '" + std::string(1, next_ch) + "'");
+                }
+                return token;
+            }
+
+            /// @brief 从当前位置（已跳过空白）读取一个 Token。
+            Token read_token()
+            {
                 const size_t start_pos = m_pos;
                 char current_ch = peek_char();
 
@@ -114,7 +288,7 @@ namespace pjh_std
                     if (isdigit(current_ch) || current_ch == '-')
                         return parse_number(); // 解析数字
                     else
-                        throw ParseException(line, column, (std::string) "Unexpected character '" + std::string(1, current_ch) + "'");
+                        throw error((std::string) "Unexpected character '" + std::string(1, current_ch) + "'");
                     break;
                 }
             }
@@ -123,18 +297,14 @@ namespace pjh_std
             /// @brief 跳过空白字符（空格、制表符、换行符）。
             inline void skip_white_space()
             {
-                while (!eof() &&
-                       (peek_char() == '\n' ||
-                        peek_char() == '\t' ||
-                        peek_char() == '\r' ||
-                        peek_char() == ' '))
-                {
-                    if (get_char() == '\n') // 如果是换行符，更新行号和列号
-                        line++, column = 1;
-                }
+                // 大多数 Token 之间没有空白，先用一次查表判断走快速路径，只有遇到空白才进入向量化扫描
+                if (eof() || simd::char_classes.table[static_cast<uint8_t>(peek_char())] != simd::ClassWhitespace)
+                    return;
+                const char *begin = m_str.data();
+                m_pos = simd::skip_whitespace(m_level, begin + m_pos + 1, begin + m_str.size()) - begin;
             }
 
-            /// @brief 解析数字 Token (整数或浮点数)。
+            /// @brief 解析数字 Token (整数或浮点数)，支持小数部分与指数部分（如 1e10、2.5E-3）。
             Token parse_number()
             {
                 const size_t start_pos = m_pos;
@@ -144,18 +314,28 @@ namespace pjh_std
                 if (!eof() && peek_char() == '-')
                     get_char();
 
-                // 2. 读取整数部分
-                while (!eof() && isdigit(peek_char()))
-                    get_char();
+                // 2. 读取整数部分（至少一位数字）
+                if (!skip_digits())
+                    throw error("Invalid number: expected digit");
 
                 // 3. 如果有小数点，则标记为浮点数并读取小数部分
                 if (!eof() && peek_char() == '.')
                 {
                     is_float = true;
                     get_char();
+                    if (!skip_digits())
+                        throw error("Invalid number: expected digit after '.'");
+                }
 
-                    while (!eof() && isdigit(peek_char()))
+                // 4. 如果有指数部分，同样标记为浮点数
+                if (!eof() && (peek_char() == 'e' || peek_char() == 'E'))
+                {
+                    is_float = true;
+                    get_char();
+                    if (!eof() && (peek_char() == '+' || peek_char() == '-'))
                         get_char();
+                    if (!skip_digits())
+                        throw error("Invalid number: expected digit in exponent");
                 }
 
                 return {
@@ -163,6 +343,15 @@ namespace pjh_std
                     std::string_view(m_str.data() + start_pos, m_pos - start_pos)};
             }
 
+            /// @brief 跳过连续的数字，返回是否至少跳过了一位。
+            bool skip_digits() noexcept
+            {
+                const size_t start_pos = m_pos;
+                while (!eof() && static_cast<unsigned char>(peek_char() - '0') < 10)
+                    ++m_pos;
+                return m_pos != start_pos;
+            }
+
             /// @brief 解析布尔值 Token (true 或 false)。
             Token parse_bool()
             {
@@ -173,18 +362,16 @@ namespace pjh_std
                 if (m_str.size() - start_pos >= 4 && std::string_view(m_str.data() + start_pos, 4) == "true"sv)
                 {
                     m_pos += 4;
-                    column += 4;
                     return {TokenType::Bool, std::string_view(m_str.data() + start_pos, 4)};
                 }
                 // 2. 尝试匹配 "false"
                 if (m_str.size() - start_pos >= 5 && std::string_view(m_str.data() + start_pos, 5) == "false"sv)
                 {
                     m_pos += 5;
-                    column += 5;
                     return {TokenType::Bool, std::string_view(m_str.data() + start_pos, 5)};
                 }
                 // 3. 匹配失败，抛出异常
-                throw ParseException(line, column, "Invalid boolean literal");
+                throw error("Invalid boolean literal");
             }
 
             /// @brief 解析字符串 Token。
@@ -193,29 +380,50 @@ namespace pjh_std
                 // 1. 消费开头的引号 "
                 get_char();
                 const size_t start_pos_content = m_pos;
+                const char *begin = m_str.data();
+                const char *end = begin + m_str.size();
+                bool escaped = false;
                 while (!eof())
                 {
-                    char ch = peek_char();
-                    // 2. 处理转义字符
-                    if (ch == '\\')
-                    {
-                        get_char(); // 消费 '\'
-                        if (!eof())
-                            get_char(); // 消费被转义的字符
-                    }
+                    // 2. 向量化地跳到下一个引号或反斜杠
+                    m_pos = simd::find_quote_or_backslash(m_level, begin + m_pos, end) - begin;
+                    if (eof())
+                        break;
                     // 3. 遇到结尾的引号，字符串结束
-                    else if (ch == '"')
+                    if (peek_char() == '"')
                     {
                         size_t end_pos_content = m_pos;
                         get_char(); // 消费结尾的引号 "
-                        return {TokenType::String, std::string_view(m_str.data() + start_pos_content, end_pos_content - start_pos_content)};
+                        return {TokenType::String, std::string_view(m_str.data() + start_pos_content, end_pos_content - start_pos_content), escaped};
                     }
-                    // 4. 处理普通字符
-                    else
-                        get_char();
+                    // 4. 处理转义字符：校验并跳过整个转义序列
+                    escaped = true;
+                    skip_escape();
                 }
                 // 5. 如果直到字符串末尾也没找到闭合引号，则抛出异常
-                throw ParseException(line, column, "Unterminated string literal");
+                throw error("Unterminated string literal");
+            }
+
+            /// @brief 校验当前位置以 '\\' 开头的转义序列，并把位置移动到序列之后。代理项是否成对留给解码时检查。
+            void skip_escape()
+            {
+                if (m_pos + 1 >= m_str.size())
+                {
+                    m_pos = m_str.size();
+                    throw error("Unterminated string literal");
+                }
+                const char ch = m_str[m_pos + 1];
+                if (ch == 'u')
+                {
+                    uint32_t code;
+                    if (!escape::read_hex4(m_str.data() + m_pos + 2, m_str.data() + m_str.size(), code))
+                        throw error("Invalid unicode escape sequence");
+                    m_pos += 6;
+                }
+                else if (escape::simple_unescape(ch) != 0)
+                    m_pos += 2;
+                else
+                    throw error((std::string) "Invalid escape character '" + std::string(1, ch) + "'");
             }
 
             /// @brief 解析 null Token。
@@ -228,11 +436,10 @@ namespace pjh_std
                 if (m_str.size() - start_pos >= 4 && std::string_view(m_str.data() + start_pos, 4) == "null"sv)
                 {
                     m_pos += 4;
-                    column += 4;
                     return {TokenType::Null, std::string_view(m_str.data() + start_pos, 4)};
                 }
                 // 2. 匹配失败，抛出异常
-                throw ParseException(line, column, "Invalid null literal");
+                throw error("Invalid null literal");
             }
         };
 
@@ -0,0 +1,228 @@
+#ifndef INCLUDE_JSON_ARENA
+#define INCLUDE_JSON_ARENA
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class Arena
+         * @brief 单调（bump）内存分配器。按块向系统申请内存，之后的分配只是移动块内的指针；
+         *        单个分配从不回收，所有内存在 reset() 或析构时一次性整体释放。
+         *        不是线程安全的，一份 Arena 只应由一个线程使用。
+         */
+        class Arena
+        {
+        public:
+            /// @brief 第一个内存块的默认大小（字节）。
+            static constexpr size_t default_block_size = 64 * 1024;
+            /// @brief 块大小翻倍增长的上限（字节）。
+            static constexpr size_t max_block_size = 16 * 1024 * 1024;
+
+        private:
+            struct Block
+            {
+                void *data;
+                size_t size;
+            };
+
+            std::vector<Block> m_blocks; // 已申请的全部内存块
+            char *m_cur;                 // 当前块中下一个可分配的位置
+            char *m_end;                 // 当前块的末尾
+            size_t m_next_block_size;    // 下一个块的大小
+            size_t m_used;               // 已分配出去的字节数（含对齐填充）
+            std::vector<std::unique_ptr<Arena>> m_adopted; // 通过 adopt() 接管的其他 Arena
+            bool m_heap_refs;            // Arena 上的对象是否引用了需要单独释放的堆内存
+
+        public:
+            /// @brief 构造函数。@param p_first_block_size 第一个内存块的大小，后续块按倍数增长。
+            explicit Arena(size_t p_first_block_size = default_block_size) noexcept
+                : m_blocks(), m_cur(nullptr), m_end(nullptr),
+                  m_next_block_size(p_first_block_size ? p_first_block_size : default_block_size), m_used(0), m_adopted(),
+                  m_heap_refs(false) {}
+
+            Arena(const Arena &) = delete;
+            Arena &operator=(const Arena &) = delete;
+
+            /// @brief 析构函数，一次性释放所有内存块。
+            ~Arena() { release_blocks(0); }
+
+        public:
+            /**
+             * @brief 分配一段未初始化的内存。
+             * @param p_bytes 字节数。
+             * @param p_align 对齐要求，必须是 2 的幂。
+             */
+            void *allocate(size_t p_bytes, size_t p_align = alignof(std::max_align_t))
+            {
+                char *aligned = align_up(m_cur, p_align);
+                if (m_cur == nullptr || aligned + p_bytes > m_end)
+                {
+                    grow(p_bytes + p_align);
+                    aligned = align_up(m_cur, p_align);
+                }
+                m_used += (aligned - m_cur) + p_bytes;
+                m_cur = aligned + p_bytes;
+                return aligned;
+            }
+
+            /// @brief 在 Arena 上构造一个 T 类型的对象。对象的析构函数不会被自动调用。
+            template <typename T, typename... Args>
+            T *create(Args &&...args)
+            {
+                return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief 接管另一个 Arena，使其与本 Arena 同生命周期（例如把各线程分别解析出的部分合并进一个文档）。
+             *        被接管的 Arena 对象本身保持不变，已绑定到它的容器仍可继续在其上分配。
+             */
+            void adopt(std::unique_ptr<Arena> p_other)
+            {
+                if (p_other != nullptr)
+                    m_adopted.push_back(std::move(p_other));
+            }
+
+            /// @brief 释放所有分配，仅保留第一个内存块以便复用。被接管的 Arena 一并释放。
+            void reset() noexcept
+            {
+                m_adopted.clear();
+                release_blocks(1);
+                if (!m_blocks.empty())
+                {
+                    m_cur = static_cast<char *>(m_blocks.front().data);
+                    m_end = m_cur + m_blocks.front().size;
+                }
+                m_used = 0;
+                m_heap_refs = false;
+            }
+
+            /// @brief 记录 Arena 上的对象引用了堆上的对象：释放 Arena 之前，持有者需要先遍历并释放它们。
+            void mark_heap_refs() noexcept { m_heap_refs = true; }
+            /// @brief Arena（含被接管的 Arena）上的对象是否引用了堆上的对象。
+            bool has_heap_refs() const noexcept
+            {
+                if (m_heap_refs)
+                    return true;
+                for (const auto &other : m_adopted)
+                    if (other->has_heap_refs())
+                        return true;
+                return false;
+            }
+
+            /// @brief 获取已分配出去的字节数。
+            size_t used() const noexcept
+            {
+                size_t total = m_used;
+                for (const auto &other : m_adopted)
+                    total += other->used();
+                return total;
+            }
+            /// @brief 获取向系统申请的总字节数。
+            size_t reserved() const noexcept
+            {
+                size_t total = 0;
+                for (const auto &block : m_blocks)
+                    total += block.size;
+                for (const auto &other : m_adopted)
+                    total += other->reserved();
+                return total;
+            }
+
+        private:
+            static char *align_up(char *p_ptr, size_t p_align) noexcept
+            {
+                const uintptr_t value = reinterpret_cast<uintptr_t>(p_ptr);
+                return reinterpret_cast<char *>((value + p_align - 1) & ~(uintptr_t(p_align) - 1));
+            }
+
+            /// @brief 申请一个至少能容纳 p_min_bytes 字节的新块。
+            void grow(size_t p_min_bytes)
+            {
+                size_t size = m_next_block_size;
+                while (size < p_min_bytes)
+                    size *= 2;
+                void *data = ::malloc(size);
+                if (!data)
+                    throw std::bad_alloc();
+                m_blocks.push_back({data, size});
+                m_cur = static_cast<char *>(data);
+                m_end = m_cur + size;
+                if (m_next_block_size < max_block_size)
+                    m_next_block_size *= 2;
+            }
+
+            /// @brief 释放第 p_keep 个之后的所有内存块。
+            void release_blocks(size_t p_keep) noexcept
+            {
+                while (m_blocks.size() > p_keep)
+                {
+                    ::free(m_blocks.back().data);
+                    m_blocks.pop_back();
+                }
+                if (m_blocks.empty())
+                    m_cur = m_end = nullptr;
+            }
+        };
+
+        /**
+         * @class ArenaAllocator
+         * @brief 符合标准库要求的分配器：绑定了 Arena 时从 Arena 上分配（释放为空操作），
+         *        未绑定时退化为普通的 ::operator new / delete。
+         *        使同一种容器类型既能用于堆上的节点，也能用于 Arena 上的节点。
+         */
+        template <typename T>
+        class ArenaAllocator
+        {
+        private:
+            Arena *m_arena; // 绑定的 Arena，为空时使用堆
+
+            template <typename U>
+            friend class ArenaAllocator;
+
+        public:
+            using value_type = T;
+            // 拷贝容器时不沿用 Arena：拷贝出来的容器总是位于堆上
+            using propagate_on_container_copy_assignment = std::false_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+
+            ArenaAllocator(Arena *p_arena = nullptr) noexcept : m_arena(p_arena) {}
+            template <typename U>
+            ArenaAllocator(const ArenaAllocator<U> &other) noexcept : m_arena(other.m_arena) {}
+
+            /// @brief 获取绑定的 Arena。
+            Arena *arena() const noexcept { return m_arena; }
+
+            T *allocate(size_t n)
+            {
+                if (m_arena != nullptr)
+                    return static_cast<T *>(m_arena->allocate(n * sizeof(T), alignof(T)));
+                return static_cast<T *>(::operator new(n * sizeof(T)));
+            }
+            void deallocate(T *ptr, size_t) noexcept
+            {
+                if (m_arena == nullptr)
+                    ::operator delete(ptr);
+            }
+
+            /// @brief 拷贝构造容器时返回不绑定 Arena 的分配器。
+            ArenaAllocator select_on_container_copy_construction() const noexcept { return ArenaAllocator(); }
+
+            template <typename U>
+            bool operator==(const ArenaAllocator<U> &other) const noexcept { return m_arena == other.m_arena; }
+            template <typename U>
+            bool operator!=(const ArenaAllocator<U> &other) const noexcept { return m_arena != other.m_arena; }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_ARENA
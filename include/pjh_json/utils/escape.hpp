@@ -0,0 +1,227 @@
+#ifndef INCLUDE_JSON_ESCAPE
+#define INCLUDE_JSON_ESCAPE
+
+#include <cstdint>
+#include <cstring>
+
+#include <pjh_json/helpers/json_definition.hpp>
+
+#include <pjh_json/utils/simd.hpp>
+#include <pjh_json/utils/writer.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        namespace escape
+        {
+            /// @brief 返回单字符转义序列 '\\x' 中 x 所代表的字符，x 不是合法的转义字符时返回 0（'\\u' 需单独处理）。
+            inline char simple_unescape(char p_ch) noexcept
+            {
+                switch (p_ch)
+                {
+                case '"':
+                    return '"';
+                case '\\':
+                    return '\\';
+                case '/':
+                    return '/';
+                case 'b':
+                    return '\b';
+                case 'f':
+                    return '\f';
+                case 'n':
+                    return '\n';
+                case 'r':
+                    return '\r';
+                case 't':
+                    return '\t';
+                default:
+                    return 0;
+                }
+            }
+
+            /// @brief 解析一位十六进制数字，非法时返回 -1。
+            inline int hex_value(char p_ch) noexcept
+            {
+                if (p_ch >= '0' && p_ch <= '9')
+                    return p_ch - '0';
+                if (p_ch >= 'a' && p_ch <= 'f')
+                    return p_ch - 'a' + 10;
+                if (p_ch >= 'A' && p_ch <= 'F')
+                    return p_ch - 'A' + 10;
+                return -1;
+            }
+
+            /// @brief 读取 p_ptr 开始的 4 位十六进制数字，不足 4 位或含非法字符时返回 false。
+            inline bool read_hex4(const char *p_ptr, const char *p_end, uint32_t &p_out) noexcept
+            {
+                if (p_end - p_ptr < 4)
+                    return false;
+                uint32_t value = 0;
+                for (int idx = 0; idx < 4; ++idx)
+                {
+                    const int digit = hex_value(p_ptr[idx]);
+                    if (digit < 0)
+                        return false;
+                    value = (value << 4) | static_cast<uint32_t>(digit);
+                }
+                p_out = value;
+                return true;
+            }
+
+            /// @brief 把一个 Unicode 码点编码为 UTF-8 写入 p_out，返回写入结束的位置。
+            inline char *encode_utf8(uint32_t p_code, char *p_out) noexcept
+            {
+                if (p_code < 0x80)
+                {
+                    *p_out++ = static_cast<char>(p_code);
+                }
+                else if (p_code < 0x800)
+                {
+                    *p_out++ = static_cast<char>(0xC0 | (p_code >> 6));
+                    *p_out++ = static_cast<char>(0x80 | (p_code & 0x3F));
+                }
+                else if (p_code < 0x10000)
+                {
+                    *p_out++ = static_cast<char>(0xE0 | (p_code >> 12));
+                    *p_out++ = static_cast<char>(0x80 | ((p_code >> 6) & 0x3F));
+                    *p_out++ = static_cast<char>(0x80 | (p_code & 0x3F));
+                }
+                else
+                {
+                    *p_out++ = static_cast<char>(0xF0 | (p_code >> 18));
+                    *p_out++ = static_cast<char>(0x80 | ((p_code >> 12) & 0x3F));
+                    *p_out++ = static_cast<char>(0x80 | ((p_code >> 6) & 0x3F));
+                    *p_out++ = static_cast<char>(0x80 | (p_code & 0x3F));
+                }
+                return p_out;
+            }
+
+            /**
+             * @brief 解码字符串内容 [p_in, p_end) 中的转义序列（含 '\\u' 代理对），结果写入 p_out。
+             *        两个转义之间的普通字符用向量化扫描整段拷贝。解码结果不会比输入更长，
+             *        因此 p_out 预留 p_end - p_in 字节即可。
+             * @param p_in 输入的起始位置；失败时指向出错的转义序列。
+             * @param p_end 输入的结束位置。
+             * @param p_out 输出位置；成功时移动到输出的末尾。
+             * @param p_level 向量化扫描使用的指令集级别。
+             * @return 所有转义序列合法时返回 true；非法转义或不成对的代理项返回 false。
+             */
+            inline bool unescape(const char *&p_in, const char *p_end, char *&p_out,
+                                 simd::Level p_level = simd::detect_level()) noexcept
+            {
+                while (true)
+                {
+                    // 1. 整段拷贝到下一个 '\\' 为止（字符串内容中不会出现未转义的引号）
+                    const char *next = simd::find_quote_or_backslash(p_level, p_in, p_end);
+                    std::memcpy(p_out, p_in, static_cast<size_t>(next - p_in));
+                    p_out += next - p_in;
+                    p_in = next;
+                    if (p_in == p_end)
+                        return true;
+                    if (*p_in != '\\')
+                    {
+                        *p_out++ = *p_in++;
+                        continue;
+                    }
+                    if (p_end - p_in < 2)
+                        return false;
+
+                    // 2. 单字符转义
+                    if (p_in[1] != 'u')
+                    {
+                        const char decoded = simple_unescape(p_in[1]);
+                        if (decoded == 0)
+                            return false;
+                        *p_out++ = decoded;
+                        p_in += 2;
+                        continue;
+                    }
+
+                    // 3. '\\uXXXX'，高代理项必须紧跟一个低代理项
+                    uint32_t code;
+                    if (!read_hex4(p_in + 2, p_end, code))
+                        return false;
+                    const char *after = p_in + 6;
+                    if (code >= 0xD800 && code <= 0xDBFF)
+                    {
+                        uint32_t low;
+                        if (p_end - after < 6 || after[0] != '\\' || after[1] != 'u' ||
+                            !read_hex4(after + 2, p_end, low) || low < 0xDC00 || low > 0xDFFF)
+                            return false;
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        after += 6;
+                    }
+                    else if (code >= 0xDC00 && code <= 0xDFFF)
+                        return false;
+                    p_out = encode_utf8(code, p_out);
+                    p_in = after;
+                }
+            }
+
+            /**
+             * @brief 序列化时每个字节的转义写法：0 表示原样输出，'u' 表示写成 '\\u00XX'，
+             *        其余表示写成 '\\' 加该字符。
+             */
+            struct EscapeTable
+            {
+                char table[256];
+                constexpr EscapeTable() : table()
+                {
+                    for (int ch = 0; ch < 0x20; ++ch)
+                        table[ch] = 'u';
+                    table[static_cast<uint8_t>('"')] = '"';
+                    table[static_cast<uint8_t>('\\')] = '\\';
+                    table[static_cast<uint8_t>('\b')] = 'b';
+                    table[static_cast<uint8_t>('\f')] = 'f';
+                    table[static_cast<uint8_t>('\n')] = 'n';
+                    table[static_cast<uint8_t>('\r')] = 'r';
+                    table[static_cast<uint8_t>('\t')] = 't';
+                }
+            };
+            inline constexpr EscapeTable escape_table{};
+
+            /**
+             * @brief 把字符串转义后写入 Writer（不含两侧引号）。不需要转义的片段用向量化扫描整段写出，
+             *        没有特殊字符的字符串只需一次扫描和一次拷贝。
+             */
+            inline void escape_to(Writer &p_writer, string_v_t p_str, simd::Level p_level = simd::detect_level())
+            {
+                static constexpr char hex_digits[] = "0123456789abcdef";
+                const char *ptr = p_str.data();
+                const char *end = ptr + p_str.size();
+                while (true)
+                {
+                    const char *next = simd::find_escapable(p_level, ptr, end);
+                    p_writer.write(ptr, static_cast<size_t>(next - ptr));
+                    if (next == end)
+                        return;
+                    const uint8_t ch = static_cast<uint8_t>(*next);
+                    const char code = escape_table.table[ch];
+                    if (code == 'u')
+                    {
+                        const char sequence[6] = {'\\', 'u', '0', '0', hex_digits[ch >> 4], hex_digits[ch & 0xF]};
+                        p_writer.write(sequence, sizeof(sequence));
+                    }
+                    else
+                    {
+                        const char sequence[2] = {'\\', code};
+                        p_writer.write(sequence, sizeof(sequence));
+                    }
+                    ptr = next + 1;
+                }
+            }
+
+            /// @brief 把字符串加上引号并转义后写入 Writer。
+            inline void write_quoted(Writer &p_writer, string_v_t p_str, simd::Level p_level = simd::detect_level())
+            {
+                p_writer.put('"');
+                escape_to(p_writer, p_str, p_level);
+                p_writer.put('"');
+            }
+        }
+    }
+}
+
+#endif // INCLUDE_JSON_ESCAPE
@@ -5,6 +5,8 @@
 #include <optional>
 #include <vector>
 
+#include <pjh_json/utils/wait_point.hpp>
+
 namespace pjh_std
 {
     namespace json
@@ -13,18 +15,25 @@ namespace pjh_std
          * @class LockFreeRingBuffer
          * @brief 一个无锁环形缓冲区，适用于单生产者-单消费者的场景。
          *        使用原子操作来保证线程安全，避免了锁的开销。
+         *        除了按值 push / pop 之外，还可以直接在槽位上原地读写（适合以大块批量交接数据），
+         *        并提供“先自旋、再睡眠”的阻塞版本与用于中止对方等待的 close()。
+         *        需要批量移动元素或只能移动的类型时使用 SpscQueue。
          */
         template <typename T>
         class LockFreeRingBuffer
         {
         private:
-            size_t m_capacity;             // 缓冲区容量
-            std::vector<T> m_buffer;       // 底层存储
-            std::atomic<size_t> m_head{0}; // 头指针（读取位置）
-            std::atomic<size_t> m_tail{0}; // 尾指针（写入位置）
+            size_t m_capacity;       // 缓冲区容量
+            std::vector<T> m_buffer; // 底层存储
+            // 读写位置分别位于独立的缓存行，避免生产者与消费者互相使对方的缓存行失效
+            alignas(64) std::atomic<size_t> m_head{0}; // 头指针（读取位置）
+            alignas(64) std::atomic<size_t> m_tail{0}; // 尾指针（写入位置）
+            alignas(64) std::atomic<bool> m_closed{false}; // 是否已关闭
+            WaitPoint m_not_empty;                         // 消费者等待数据
+            WaitPoint m_not_full;                          // 生产者等待空位
 
         public:
-            /// @brief 构造函数。@param p_capacity 缓冲区容量。
+            /// @brief 构造函数。@param p_capacity 缓冲区容量（可同时存放 p_capacity - 1 个元素）。
             LockFreeRingBuffer(size_t p_capacity = 256)
                 : m_capacity(p_capacity), m_buffer(p_capacity) {}
             ~LockFreeRingBuffer() = default;
@@ -33,37 +42,98 @@ namespace pjh_std
             /// @brief 向缓冲区推入一个元素。
             bool push(const T &p_item)
             {
-                size_t tail = m_tail.load(std::memory_order_relaxed);
-                size_t next_tail = (tail + 1) % m_capacity;
-                if (next_tail == m_head.load(std::memory_order_acquire))
+                T *slot = try_acquire_write();
+                if (slot == nullptr)
                     return false; // 缓冲区已满
-                m_buffer[tail] = p_item;
-                m_tail.store(next_tail, std::memory_order_release);
+                *slot = p_item;
+                commit_write();
                 return true;
             }
 
             /// @brief 从缓冲区弹出一个元素。
             bool pop()
             {
-                size_t head = m_head.load(std::memory_order_relaxed);
-                size_t next_head = (head + 1) % m_capacity;
-                if (head == m_tail.load(std::memory_order_acquire))
+                if (try_acquire_read() == nullptr)
                     return false; // 缓冲区为空
-                m_head.store(next_head, std::memory_order_release);
+                release_read();
                 return true;
             }
 
             /// @brief 查看缓冲区的头部元素，但不弹出。
             std::optional<T> peek()
             {
-                size_t head = m_head.load(std::memory_order_relaxed);
-                if (head == m_tail.load(std::memory_order_acquire))
+                const T *slot = try_acquire_read();
+                if (slot == nullptr)
                     return std::nullopt; // 缓冲区为空
-                T value = m_buffer[head];
+                T value = *slot;
                 return value;
             }
+
+        public:
+            /// @brief 获取下一个可写的槽位，缓冲区已满时返回 nullptr。写完后调用 commit_write() 发布。
+            T *try_acquire_write()
+            {
+                const size_t tail = m_tail.load(std::memory_order_relaxed);
+                if (next(tail) == m_head.load(std::memory_order_acquire))
+                    return nullptr;
+                return &m_buffer[tail];
+            }
+            /// @brief 发布通过 try_acquire_write() / acquire_write() 写好的槽位，并唤醒等待的消费者。
+            void commit_write()
+            {
+                const size_t tail = m_tail.load(std::memory_order_relaxed);
+                m_tail.store(next(tail), std::memory_order_seq_cst);
+                m_not_empty.notify();
+            }
+
+            /// @brief 获取头部元素所在的槽位，缓冲区为空时返回 nullptr。用完后调用 release_read() 归还。
+            T *try_acquire_read()
+            {
+                const size_t head = m_head.load(std::memory_order_relaxed);
+                if (head == m_tail.load(std::memory_order_acquire))
+                    return nullptr;
+                return &m_buffer[head];
+            }
+            /// @brief 归还通过 try_acquire_read() / acquire_read() 获取的槽位，并唤醒等待的生产者。
+            void release_read()
+            {
+                const size_t head = m_head.load(std::memory_order_relaxed);
+                m_head.store(next(head), std::memory_order_seq_cst);
+                m_not_full.notify();
+            }
+
+            /// @brief 阻塞地获取一个可写槽位；缓冲区被关闭时返回 nullptr。
+            T *acquire_write()
+            {
+                T *slot = nullptr;
+                m_not_full.wait([&]()
+                                { return closed() || (slot = try_acquire_write()) != nullptr; });
+                return closed() ? nullptr : slot;
+            }
+            /// @brief 阻塞地获取头部槽位；缓冲区被关闭且已读空时返回 nullptr。
+            T *acquire_read()
+            {
+                T *slot = nullptr;
+                m_not_empty.wait([&]()
+                                 { return (slot = try_acquire_read()) != nullptr || closed(); });
+                return slot;
+            }
+
+            /// @brief 关闭缓冲区：唤醒双方的等待，之后的 acquire_write() 总是返回 nullptr。
+            void close()
+            {
+                m_closed.store(true, std::memory_order_seq_cst);
+                m_not_empty.notify();
+                m_not_full.notify();
+            }
+            /// @brief 缓冲区是否已关闭。
+            bool closed() const noexcept { return m_closed.load(std::memory_order_acquire); }
+
+        private:
+            /// @brief 下一个槽位的下标（比较后回绕，避免每次取模）。
+            size_t next(size_t p_index) const noexcept { return p_index + 1 == m_capacity ? 0 : p_index + 1; }
         };
     }
 }
 
-#endif // INCLUDE_JSON_LOCK_FREE_RING_BUFFER
\ No newline at end of file
+#endif // INCLUDE_JSON_LOCK_FREE_RING_BUFFER
@@ -0,0 +1,176 @@
+#ifndef INCLUDE_JSON_MAPPED_FILE
+#define INCLUDE_JSON_MAPPED_FILE
+
+#include <string>
+#include <string_view>
+#include <filesystem>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <pjh_json/helpers/json_exception.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class MappedFile
+         * @brief 以只读方式把整个文件映射到内存中。
+         *        文件内容按页在首次访问时才由缺页中断加载，省去了 ifstream 读取与字符串拷贝的开销。
+         *        映射在对象析构时解除，因此所有指向 data() 的 string_view 都不能活得比它更久。
+         */
+        class MappedFile
+        {
+        private:
+            const char *m_data = nullptr; // 映射区域的起始地址
+            size_t m_size = 0;            // 文件大小（字节）
+
+#if defined(_WIN32)
+            HANDLE m_file = INVALID_HANDLE_VALUE; // 文件句柄
+            HANDLE m_mapping = nullptr;           // 文件映射句柄
+#endif
+
+        public:
+            /// @brief 构造函数，打开并映射文件，失败时抛出 FileException。@param p_path 文件路径。
+            explicit MappedFile(const std::filesystem::path &p_path) { map(p_path); }
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+
+            /// @brief 移动构造函数，转移映射的所有权。
+            MappedFile(MappedFile &&other) noexcept { steal(other); }
+            /// @brief 移动赋值运算符。
+            MappedFile &operator=(MappedFile &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    unmap();
+                    steal(other);
+                }
+                return *this;
+            }
+
+            /// @brief 析构函数，解除映射并关闭文件。
+            ~MappedFile() { unmap(); }
+
+        public:
+            /// @brief 获取映射区域的起始地址。
+            const char *data() const noexcept { return m_data; }
+            /// @brief 获取文件大小。
+            size_t size() const noexcept { return m_size; }
+            /// @brief 以 string_view 的形式获取整个文件内容。
+            std::string_view view() const noexcept { return std::string_view(m_data, m_size); }
+
+        private:
+            /// @brief 打开文件并建立只读映射。空文件不做映射，得到一个空视图。
+            void map(const std::filesystem::path &p_path)
+            {
+#if defined(_WIN32)
+                m_file = ::CreateFileW(p_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                       OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (m_file == INVALID_HANDLE_VALUE)
+                    throw FileException("cannot open '" + p_path.string() + "'");
+
+                LARGE_INTEGER file_size;
+                if (!::GetFileSizeEx(m_file, &file_size))
+                {
+                    unmap();
+                    throw FileException("cannot stat '" + p_path.string() + "'");
+                }
+                m_size = static_cast<size_t>(file_size.QuadPart);
+                if (m_size == 0)
+                    return;
+
+                m_mapping = ::CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (m_mapping == nullptr)
+                {
+                    unmap();
+                    throw FileException("cannot map '" + p_path.string() + "'");
+                }
+                m_data = static_cast<const char *>(::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+                if (m_data == nullptr)
+                {
+                    unmap();
+                    throw FileException("cannot map '" + p_path.string() + "'");
+                }
+#else
+                int fd = ::open(p_path.c_str(), O_RDONLY);
+                if (fd < 0)
+                    throw FileException("cannot open '" + p_path.string() + "'");
+
+                struct stat st;
+                if (::fstat(fd, &st) != 0)
+                {
+                    ::close(fd);
+                    throw FileException("cannot stat '" + p_path.string() + "'");
+                }
+                m_size = static_cast<size_t>(st.st_size);
+                if (m_size == 0)
+                {
+                    ::close(fd);
+                    return;
+                }
+
+                void *addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                // 映射建立后文件描述符即可关闭，映射本身会保持对文件的引用
+                ::close(fd);
+                if (addr == MAP_FAILED)
+                {
+                    m_size = 0;
+                    throw FileException("cannot map '" + p_path.string() + "'");
+                }
+                // 解析是顺序读取的，提示内核进行积极的预读
+                ::madvise(addr, m_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char *>(addr);
+#endif
+            }
+
+            /// @brief 解除映射并释放所有系统资源。
+            void unmap() noexcept
+            {
+#if defined(_WIN32)
+                if (m_data != nullptr)
+                    ::UnmapViewOfFile(m_data);
+                if (m_mapping != nullptr)
+                    ::CloseHandle(m_mapping);
+                if (m_file != INVALID_HANDLE_VALUE)
+                    ::CloseHandle(m_file);
+                m_mapping = nullptr;
+                m_file = INVALID_HANDLE_VALUE;
+#else
+                if (m_data != nullptr)
+                    ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+                m_data = nullptr;
+                m_size = 0;
+            }
+
+            /// @brief 从另一个对象窃取映射资源。
+            void steal(MappedFile &other) noexcept
+            {
+                m_data = other.m_data;
+                m_size = other.m_size;
+                other.m_data = nullptr;
+                other.m_size = 0;
+#if defined(_WIN32)
+                m_file = other.m_file;
+                m_mapping = other.m_mapping;
+                other.m_file = INVALID_HANDLE_VALUE;
+                other.m_mapping = nullptr;
+#endif
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_MAPPED_FILE
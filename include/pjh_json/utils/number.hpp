@@ -0,0 +1,234 @@
+#ifndef INCLUDE_JSON_NUMBER
+#define INCLUDE_JSON_NUMBER
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        namespace number
+        {
+            /**
+             * @brief 各浮点类型的 Clinger 快速路径参数：
+             *        尾数不超过 max_mantissa、十进制指数绝对值不超过 max_exponent 时，
+             *        尾数与 10 的幂都能被精确表示，一次乘（除）法即得到正确舍入的结果。
+             */
+            template <typename T>
+            struct FastPathLimits;
+
+            template <>
+            struct FastPathLimits<float>
+            {
+                static constexpr uint64_t max_mantissa = uint64_t(1) << 24;
+                static constexpr int max_exponent = 10;
+            };
+
+            template <>
+            struct FastPathLimits<double>
+            {
+                static constexpr uint64_t max_mantissa = uint64_t(1) << 53;
+                static constexpr int max_exponent = 22;
+            };
+
+            /// @brief 精确可表示的 10 的幂（double 最多到 1e22）。
+            template <typename T>
+            inline T exact_power_of_ten(int p_exp) noexcept
+            {
+                static constexpr double powers[] = {
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+                return static_cast<T>(powers[p_exp]);
+            }
+
+            /**
+             * @brief 后备路径：交给标准库的 from_chars（libstdc++ / MSVC 的实现基于 Eisel-Lemire 算法，
+             *        不分配内存、不依赖 locale）。不支持浮点 from_chars 的旧标准库退回 strtod。
+             */
+            template <typename T>
+            inline bool parse_floating_slow(const char *p_begin, const char *p_end, T &p_out) noexcept
+            {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+                auto [ptr, ec] = std::from_chars(p_begin, p_end, p_out);
+                return ec == std::errc() && ptr == p_end;
+#else
+                char buffer[128];
+                const size_t length = static_cast<size_t>(p_end - p_begin);
+                if (length >= sizeof(buffer))
+                    return false;
+                std::memcpy(buffer, p_begin, length);
+                buffer[length] = '\0';
+                char *end = nullptr;
+                const double value = std::strtod(buffer, &end);
+                if (end != buffer + length || value == HUGE_VAL || value == -HUGE_VAL)
+                    return false;
+                p_out = static_cast<T>(value);
+                return true;
+#endif
+            }
+
+            /**
+             * @brief 直接在字符区间上把 JSON 数字文本解析为 float / double，不构造临时字符串。
+             *        常见的短数字（如 "-7641.626"、"2.5E-3"）走 Clinger 快速路径，其余交给 from_chars。
+             * @param p_begin 数字文本的起始位置（已由词法分析器校验过语法）。
+             * @param p_end 数字文本的结束位置。
+             * @param p_out 解析结果。
+             * @return 解析成功返回 true；溢出或格式错误返回 false。
+             */
+            template <typename T>
+            inline bool parse_floating(const char *p_begin, const char *p_end, T &p_out) noexcept
+            {
+                static_assert(std::is_floating_point_v<T>, "T must be a floating point type");
+                using limits = FastPathLimits<T>;
+
+                const char *ptr = p_begin;
+                const bool negative = ptr != p_end && *ptr == '-';
+                if (negative)
+                    ++ptr;
+
+                // 1. 累积全部有效数字（最多 19 位，保证不溢出 uint64_t）
+                uint64_t mantissa = 0;
+                int digits = 0;
+                int exponent = 0;
+                for (; ptr != p_end && static_cast<unsigned char>(*ptr - '0') < 10; ++ptr, ++digits)
+                    mantissa = mantissa * 10 + static_cast<unsigned>(*ptr - '0');
+                if (ptr != p_end && *ptr == '.')
+                {
+                    const char *fraction = ++ptr;
+                    for (; ptr != p_end && static_cast<unsigned char>(*ptr - '0') < 10; ++ptr, ++digits)
+                        mantissa = mantissa * 10 + static_cast<unsigned>(*ptr - '0');
+                    exponent -= static_cast<int>(ptr - fraction);
+                }
+
+                // 2. 指数部分
+                if (ptr != p_end && (*ptr == 'e' || *ptr == 'E'))
+                {
+                    ++ptr;
+                    const bool exp_negative = ptr != p_end && *ptr == '-';
+                    if (ptr != p_end && (*ptr == '-' || *ptr == '+'))
+                        ++ptr;
+                    int exp_value = 0;
+                    for (; ptr != p_end && static_cast<unsigned char>(*ptr - '0') < 10; ++ptr)
+                        if (exp_value < 100000)
+                            exp_value = exp_value * 10 + (*ptr - '0');
+                    exponent += exp_negative ? -exp_value : exp_value;
+                }
+
+                // 3. Clinger 快速路径：尾数与 10 的幂都可以精确表示
+                if (ptr == p_end && digits <= 19 && mantissa <= limits::max_mantissa &&
+                    exponent >= -limits::max_exponent && exponent <= limits::max_exponent)
+                {
+                    T value = static_cast<T>(mantissa);
+                    if (exponent < 0)
+                        value /= exact_power_of_ten<T>(-exponent);
+                    else
+                        value *= exact_power_of_ten<T>(exponent);
+                    p_out = negative ? -value : value;
+                    return true;
+                }
+
+                // 4. 其余情况（长尾数、大指数）交给后备路径
+                return parse_floating_slow(p_begin, p_end, p_out);
+            }
+
+            /// @brief 格式化单个数字所需的最大字符数（含为整数值浮点数补上的 ".0"）。
+            inline constexpr size_t max_format_length = 32;
+
+            /**
+             * @brief 把整数格式化到 p_out，返回写入结束的位置。
+             * @param p_out 至少 max_format_length 字节的缓冲区。
+             */
+            template <typename T>
+            inline char *format_integer(char *p_out, T p_value) noexcept
+            {
+                static_assert(std::is_integral_v<T>, "T must be an integral type");
+                return std::to_chars(p_out, p_out + max_format_length, p_value).ptr;
+            }
+
+            /**
+             * @brief 以能精确往返的最短形式把浮点数格式化到 p_out，返回写入结束的位置。
+             *        结果总带有小数点或指数（如 "1.0"、"1e-09"），重新解析后仍是浮点数；
+             *        JSON 无法表示的 NaN / 无穷输出为 null。
+             *        float 按 float 自身的精度取最短形式（1.68f 输出为 "1.68"），而不是先扩展为 double。
+             * @param p_out 至少 max_format_length 字节的缓冲区。
+             */
+            template <typename T>
+            inline char *format_floating(char *p_out, T p_value) noexcept
+            {
+                static_assert(std::is_floating_point_v<T>, "T must be a floating point type");
+                if (!std::isfinite(p_value))
+                {
+                    std::memcpy(p_out, "null", 4);
+                    return p_out + 4;
+                }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+                char *end = std::to_chars(p_out, p_out + max_format_length, p_value).ptr;
+#else
+                // 没有浮点 to_chars 时，逐步提高精度直到能精确往返
+                char *end = p_out;
+                for (int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10; ++precision)
+                {
+                    end = p_out + std::snprintf(p_out, max_format_length, "%.*g", precision, static_cast<double>(p_value));
+                    const T parsed = std::is_same_v<T, float> ? static_cast<T>(std::strtof(p_out, nullptr))
+                                                              : static_cast<T>(std::strtod(p_out, nullptr));
+                    if (parsed == p_value)
+                        break;
+                }
+#endif
+                if (std::find_if(p_out, end, [](char ch)
+                                 { return ch == '.' || ch == 'e' || ch == 'E'; }) == end)
+                {
+                    *end++ = '.';
+                    *end++ = '0';
+                }
+                return end;
+            }
+
+            /**
+             * @brief 判断一个 double 能否无损地存为 float：数值能被 float 精确表示，
+             *        且 float 的最短形式重新解析后仍是同一个 double（因此序列化结果仍能往返）。
+             */
+            inline bool fits_float(double p_value) noexcept
+            {
+                const float narrowed = static_cast<float>(p_value);
+                if (static_cast<double>(narrowed) != p_value)
+                    return false;
+                char buffer[max_format_length];
+                char *end = format_floating(buffer, narrowed);
+                double parsed;
+                return parse_floating(buffer, end, parsed) && parsed == p_value;
+            }
+
+            /// @brief 把浮点数向零截断为 int64_t。非有限值或截断结果超出 [-2^63, 2^63) 时返回 false。
+            inline bool truncate_to_int64(double p_value, int64_t &p_out) noexcept
+            {
+                constexpr double limit = 9223372036854775808.0; // 2^63
+                if (!std::isfinite(p_value) || p_value < -limit || p_value >= limit)
+                    return false;
+                p_out = static_cast<int64_t>(p_value);
+                return true;
+            }
+
+            /// @brief 把浮点数向零截断为 uint64_t。非有限值、负数或不小于 2^64 时返回 false。
+            inline bool truncate_to_uint64(double p_value, uint64_t &p_out) noexcept
+            {
+                constexpr double limit = 18446744073709551616.0; // 2^64
+                if (!std::isfinite(p_value) || p_value < 0 || p_value >= limit)
+                    return false;
+                p_out = static_cast<uint64_t>(p_value);
+                return true;
+            }
+        }
+    }
+}
+
+#endif // INCLUDE_JSON_NUMBER
@@ -1,8 +1,16 @@
 #ifndef INCLUDE_JSON_OBJECT_POOL
 #define INCLUDE_JSON_OBJECT_POOL
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace pjh_std
 {
@@ -124,6 +132,229 @@ namespace pjh_std
             }
         };
 
+        /**
+         * @class ThreadCachedAllocator
+         * @brief 线程安全的定长对象分配器。每个线程持有自己的空闲链表，分配与释放在本线程内完成，无需任何同步；
+         *        本地链表超过 2 * BatchSize 个节点时，按批（BatchSize 个）交还给全局仓库（depot），
+         *        链表为空时再从仓库整批取回，仓库也为空才向系统申请新的内存块。
+         *        线程退出时剩余的节点（包括不足一批的部分）全部交还仓库。
+         *        因此在 A 线程分配、B 线程释放的对象最终会通过仓库回到各线程中复用，单个线程囤积的节点也有上限。
+         *
+         * 仓库的快速路径是固定数量的原子槽位，每个槽位存放一整批节点：放入用 CAS(nullptr → batch)，
+         * 取出用 exchange(nullptr)，取出时整批节点的所有权原子地转移，不存在 ABA 问题。
+         * 槽位已满或不足一批的节点放进加锁的溢出列表。向系统申请的内存块在进程退出时统一释放。
+         */
+        template <typename T, size_t BatchSize = 64>
+        class ThreadCachedAllocator
+        {
+            static_assert(BatchSize > 0, "BatchSize must be positive");
+
+            struct Node
+            {
+                Node *next;
+            };
+
+            /// @brief 每个槽位的大小与对齐：至少能放下一个 T 和一个链表指针。
+            static constexpr size_t slot_align = (std::max)(alignof(T), alignof(Node));
+            static constexpr size_t slot_size = ((std::max)(sizeof(T), sizeof(Node)) + slot_align - 1) / slot_align * slot_align;
+            /// @brief 全局仓库的槽位数。
+            static constexpr size_t depot_slots = 64;
+            /// @brief 线程本地链表的长度上限，超过时交还一批给仓库。
+            static constexpr size_t local_limit = 2 * BatchSize;
+
+            /// @brief 一条空闲节点链表及其长度。
+            struct Batch
+            {
+                Node *head;
+                size_t count;
+            };
+
+            /// @brief 所有线程共享的状态：批次仓库与向系统申请的内存块。
+            struct Shared
+            {
+                std::atomic<Node *> depot[depot_slots] = {}; // 每个槽位是一条恰好 BatchSize 个节点的链表
+                std::mutex overflow_mutex;                   // 保护溢出列表
+                std::vector<Batch> overflow;                 // 槽位已满时的整批节点，以及线程退出时不足一批的节点
+                std::atomic<size_t> overflow_size{0};        // 溢出列表的长度，为 0 时 pop 不必加锁
+                std::mutex chunks_mutex;                     // 只在申请新内存块时加锁
+                std::vector<void *> chunks;
+
+                ~Shared()
+                {
+                    for (void *chunk : chunks)
+                        ::free(chunk);
+                }
+
+                /// @brief 把一条链表放进仓库：整批的优先放进空闲的槽位，否则放进溢出列表。
+                void push(Batch p_batch) noexcept
+                {
+                    if (p_batch.count == BatchSize)
+                        for (auto &slot : depot)
+                        {
+                            Node *expected = nullptr;
+                            if (slot.load(std::memory_order_relaxed) == nullptr &&
+                                slot.compare_exchange_strong(expected, p_batch.head, std::memory_order_release, std::memory_order_relaxed))
+                                return;
+                        }
+                    std::lock_guard<std::mutex> lock(overflow_mutex);
+                    try
+                    {
+                        overflow.push_back(p_batch);
+                        overflow_size.store(overflow.size(), std::memory_order_relaxed);
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        // 无法记录时这些节点不再复用，随内存块在进程退出时释放
+                    }
+                }
+                /// @brief 从仓库取出一条链表，仓库为空时返回空链表。
+                Batch pop() noexcept
+                {
+                    for (auto &slot : depot)
+                        if (slot.load(std::memory_order_relaxed) != nullptr)
+                            if (Node *batch = slot.exchange(nullptr, std::memory_order_acquire))
+                                return {batch, BatchSize};
+                    if (overflow_size.load(std::memory_order_relaxed) == 0)
+                        return {nullptr, 0};
+                    std::lock_guard<std::mutex> lock(overflow_mutex);
+                    if (overflow.empty())
+                        return {nullptr, 0};
+                    Batch batch = overflow.back();
+                    overflow.pop_back();
+                    overflow_size.store(overflow.size(), std::memory_order_relaxed);
+                    return batch;
+                }
+                /// @brief 向系统申请一个能容纳 BatchSize 个槽位的内存块，并串成链表。
+                Node *allocate_chunk()
+                {
+                    void *chunk = ::malloc(slot_size * BatchSize);
+                    if (!chunk)
+                        throw std::bad_alloc();
+                    {
+                        std::lock_guard<std::mutex> lock(chunks_mutex);
+                        chunks.push_back(chunk);
+                    }
+                    char *base = static_cast<char *>(chunk);
+                    for (size_t idx = 0; idx + 1 < BatchSize; ++idx)
+                        reinterpret_cast<Node *>(base + idx * slot_size)->next = reinterpret_cast<Node *>(base + (idx + 1) * slot_size);
+                    reinterpret_cast<Node *>(base + (BatchSize - 1) * slot_size)->next = nullptr;
+                    return reinterpret_cast<Node *>(base);
+                }
+            };
+
+            /// @brief 线程本地的空闲链表。线程退出时把剩余节点（包括不足一批的部分）全部交还给仓库。
+            struct LocalCache
+            {
+                Node *head = nullptr;
+                size_t count = 0;
+
+                ~LocalCache()
+                {
+                    while (count >= BatchSize)
+                        shared().push({detach_batch(), BatchSize});
+                    if (count > 0)
+                        shared().push({head, count});
+                    head = nullptr;
+                    count = 0;
+                }
+
+                /// @brief 从链表头部摘下恰好 BatchSize 个节点。
+                Node *detach_batch() noexcept
+                {
+                    Node *batch = head, *tail = head;
+                    for (size_t idx = 1; idx < BatchSize; ++idx)
+                        tail = tail->next;
+                    head = tail->next;
+                    tail->next = nullptr;
+                    count -= BatchSize;
+                    return batch;
+                }
+            };
+
+            static Shared &shared()
+            {
+                static Shared instance;
+                return instance;
+            }
+            static LocalCache &local()
+            {
+                static thread_local LocalCache cache;
+                return cache;
+            }
+
+        public:
+            /// @brief 分配一个对象所需的内存。优先使用本线程的空闲链表。
+            T *allocate(size_t n)
+            {
+                if (n > slot_size)
+                    throw std::bad_alloc();
+                LocalCache &cache = local();
+                if (cache.head == nullptr)
+                {
+                    Batch batch = shared().pop();
+                    if (batch.head == nullptr)
+                        batch = {shared().allocate_chunk(), BatchSize};
+                    cache.head = batch.head;
+                    cache.count = batch.count;
+                }
+                Node *node = cache.head;
+                cache.head = node->next;
+                --cache.count;
+                return reinterpret_cast<T *>(node);
+            }
+
+            /// @brief 回收一个对象的内存到本线程的空闲链表，过长时整批交还给仓库。
+            void deallocate(T *ptr)
+            {
+                if (ptr == nullptr)
+                    return;
+                LocalCache &cache = local();
+                Node *node = reinterpret_cast<Node *>(ptr);
+                node->next = cache.head;
+                cache.head = node;
+                ++cache.count;
+                if (cache.count >= local_limit)
+                    shared().push({cache.detach_batch(), BatchSize});
+            }
+        };
+
+        /**
+         * @class DefaultInitAllocator
+         * @brief 在 std::allocator 的基础上，把无参的 construct 改为默认初始化而不是值初始化。
+         *        对 `std::vector<int>::resize` 这类操作来说，新元素不会再被清零，
+         *        适合“先按上限扩容、再用裸指针写入”的大块缓冲区。
+         */
+        template <typename T>
+        class DefaultInitAllocator : public std::allocator<T>
+        {
+            using base_traits = std::allocator_traits<std::allocator<T>>;
+
+        public:
+            template <typename U>
+            struct rebind
+            {
+                using other = DefaultInitAllocator<U>;
+            };
+
+            DefaultInitAllocator() noexcept = default;
+            template <typename U>
+            DefaultInitAllocator(const DefaultInitAllocator<U> &) noexcept {}
+
+            /// @brief 无参构造：默认初始化（对平凡类型来说即不做任何事）。
+            template <typename U>
+            void construct(U *ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+            {
+                ::new (static_cast<void *>(ptr)) U;
+            }
+            /// @brief 带参构造：与 std::allocator 相同。
+            template <typename U, typename... Args>
+            void construct(U *ptr, Args &&...args)
+            {
+                std::allocator<T> alloc;
+                base_traits::construct(alloc, ptr, std::forward<Args>(args)...);
+            }
+        };
+
         /**
          * @class ObjectPool
          * @brief 对象池，用于高效地管理特定类型对象的内存分配和回收。
@@ -0,0 +1,784 @@
+#ifndef INCLUDE_JSON_SIMD
+#define INCLUDE_JSON_SIMD
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PJH_JSON_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define PJH_JSON_SIMD_X86 0
+#endif
+
+// GCC/Clang 需要为使用特定指令集的函数单独开启 target，这样即使整体没有 -mavx2 也能在运行时按需分派；
+// MSVC 允许直接使用任意 intrinsic，无需额外标注。
+#if PJH_JSON_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define PJH_JSON_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define PJH_JSON_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PJH_JSON_TARGET_SSE42
+#define PJH_JSON_TARGET_AVX2
+#endif
+
+namespace pjh_std
+{
+    namespace json
+    {
+        namespace simd
+        {
+            /// @brief 可用的向量指令集级别，按从低到高排列。
+            enum class Level
+            {
+                Scalar, // 纯标量回退实现
+                SSE42,  // 16 字节宽的 SSE4.2 实现
+                AVX2    // 32 字节宽的 AVX2 实现
+            };
+
+            /// @brief 在运行时检测当前 CPU 支持的最高指令集级别（结果会被缓存）。
+            inline Level detect_level() noexcept
+            {
+                static const Level level = []() noexcept
+                {
+#if PJH_JSON_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+                    __builtin_cpu_init();
+                    if (__builtin_cpu_supports("avx2"))
+                        return Level::AVX2;
+                    if (__builtin_cpu_supports("sse4.2"))
+                        return Level::SSE42;
+                    return Level::Scalar;
+#elif PJH_JSON_SIMD_X86
+                    int info[4];
+                    __cpuid(info, 1);
+                    const bool sse42 = (info[2] & (1 << 20)) != 0;
+                    const bool osxsave = (info[2] & (1 << 27)) != 0;
+                    const bool avx = (info[2] & (1 << 28)) != 0;
+                    __cpuidex(info, 7, 0);
+                    const bool avx2 = (info[1] & (1 << 5)) != 0;
+                    // 还需要确认操作系统会保存 YMM 寄存器状态
+                    if (avx2 && avx && osxsave && (_xgetbv(0) & 0x6) == 0x6)
+                        return Level::AVX2;
+                    return sse42 ? Level::SSE42 : Level::Scalar;
+#else
+                    return Level::Scalar;
+#endif
+                }();
+                return level;
+            }
+
+            /// @brief 返回最低位 1 的下标，bits 不能为 0。
+            inline int trailing_zeros(uint64_t bits) noexcept
+            {
+#if defined(_MSC_VER) && !defined(__clang__)
+                unsigned long idx;
+                _BitScanForward64(&idx, bits);
+                return static_cast<int>(idx);
+#else
+                return __builtin_ctzll(bits);
+#endif
+            }
+
+            /// @brief 统计置位的个数。
+            inline int popcount(uint64_t bits) noexcept
+            {
+#if defined(_MSC_VER) && !defined(__clang__)
+                // 不依赖 POPCNT 指令的 SWAR 实现，保证在标量回退路径上也能运行
+                bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+                bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+                bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+                return static_cast<int>((bits * 0x0101010101010101ULL) >> 56);
+#else
+                return __builtin_popcountll(bits);
+#endif
+            }
+
+            /// @brief 前缀异或：第 i 位等于输入第 0..i 位的异或，用于由引号位置得到“字符串内部”掩码。
+            inline uint64_t prefix_xor(uint64_t bits) noexcept
+            {
+                bits ^= bits << 1;
+                bits ^= bits << 2;
+                bits ^= bits << 4;
+                bits ^= bits << 8;
+                bits ^= bits << 16;
+                bits ^= bits << 32;
+                return bits;
+            }
+
+            /**
+             * @struct BlockMasks
+             * @brief 一个 64 字节块的字符分类结果，第 i 位对应块内第 i 个字节。
+             */
+            struct BlockMasks
+            {
+                uint64_t quote;      // '"'
+                uint64_t backslash;  // '\\'
+                uint64_t whitespace; // ' ' '\t' '\n' '\r'
+                uint64_t op;         // '{' '}' '[' ']' ':' ','
+            };
+
+            /// @brief 标量实现中使用的字符类别。
+            enum CharClass : uint8_t
+            {
+                ClassOther = 0,
+                ClassQuote = 1,
+                ClassBackslash = 2,
+                ClassWhitespace = 4,
+                ClassOp = 8
+            };
+
+            /// @brief 256 项的字符类别表。
+            struct CharClassTable
+            {
+                uint8_t table[256];
+                constexpr CharClassTable() : table()
+                {
+                    table[static_cast<uint8_t>('"')] = ClassQuote;
+                    table[static_cast<uint8_t>('\\')] = ClassBackslash;
+                    table[static_cast<uint8_t>(' ')] = ClassWhitespace;
+                    table[static_cast<uint8_t>('\t')] = ClassWhitespace;
+                    table[static_cast<uint8_t>('\n')] = ClassWhitespace;
+                    table[static_cast<uint8_t>('\r')] = ClassWhitespace;
+                    table[static_cast<uint8_t>('{')] = ClassOp;
+                    table[static_cast<uint8_t>('}')] = ClassOp;
+                    table[static_cast<uint8_t>('[')] = ClassOp;
+                    table[static_cast<uint8_t>(']')] = ClassOp;
+                    table[static_cast<uint8_t>(':')] = ClassOp;
+                    table[static_cast<uint8_t>(',')] = ClassOp;
+                }
+            };
+            inline constexpr CharClassTable char_classes{};
+
+            /// @brief 标量实现：逐字节查表分类一个 64 字节块。
+            inline void classify_block_scalar(const char *p_block, BlockMasks &p_masks) noexcept
+            {
+                p_masks = {0, 0, 0, 0};
+                for (size_t idx = 0; idx < 64; ++idx)
+                {
+                    const uint8_t cls = char_classes.table[static_cast<uint8_t>(p_block[idx])];
+                    const uint64_t bit = uint64_t(1) << idx;
+                    if (cls & ClassQuote)
+                        p_masks.quote |= bit;
+                    if (cls & ClassBackslash)
+                        p_masks.backslash |= bit;
+                    if (cls & ClassWhitespace)
+                        p_masks.whitespace |= bit;
+                    if (cls & ClassOp)
+                        p_masks.op |= bit;
+                }
+            }
+
+            /// @brief 标量实现：返回 [p_begin, p_end) 中第一个非空白字符的位置。
+            inline const char *skip_whitespace_scalar(const char *p_begin, const char *p_end) noexcept
+            {
+                while (p_begin < p_end && char_classes.table[static_cast<uint8_t>(*p_begin)] == ClassWhitespace)
+                    ++p_begin;
+                return p_begin;
+            }
+
+            /// @brief 标量实现：返回 [p_begin, p_end) 中第一个 '"' 或 '\\' 的位置，找不到时返回 p_end。
+            inline const char *find_quote_or_backslash_scalar(const char *p_begin, const char *p_end) noexcept
+            {
+                while (p_begin < p_end && *p_begin != '"' && *p_begin != '\\')
+                    ++p_begin;
+                return p_begin;
+            }
+
+            /// @brief 标量实现：返回 [p_begin, p_end) 中第一个序列化时需要转义的字符（'"'、'\\' 或控制字符）的位置。
+            inline const char *find_escapable_scalar(const char *p_begin, const char *p_end) noexcept
+            {
+                while (p_begin < p_end && *p_begin != '"' && *p_begin != '\\' && static_cast<uint8_t>(*p_begin) >= 0x20)
+                    ++p_begin;
+                return p_begin;
+            }
+
+            /**
+             * @brief 标量实现：返回 [p_begin, p_end) 中第一个非法 UTF-8 序列的起始位置，全部合法时返回 p_end。
+             *        拒绝过长编码、代理项（U+D800..U+DFFF）、超出 U+10FFFF 的码点以及被截断的序列。
+             */
+            inline const char *find_utf8_error_scalar(const char *p_begin, const char *p_end) noexcept
+            {
+                const uint8_t *ptr = reinterpret_cast<const uint8_t *>(p_begin);
+                const uint8_t *end = reinterpret_cast<const uint8_t *>(p_end);
+                while (ptr < end)
+                {
+                    // 8 字节一组的 ASCII 快速路径
+                    if (end - ptr >= 8)
+                    {
+                        uint64_t word;
+                        std::memcpy(&word, ptr, sizeof(word));
+                        if ((word & 0x8080808080808080ULL) == 0)
+                        {
+                            ptr += 8;
+                            continue;
+                        }
+                    }
+                    const uint8_t lead = *ptr;
+                    if (lead < 0x80)
+                    {
+                        ++ptr;
+                        continue;
+                    }
+                    // 按首字节确定序列长度以及第二个字节的合法范围
+                    ptrdiff_t length;
+                    uint8_t low = 0x80, high = 0xBF;
+                    if (lead >= 0xC2 && lead <= 0xDF)
+                        length = 2;
+                    else if (lead >= 0xE0 && lead <= 0xEF)
+                    {
+                        length = 3;
+                        if (lead == 0xE0)
+                            low = 0xA0; // 过长编码
+                        else if (lead == 0xED)
+                            high = 0x9F; // 代理项
+                    }
+                    else if (lead >= 0xF0 && lead <= 0xF4)
+                    {
+                        length = 4;
+                        if (lead == 0xF0)
+                            low = 0x90; // 过长编码
+                        else if (lead == 0xF4)
+                            high = 0x8F; // 超出 U+10FFFF
+                    }
+                    else
+                        return reinterpret_cast<const char *>(ptr);
+                    if (end - ptr < length || ptr[1] < low || ptr[1] > high)
+                        return reinterpret_cast<const char *>(ptr);
+                    for (ptrdiff_t idx = 2; idx < length; ++idx)
+                        if ((ptr[idx] & 0xC0) != 0x80)
+                            return reinterpret_cast<const char *>(ptr);
+                    ptr += length;
+                }
+                return p_end;
+            }
+
+            /// @brief 标量实现：统计 [p_begin, p_end) 中字符 p_ch 出现的次数。
+            inline size_t count_char_scalar(const char *p_begin, const char *p_end, char p_ch) noexcept
+            {
+                size_t count = 0;
+                for (; p_begin < p_end; ++p_begin)
+                    count += *p_begin == p_ch;
+                return count;
+            }
+
+            /// @brief 标量实现：返回 [p_begin, p_end) 中第一个字符 p_ch 的位置，找不到时返回 p_end。
+            inline const char *find_char_scalar(const char *p_begin, const char *p_end, char p_ch) noexcept
+            {
+                while (p_begin < p_end && *p_begin != p_ch)
+                    ++p_begin;
+                return p_begin;
+            }
+
+#if PJH_JSON_SIMD_X86
+            // 向量分类使用 pshufb 查表：按字节的低 4 位查出“该位置可能的目标字符”，再与原字节比较。
+            // 空白表：低 4 位为 0/9/A/D 时分别对应 ' ' '\t' '\n' '\r'，其余位置填 0x80（不可能与低 4 位相同的字节相等）。
+            // 运算符表：与 (byte | 0x20) 比较，从而让 '[' / ']' 与 '{' / '}' 共用表项。
+            // 少数控制字符（0x0C、0x1A）会被误判为运算符，但它们在字符串外本身就不合法，Tokenizer 会报错。
+#define PJH_JSON_WS_TABLE ' ', '\x80', '\x80', '\x80', '\x80', '\x80', '\x80', '\x80', \
+                          '\x80', '\t', '\n', '\x80', '\x80', '\r', '\x80', '\x80'
+#define PJH_JSON_OP_TABLE 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ':', '{', ',', '}', 0, 0
+
+            /// @brief SSE4.2 实现：分类 16 字节并返回四类掩码的低 16 位。
+            PJH_JSON_TARGET_SSE42 inline void classify_16_sse42(__m128i p_in, uint32_t (&p_out)[4]) noexcept
+            {
+                const __m128i ws_table = _mm_setr_epi8(PJH_JSON_WS_TABLE);
+                const __m128i op_table = _mm_setr_epi8(PJH_JSON_OP_TABLE);
+                const __m128i ws = _mm_cmpeq_epi8(p_in, _mm_shuffle_epi8(ws_table, p_in));
+                const __m128i op = _mm_cmpeq_epi8(_mm_or_si128(p_in, _mm_set1_epi8(0x20)), _mm_shuffle_epi8(op_table, p_in));
+                p_out[0] = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(p_in, _mm_set1_epi8('"'))));
+                p_out[1] = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(p_in, _mm_set1_epi8('\\'))));
+                p_out[2] = static_cast<uint32_t>(_mm_movemask_epi8(ws));
+                p_out[3] = static_cast<uint32_t>(_mm_movemask_epi8(op));
+            }
+
+            /// @brief SSE4.2 实现：分类一个 64 字节块。
+            PJH_JSON_TARGET_SSE42 inline void classify_block_sse42(const char *p_block, BlockMasks &p_masks) noexcept
+            {
+                uint64_t masks[4] = {0, 0, 0, 0};
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    uint32_t out[4];
+                    classify_16_sse42(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_block + lane * 16)), out);
+                    for (int kind = 0; kind < 4; ++kind)
+                        masks[kind] |= uint64_t(out[kind]) << (lane * 16);
+                }
+                p_masks = {masks[0], masks[1], masks[2], masks[3]};
+            }
+
+            /// @brief AVX2 实现：分类 32 字节并返回四类掩码。
+            PJH_JSON_TARGET_AVX2 inline void classify_32_avx2(__m256i p_in, uint32_t (&p_out)[4]) noexcept
+            {
+                const __m256i ws_table = _mm256_setr_epi8(PJH_JSON_WS_TABLE, PJH_JSON_WS_TABLE);
+                const __m256i op_table = _mm256_setr_epi8(PJH_JSON_OP_TABLE, PJH_JSON_OP_TABLE);
+                const __m256i ws = _mm256_cmpeq_epi8(p_in, _mm256_shuffle_epi8(ws_table, p_in));
+                const __m256i op = _mm256_cmpeq_epi8(_mm256_or_si256(p_in, _mm256_set1_epi8(0x20)), _mm256_shuffle_epi8(op_table, p_in));
+                p_out[0] = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(p_in, _mm256_set1_epi8('"'))));
+                p_out[1] = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(p_in, _mm256_set1_epi8('\\'))));
+                p_out[2] = static_cast<uint32_t>(_mm256_movemask_epi8(ws));
+                p_out[3] = static_cast<uint32_t>(_mm256_movemask_epi8(op));
+            }
+
+            /// @brief AVX2 实现：分类一个 64 字节块。
+            PJH_JSON_TARGET_AVX2 inline void classify_block_avx2(const char *p_block, BlockMasks &p_masks) noexcept
+            {
+                uint32_t lo[4], hi[4];
+                classify_32_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_block)), lo);
+                classify_32_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_block + 32)), hi);
+                p_masks = {
+                    lo[0] | (uint64_t(hi[0]) << 32),
+                    lo[1] | (uint64_t(hi[1]) << 32),
+                    lo[2] | (uint64_t(hi[2]) << 32),
+                    lo[3] | (uint64_t(hi[3]) << 32)};
+            }
+
+            /// @brief SSE4.2 实现：每次检查 16 字节，返回第一个非空白字符的位置。
+            PJH_JSON_TARGET_SSE42 inline const char *skip_whitespace_sse42(const char *p_begin, const char *p_end) noexcept
+            {
+                const __m128i ws_table = _mm_setr_epi8(PJH_JSON_WS_TABLE);
+                while (p_end - p_begin >= 16)
+                {
+                    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_begin));
+                    const uint32_t ws = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(in, _mm_shuffle_epi8(ws_table, in))));
+                    if (ws != 0xFFFF)
+                        return p_begin + trailing_zeros(~ws & 0xFFFF);
+                    p_begin += 16;
+                }
+                return skip_whitespace_scalar(p_begin, p_end);
+            }
+
+            /// @brief AVX2 实现：每次检查 32 字节，返回第一个非空白字符的位置。
+            PJH_JSON_TARGET_AVX2 inline const char *skip_whitespace_avx2(const char *p_begin, const char *p_end) noexcept
+            {
+                const __m256i ws_table = _mm256_setr_epi8(PJH_JSON_WS_TABLE, PJH_JSON_WS_TABLE);
+                while (p_end - p_begin >= 32)
+                {
+                    const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_begin));
+                    const uint32_t ws = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(in, _mm256_shuffle_epi8(ws_table, in))));
+                    if (ws != 0xFFFFFFFFu)
+                        return p_begin + trailing_zeros(~ws);
+                    p_begin += 32;
+                }
+                return skip_whitespace_sse42(p_begin, p_end);
+            }
+
+            /// @brief SSE4.2 实现：每次检查 16 字节，返回第一个 '"' 或 '\\' 的位置。
+            PJH_JSON_TARGET_SSE42 inline const char *find_quote_or_backslash_sse42(const char *p_begin, const char *p_end) noexcept
+            {
+                const __m128i quote = _mm_set1_epi8('"');
+                const __m128i backslash = _mm_set1_epi8('\\');
+                while (p_end - p_begin >= 16)
+                {
+                    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_begin));
+                    const uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(
+                        _mm_or_si128(_mm_cmpeq_epi8(in, quote), _mm_cmpeq_epi8(in, backslash))));
+                    if (hits != 0)
+                        return p_begin + trailing_zeros(hits);
+                    p_begin += 16;
+                }
+                return find_quote_or_backslash_scalar(p_begin, p_end);
+            }
+
+            /// @brief AVX2 实现：每次检查 32 字节，返回第一个 '"' 或 '\\' 的位置。
+            PJH_JSON_TARGET_AVX2 inline const char *find_quote_or_backslash_avx2(const char *p_begin, const char *p_end) noexcept
+            {
+                const __m256i quote = _mm256_set1_epi8('"');
+                const __m256i backslash = _mm256_set1_epi8('\\');
+                while (p_end - p_begin >= 32)
+                {
+                    const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_begin));
+                    const uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(in, quote), _mm256_cmpeq_epi8(in, backslash))));
+                    if (hits != 0)
+                        return p_begin + trailing_zeros(hits);
+                    p_begin += 32;
+                }
+                return find_quote_or_backslash_sse42(p_begin, p_end);
+            }
+
+            /// @brief SSE4.2 实现：每次检查 16 字节，返回第一个需要转义的字符的位置。
+            PJH_JSON_TARGET_SSE42 inline const char *find_escapable_sse42(const char *p_begin, const char *p_end) noexcept
+            {
+                const __m128i quote = _mm_set1_epi8('"');
+                const __m128i backslash = _mm_set1_epi8('\\');
+                const __m128i control = _mm_set1_epi8(0x1F);
+                while (p_end - p_begin >= 16)
+                {
+                    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_begin));
+                    // 无符号比较 in <= 0x1F 等价于 min(in, 0x1F) == in
+                    const __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(in, control), in);
+                    const uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(
+                        is_control, _mm_or_si128(_mm_cmpeq_epi8(in, quote), _mm_cmpeq_epi8(in, backslash)))));
+                    if (hits != 0)
+                        return p_begin + trailing_zeros(hits);
+                    p_begin += 16;
+                }
+                return find_escapable_scalar(p_begin, p_end);
+            }
+
+            /// @brief AVX2 实现：每次检查 32 字节，返回第一个需要转义的字符的位置。
+            PJH_JSON_TARGET_AVX2 inline const char *find_escapable_avx2(const char *p_begin, const char *p_end) noexcept
+            {
+                const __m256i quote = _mm256_set1_epi8('"');
+                const __m256i backslash = _mm256_set1_epi8('\\');
+                const __m256i control = _mm256_set1_epi8(0x1F);
+                while (p_end - p_begin >= 32)
+                {
+                    const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_begin));
+                    const __m256i is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(in, control), in);
+                    const uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(
+                        is_control, _mm256_or_si256(_mm256_cmpeq_epi8(in, quote), _mm256_cmpeq_epi8(in, backslash)))));
+                    if (hits != 0)
+                        return p_begin + trailing_zeros(hits);
+                    p_begin += 32;
+                }
+                return find_escapable_sse42(p_begin, p_end);
+            }
+
+            /// @brief SSE4.2 实现：统计 [p_begin, p_end) 中字符 p_ch 出现的次数。
+            PJH_JSON_TARGET_SSE42 inline size_t count_char_sse42(const char *p_begin, const char *p_end, char p_ch) noexcept
+            {
+                const __m128i target = _mm_set1_epi8(p_ch);
+                size_t count = 0;
+                while (p_end - p_begin >= 16)
+                {
+                    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_begin));
+                    count += popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(in, target))));
+                    p_begin += 16;
+                }
+                return count + count_char_scalar(p_begin, p_end, p_ch);
+            }
+
+            /// @brief AVX2 实现：统计 [p_begin, p_end) 中字符 p_ch 出现的次数。
+            PJH_JSON_TARGET_AVX2 inline size_t count_char_avx2(const char *p_begin, const char *p_end, char p_ch) noexcept
+            {
+                const __m256i target = _mm256_set1_epi8(p_ch);
+                size_t count = 0;
+                while (p_end - p_begin >= 32)
+                {
+                    const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_begin));
+                    count += popcount(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(in, target))));
+                    p_begin += 32;
+                }
+                return count + count_char_sse42(p_begin, p_end, p_ch);
+            }
+
+            /// @brief SSE4.2 实现：每次检查 16 字节，返回第一个字符 p_ch 的位置。
+            PJH_JSON_TARGET_SSE42 inline const char *find_char_sse42(const char *p_begin, const char *p_end, char p_ch) noexcept
+            {
+                const __m128i target = _mm_set1_epi8(p_ch);
+                while (p_end - p_begin >= 16)
+                {
+                    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_begin));
+                    const uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(in, target)));
+                    if (hits != 0)
+                        return p_begin + trailing_zeros(hits);
+                    p_begin += 16;
+                }
+                return find_char_scalar(p_begin, p_end, p_ch);
+            }
+
+            /// @brief AVX2 实现：每次检查 32 字节，返回第一个字符 p_ch 的位置。
+            PJH_JSON_TARGET_AVX2 inline const char *find_char_avx2(const char *p_begin, const char *p_end, char p_ch) noexcept
+            {
+                const __m256i target = _mm256_set1_epi8(p_ch);
+                while (p_end - p_begin >= 32)
+                {
+                    const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_begin));
+                    const uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(in, target)));
+                    if (hits != 0)
+                        return p_begin + trailing_zeros(hits);
+                    p_begin += 32;
+                }
+                return find_char_sse42(p_begin, p_end, p_ch);
+            }
+
+            // UTF-8 校验使用 Keiser & Lemire 的查表法：每个字节与它前面 1~3 个字节一起，
+            // 由三次 pshufb 查表（前一字节的高 4 位 / 低 4 位、当前字节的高 4 位）得到各类错误的位掩码，
+            // 三者按位与后非零即说明这两个字节的组合非法；3、4 字节序列的后续字节再单独核对。
+            namespace utf8_tables
+            {
+                constexpr uint8_t too_short = 1 << 0;      // 11______ 0_______ 或 11______ 11______
+                constexpr uint8_t too_long = 1 << 1;       // 0_______ 10______
+                constexpr uint8_t overlong_3 = 1 << 2;     // 11100000 100_____
+                constexpr uint8_t too_large = 1 << 3;      // 11110100 1001____ 等超出 U+10FFFF 的组合
+                constexpr uint8_t surrogate = 1 << 4;      // 11101101 101_____
+                constexpr uint8_t overlong_2 = 1 << 5;     // 1100000_ 10______
+                constexpr uint8_t too_large_1000 = 1 << 6; // 11110101 1000____ 等
+                constexpr uint8_t overlong_4 = 1 << 6;     // 11110000 1000____
+                constexpr uint8_t two_conts = 1 << 7;      // 10______ 10______
+                constexpr uint8_t carry = too_short | too_long | two_conts;
+
+                alignas(16) inline constexpr uint8_t byte_1_high[16] = {
+                    too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+                    two_conts, two_conts, two_conts, two_conts,
+                    too_short | overlong_2,
+                    too_short,
+                    too_short | overlong_3 | surrogate,
+                    too_short | too_large | too_large_1000 | overlong_4};
+                alignas(16) inline constexpr uint8_t byte_1_low[16] = {
+                    carry | overlong_3 | overlong_2 | overlong_4,
+                    carry | overlong_2,
+                    carry,
+                    carry,
+                    carry | too_large,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000 | surrogate,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000};
+                alignas(16) inline constexpr uint8_t byte_2_high[16] = {
+                    too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+                    too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+                    too_long | overlong_2 | two_conts | overlong_3 | too_large,
+                    too_long | overlong_2 | two_conts | surrogate | too_large,
+                    too_long | overlong_2 | two_conts | surrogate | too_large,
+                    too_short, too_short, too_short, too_short};
+                // 向量最后 3 个字节若是多字节序列的开头，则序列延续到了下一个向量
+                alignas(32) inline constexpr uint8_t incomplete_max[32] = {
+                    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+                    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xEF, 0xDF, 0xBF};
+            }
+
+            /// @brief SSE4.2 实现：检查 16 字节 p_in（p_prev 为紧邻其前的 16 字节），返回非零即表示存在非法序列。
+            PJH_JSON_TARGET_SSE42 inline __m128i utf8_check_16_sse42(__m128i p_in, __m128i p_prev) noexcept
+            {
+                const __m128i low4 = _mm_set1_epi8(0x0F);
+                const __m128i prev1 = _mm_alignr_epi8(p_in, p_prev, 15);
+                const __m128i byte_1_high = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8_tables::byte_1_high)),
+                                                             _mm_and_si128(_mm_srli_epi16(prev1, 4), low4));
+                const __m128i byte_1_low = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8_tables::byte_1_low)),
+                                                            _mm_and_si128(prev1, low4));
+                const __m128i byte_2_high = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8_tables::byte_2_high)),
+                                                             _mm_and_si128(_mm_srli_epi16(p_in, 4), low4));
+                const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+                // 前 2 / 3 个字节是 3 / 4 字节序列的首字节时，当前字节必须是后续字节
+                const __m128i is_third = _mm_subs_epu8(_mm_alignr_epi8(p_in, p_prev, 14), _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+                const __m128i is_fourth = _mm_subs_epu8(_mm_alignr_epi8(p_in, p_prev, 13), _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+                const __m128i must_continue = _mm_and_si128(_mm_or_si128(is_third, is_fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+                return _mm_xor_si128(must_continue, special);
+            }
+
+            /// @brief SSE4.2 实现：以 64 字节为一组校验 UTF-8，返回第一个含错误的组的起始位置，全部合法时返回 p_end。
+            PJH_JSON_TARGET_SSE42 inline const char *find_utf8_error_block_sse42(const char *p_begin, const char *p_end) noexcept
+            {
+                const __m128i incomplete_max = _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf8_tables::incomplete_max + 16));
+                __m128i prev = _mm_setzero_si128();
+                __m128i prev_incomplete = _mm_setzero_si128();
+                char tail[64];
+                for (const char *group = p_begin; group < p_end; group += 64)
+                {
+                    // 最后一组不足 64 字节时以 0 填充，被截断的序列会被识别为 too_short
+                    const char *block = group;
+                    if (p_end - group < 64)
+                    {
+                        std::memset(tail, 0, sizeof(tail));
+                        std::memcpy(tail, group, static_cast<size_t>(p_end - group));
+                        block = tail;
+                    }
+                    __m128i in[4];
+                    for (int lane = 0; lane < 4; ++lane)
+                        in[lane] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + lane * 16));
+
+                    __m128i error;
+                    const __m128i any = _mm_or_si128(_mm_or_si128(in[0], in[1]), _mm_or_si128(in[2], in[3]));
+                    if (_mm_movemask_epi8(any) == 0)
+                    {
+                        // 整组都是 ASCII：只需确认上一组没有以未完成的序列结尾
+                        error = prev_incomplete;
+                        prev_incomplete = _mm_setzero_si128();
+                    }
+                    else
+                    {
+                        error = utf8_check_16_sse42(in[0], prev);
+                        error = _mm_or_si128(error, utf8_check_16_sse42(in[1], in[0]));
+                        error = _mm_or_si128(error, utf8_check_16_sse42(in[2], in[1]));
+                        error = _mm_or_si128(error, utf8_check_16_sse42(in[3], in[2]));
+                        prev_incomplete = _mm_subs_epu8(in[3], incomplete_max);
+                    }
+                    prev = in[3];
+                    if (!_mm_testz_si128(error, error))
+                        return group;
+                }
+                // 输入恰好以完整的组结束时，最后一组不能停在序列中间
+                if (!_mm_testz_si128(prev_incomplete, prev_incomplete))
+                    return p_end - 64;
+                return p_end;
+            }
+
+            /// @brief AVX2 实现：检查 32 字节 p_in（p_prev 为紧邻其前的 32 字节），返回非零即表示存在非法序列。
+            PJH_JSON_TARGET_AVX2 inline __m256i utf8_check_32_avx2(__m256i p_in, __m256i p_prev) noexcept
+            {
+                const __m256i low4 = _mm256_set1_epi8(0x0F);
+                // 跨 128 位通道拼接：得到“上一向量的高半部分 + 本向量的低半部分”，再按字节错位
+                const __m256i shifted = _mm256_permute2x128_si256(p_prev, p_in, 0x21);
+                const __m256i prev1 = _mm256_alignr_epi8(p_in, shifted, 15);
+                const __m256i byte_1_high = _mm256_shuffle_epi8(
+                    _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8_tables::byte_1_high))),
+                    _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low4));
+                const __m256i byte_1_low = _mm256_shuffle_epi8(
+                    _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8_tables::byte_1_low))),
+                    _mm256_and_si256(prev1, low4));
+                const __m256i byte_2_high = _mm256_shuffle_epi8(
+                    _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8_tables::byte_2_high))),
+                    _mm256_and_si256(_mm256_srli_epi16(p_in, 4), low4));
+                const __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+                const __m256i is_third = _mm256_subs_epu8(_mm256_alignr_epi8(p_in, shifted, 14), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+                const __m256i is_fourth = _mm256_subs_epu8(_mm256_alignr_epi8(p_in, shifted, 13), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+                const __m256i must_continue = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+                return _mm256_xor_si256(must_continue, special);
+            }
+
+            /// @brief AVX2 实现：以 64 字节为一组校验 UTF-8，返回第一个含错误的组的起始位置，全部合法时返回 p_end。
+            PJH_JSON_TARGET_AVX2 inline const char *find_utf8_error_block_avx2(const char *p_begin, const char *p_end) noexcept
+            {
+                const __m256i incomplete_max = _mm256_load_si256(reinterpret_cast<const __m256i *>(utf8_tables::incomplete_max));
+                __m256i prev = _mm256_setzero_si256();
+                __m256i prev_incomplete = _mm256_setzero_si256();
+                char tail[64];
+                for (const char *group = p_begin; group < p_end; group += 64)
+                {
+                    const char *block = group;
+                    if (p_end - group < 64)
+                    {
+                        std::memset(tail, 0, sizeof(tail));
+                        std::memcpy(tail, group, static_cast<size_t>(p_end - group));
+                        block = tail;
+                    }
+                    const __m256i in0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+                    const __m256i in1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+
+                    __m256i error;
+                    if (_mm256_movemask_epi8(_mm256_or_si256(in0, in1)) == 0)
+                    {
+                        error = prev_incomplete;
+                        prev_incomplete = _mm256_setzero_si256();
+                    }
+                    else
+                    {
+                        error = _mm256_or_si256(utf8_check_32_avx2(in0, prev), utf8_check_32_avx2(in1, in0));
+                        prev_incomplete = _mm256_subs_epu8(in1, incomplete_max);
+                    }
+                    prev = in1;
+                    if (!_mm256_testz_si256(error, error))
+                        return group;
+                }
+                if (!_mm256_testz_si256(prev_incomplete, prev_incomplete))
+                    return p_end - 64;
+                return p_end;
+            }
+
+#undef PJH_JSON_WS_TABLE
+#undef PJH_JSON_OP_TABLE
+#endif
+
+            /// @brief 按指令集级别分类一个 64 字节块。
+            inline void classify_block(Level p_level, const char *p_block, BlockMasks &p_masks) noexcept
+            {
+#if PJH_JSON_SIMD_X86
+                if (p_level == Level::AVX2)
+                    return classify_block_avx2(p_block, p_masks);
+                if (p_level == Level::SSE42)
+                    return classify_block_sse42(p_block, p_masks);
+#endif
+                classify_block_scalar(p_block, p_masks);
+            }
+
+            /// @brief 按指令集级别跳过一段空白字符，返回第一个非空白字符的位置（或 p_end）。
+            inline const char *skip_whitespace(Level p_level, const char *p_begin, const char *p_end) noexcept
+            {
+#if PJH_JSON_SIMD_X86
+                if (p_level == Level::AVX2)
+                    return skip_whitespace_avx2(p_begin, p_end);
+                if (p_level == Level::SSE42)
+                    return skip_whitespace_sse42(p_begin, p_end);
+#endif
+                return skip_whitespace_scalar(p_begin, p_end);
+            }
+
+            /// @brief 按指令集级别查找下一个 '"' 或 '\\'，找不到时返回 p_end。
+            inline const char *find_quote_or_backslash(Level p_level, const char *p_begin, const char *p_end) noexcept
+            {
+#if PJH_JSON_SIMD_X86
+                if (p_level == Level::AVX2)
+                    return find_quote_or_backslash_avx2(p_begin, p_end);
+                if (p_level == Level::SSE42)
+                    return find_quote_or_backslash_sse42(p_begin, p_end);
+#endif
+                return find_quote_or_backslash_scalar(p_begin, p_end);
+            }
+
+            /// @brief 按指令集级别查找下一个序列化时需要转义的字符，找不到时返回 p_end。
+            inline const char *find_escapable(Level p_level, const char *p_begin, const char *p_end) noexcept
+            {
+#if PJH_JSON_SIMD_X86
+                if (p_level == Level::AVX2)
+                    return find_escapable_avx2(p_begin, p_end);
+                if (p_level == Level::SSE42)
+                    return find_escapable_sse42(p_begin, p_end);
+#endif
+                return find_escapable_scalar(p_begin, p_end);
+            }
+
+            /**
+             * @brief 按指令集级别校验 [p_begin, p_end) 是否为合法的 UTF-8，返回第一个非法序列的起始位置，全部合法时返回 p_end。
+             *        向量实现只负责判断每 64 字节是否有错；发现错误后再从该组之前最近的字符边界起用标量实现定位。
+             */
+            inline const char *find_utf8_error(Level p_level, const char *p_begin, const char *p_end) noexcept
+            {
+                const char *group = p_end;
+#if PJH_JSON_SIMD_X86
+                if (p_level == Level::AVX2)
+                    group = find_utf8_error_block_avx2(p_begin, p_end);
+                else if (p_level == Level::SSE42)
+                    group = find_utf8_error_block_sse42(p_begin, p_end);
+                else
+#endif
+                    return find_utf8_error_scalar(p_begin, p_end);
+                if (group == p_end)
+                    return p_end;
+                // 出错的序列最多从组起点之前 3 个字节开始（例如被截断的序列）。更早开始的序列已在上一组中校验过，
+                // 因此退回 3 个字节后跳过属于它们的后续字节，从第一个字符边界开始定位
+                const char *start = group - (std::min)(group - p_begin, ptrdiff_t(3));
+                while (start < group && (static_cast<uint8_t>(*start) & 0xC0) == 0x80)
+                    ++start;
+                return find_utf8_error_scalar(start, p_end);
+            }
+
+            /// @brief 按指令集级别统计 [p_begin, p_end) 中字符 p_ch 出现的次数。
+            inline size_t count_char(Level p_level, const char *p_begin, const char *p_end, char p_ch) noexcept
+            {
+#if PJH_JSON_SIMD_X86
+                if (p_level == Level::AVX2)
+                    return count_char_avx2(p_begin, p_end, p_ch);
+                if (p_level == Level::SSE42)
+                    return count_char_sse42(p_begin, p_end, p_ch);
+#endif
+                return count_char_scalar(p_begin, p_end, p_ch);
+            }
+
+            /// @brief 按指令集级别查找字符 p_ch（例如按行切分时查找 '\n'），找不到时返回 p_end。
+            inline const char *find_char(Level p_level, const char *p_begin, const char *p_end, char p_ch) noexcept
+            {
+#if PJH_JSON_SIMD_X86
+                if (p_level == Level::AVX2)
+                    return find_char_avx2(p_begin, p_end, p_ch);
+                if (p_level == Level::SSE42)
+                    return find_char_sse42(p_begin, p_end, p_ch);
+#endif
+                return find_char_scalar(p_begin, p_end, p_ch);
+            }
+        }
+    }
+}
+
+#endif // INCLUDE_JSON_SIMD
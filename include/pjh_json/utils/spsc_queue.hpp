@@ -0,0 +1,220 @@
+#ifndef INCLUDE_JSON_SPSC_QUEUE
+#define INCLUDE_JSON_SPSC_QUEUE
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <pjh_json/utils/wait_point.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class SpscQueue
+         * @brief 高吞吐的单生产者-单消费者队列，可在解析器之外用于流水线各阶段之间传递数据。
+         *        与 LockFreeRingBuffer 相比：
+         *        - 容量向上取整为 2 的幂，下标只做掩码而不取模；读写计数单调递增，容量全部可用；
+         *        - 读写计数各占一条缓存行，并且各自缓存对方的计数，只有缓存的值显示“已满 / 已空”时才读取对方的缓存行；
+         *        - 元素在入队时移动构造、出队时析构，支持只能移动的类型；
+         *        - push_bulk / pop_bulk 一次搬运一批元素，每批只发布一次计数。
+         *        try_* 与 *_bulk 不会阻塞；push / pop 在队列满 / 空时先自旋再睡眠，close() 用于结束等待。
+         */
+        template <typename T>
+        class SpscQueue
+        {
+        private:
+            static constexpr size_t cache_line = 64;
+
+            size_t m_capacity;            // 容量（2 的幂）
+            size_t m_mask;                // m_capacity - 1
+            std::allocator<T> m_alloc;    // 槽位存储的分配器
+            T *m_slots;                   // 未初始化的槽位，[head, tail) 内的元素已构造
+            // 消费者独占的一行：读取计数与其缓存的写入计数
+            alignas(cache_line) std::atomic<size_t> m_head{0};
+            size_t m_cached_tail = 0;
+            // 生产者独占的一行：写入计数与其缓存的读取计数
+            alignas(cache_line) std::atomic<size_t> m_tail{0};
+            size_t m_cached_head = 0;
+            alignas(cache_line) std::atomic<bool> m_closed{false};
+            WaitPoint m_not_empty; // 消费者等待数据
+            WaitPoint m_not_full;  // 生产者等待空位
+
+        public:
+            /// @brief 构造函数。@param p_capacity 期望的容量，会向上取整为 2 的幂（至少为 2）。
+            explicit SpscQueue(size_t p_capacity = 1024)
+                : m_capacity(round_up(p_capacity)), m_mask(m_capacity - 1), m_slots(m_alloc.allocate(m_capacity)) {}
+
+            SpscQueue(const SpscQueue &) = delete;
+            SpscQueue &operator=(const SpscQueue &) = delete;
+
+            /// @brief 析构函数，析构仍在队列中的元素。
+            ~SpscQueue()
+            {
+                const size_t tail = m_tail.load(std::memory_order_relaxed);
+                for (size_t idx = m_head.load(std::memory_order_relaxed); idx != tail; ++idx)
+                    m_slots[idx & m_mask].~T();
+                m_alloc.deallocate(m_slots, m_capacity);
+            }
+
+        public:
+            /// @brief 队列的容量。
+            size_t capacity() const noexcept { return m_capacity; }
+            /// @brief 队列中元素个数的近似值（另一方可能正在修改）。
+            size_t size() const noexcept
+            {
+                return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+            }
+            /// @brief 队列是否为空（近似值）。
+            bool empty() const noexcept { return size() == 0; }
+
+        public:
+            /// @brief （生产者）原地构造一个元素入队，队列已满时返回 false。
+            template <typename... Args>
+            bool try_emplace(Args &&...args)
+            {
+                const size_t tail = m_tail.load(std::memory_order_relaxed);
+                if (free_slots(tail) == 0)
+                    return false;
+                ::new (static_cast<void *>(m_slots + (tail & m_mask))) T(std::forward<Args>(args)...);
+                publish_tail(tail + 1);
+                return true;
+            }
+            /// @brief （生产者）移动一个元素入队，队列已满时返回 false 且不移动。
+            bool try_push(T &&p_item) { return try_emplace(std::move(p_item)); }
+            /// @brief （生产者）拷贝一个元素入队，队列已满时返回 false。
+            bool try_push(const T &p_item) { return try_emplace(p_item); }
+
+            /**
+             * @brief （生产者）把 [p_items, p_items + p_count) 中尽可能多的元素移动入队。
+             * @return 实际入队的个数，即被移走的前缀长度。
+             */
+            size_t push_bulk(T *p_items, size_t p_count)
+            {
+                const size_t tail = m_tail.load(std::memory_order_relaxed);
+                const size_t count = (std::min)(p_count, free_slots(tail, p_count));
+                for (size_t idx = 0; idx < count; ++idx)
+                    ::new (static_cast<void *>(m_slots + ((tail + idx) & m_mask))) T(std::move(p_items[idx]));
+                if (count != 0)
+                    publish_tail(tail + count);
+                return count;
+            }
+
+            /// @brief （消费者）弹出一个元素并移动到 p_out，队列为空时返回 false。
+            bool try_pop(T &p_out)
+            {
+                const size_t head = m_head.load(std::memory_order_relaxed);
+                if (ready_slots(head) == 0)
+                    return false;
+                T &slot = m_slots[head & m_mask];
+                p_out = std::move(slot);
+                slot.~T();
+                publish_head(head + 1);
+                return true;
+            }
+
+            /**
+             * @brief （消费者）弹出至多 p_max 个元素，依次移动赋值给 *p_out++。
+             * @param p_out 输出迭代器，例如数组指针或 std::back_inserter。
+             * @return 实际弹出的个数。
+             */
+            template <typename OutputIt>
+            size_t pop_bulk(OutputIt p_out, size_t p_max)
+            {
+                const size_t head = m_head.load(std::memory_order_relaxed);
+                const size_t count = (std::min)(p_max, ready_slots(head, p_max));
+                for (size_t idx = 0; idx < count; ++idx)
+                {
+                    T &slot = m_slots[(head + idx) & m_mask];
+                    *p_out = std::move(slot);
+                    ++p_out;
+                    slot.~T();
+                }
+                if (count != 0)
+                    publish_head(head + count);
+                return count;
+            }
+
+        public:
+            /// @brief （生产者）阻塞地移动一个元素入队；队列已关闭时返回 false。
+            bool push(T &&p_item)
+            {
+                bool pushed = false;
+                m_not_full.wait([&]()
+                                { return closed() || (pushed = try_push(std::move(p_item))); });
+                return pushed;
+            }
+            /// @brief （消费者）阻塞地弹出一个元素；队列已关闭且已读空时返回 false。
+            bool pop(T &p_out)
+            {
+                bool popped = false;
+                m_not_empty.wait([&]()
+                                 { return (popped = try_pop(p_out)) || closed(); });
+                // 关闭前入队的元素仍然要交给消费者
+                return popped || try_pop(p_out);
+            }
+
+            /// @brief 关闭队列：唤醒双方的等待，之后阻塞的 push() 总是返回 false。
+            void close()
+            {
+                m_closed.store(true, std::memory_order_seq_cst);
+                m_not_empty.notify();
+                m_not_full.notify();
+            }
+            /// @brief 队列是否已关闭。
+            bool closed() const noexcept { return m_closed.load(std::memory_order_acquire); }
+
+        private:
+            /// @brief 向上取整为 2 的幂（至少为 2）。
+            static size_t round_up(size_t p_capacity) noexcept
+            {
+                size_t capacity = 2;
+                while (capacity < p_capacity)
+                    capacity <<= 1;
+                return capacity;
+            }
+
+            /// @brief （生产者）可写的空位数。缓存的读取计数已能满足 p_wanted 时不读取消费者的缓存行。
+            size_t free_slots(size_t p_tail, size_t p_wanted = 1) noexcept
+            {
+                size_t free = m_capacity - (p_tail - m_cached_head);
+                if (free < p_wanted)
+                {
+                    m_cached_head = m_head.load(std::memory_order_acquire);
+                    free = m_capacity - (p_tail - m_cached_head);
+                }
+                return free;
+            }
+            /// @brief （消费者）可读的元素数。缓存的写入计数已能满足 p_wanted 时不读取生产者的缓存行。
+            size_t ready_slots(size_t p_head, size_t p_wanted = 1) noexcept
+            {
+                size_t ready = m_cached_tail - p_head;
+                if (ready < p_wanted)
+                {
+                    m_cached_tail = m_tail.load(std::memory_order_acquire);
+                    ready = m_cached_tail - p_head;
+                }
+                return ready;
+            }
+
+            /// @brief 发布新的写入计数，并唤醒可能在等待的消费者。
+            void publish_tail(size_t p_tail)
+            {
+                m_tail.store(p_tail, std::memory_order_release);
+                m_not_empty.notify();
+            }
+            /// @brief 发布新的读取计数，并唤醒可能在等待的生产者。
+            void publish_head(size_t p_head)
+            {
+                m_head.store(p_head, std::memory_order_release);
+                m_not_full.notify();
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_SPSC_QUEUE
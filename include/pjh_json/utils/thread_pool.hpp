@@ -0,0 +1,173 @@
+#ifndef INCLUDE_JSON_THREAD_POOL
+#define INCLUDE_JSON_THREAD_POOL
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class ThreadPool
+         * @brief 固定数量工作线程的线程池。任务按提交顺序领取，通过 std::future 取得结果或异常。
+         *        析构时先执行完已提交的任务，再等待所有线程退出。
+         */
+        class ThreadPool
+        {
+        private:
+            std::vector<std::thread> m_workers;        // 工作线程
+            std::deque<std::function<void()>> m_tasks; // 等待执行的任务
+            std::mutex m_mutex;                        // 保护任务队列
+            std::condition_variable m_cond;            // 通知工作线程有新任务或需要退出
+            bool m_stop;                               // 是否正在析构
+
+        public:
+            /// @brief 构造函数。@param p_threads 线程数，为 0 时取硬件线程数。
+            explicit ThreadPool(size_t p_threads = 0) : m_stop(false)
+            {
+                if (p_threads == 0)
+                    p_threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+                m_workers.reserve(p_threads);
+                for (size_t idx = 0; idx < p_threads; ++idx)
+                    m_workers.emplace_back([this]()
+                                           { work(); });
+            }
+
+            ThreadPool(const ThreadPool &) = delete;
+            ThreadPool &operator=(const ThreadPool &) = delete;
+
+            /// @brief 析构函数，执行完剩余任务后等待所有线程退出。
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stop = true;
+                }
+                m_cond.notify_all();
+                for (auto &worker : m_workers)
+                    worker.join();
+            }
+
+        public:
+            /// @brief 工作线程的数量。
+            size_t size() const noexcept { return m_workers.size(); }
+
+            /// @brief 提交一个任务。@return 用于获取返回值（或任务抛出的异常）的 future。
+            template <typename Func>
+            std::future<std::invoke_result_t<std::decay_t<Func>>> submit(Func &&p_func)
+            {
+                using result_t = std::invoke_result_t<std::decay_t<Func>>;
+                // std::function 要求可拷贝，因此把只能移动的 packaged_task 放在 shared_ptr 中
+                auto task = std::make_shared<std::packaged_task<result_t()>>(std::forward<Func>(p_func));
+                std::future<result_t> result = task->get_future();
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_tasks.emplace_back([task]()
+                                         { (*task)(); });
+                }
+                m_cond.notify_one();
+                return result;
+            }
+
+            /**
+             * @brief 对 [0, p_count) 中的每个下标并行调用 p_func(idx)，全部完成后返回。
+             *        任务抛出异常时，等待其余任务结束后重新抛出下标最小的那个异常。
+             *        调用线程与工作线程一起领取下标，因此即使所有工作线程都在忙
+             *        （例如在本线程池的任务中调用），也不会因等待排队的任务而死锁。
+             */
+            template <typename Func>
+            void parallel_for(size_t p_count, Func &&p_func)
+            {
+                if (p_count == 0)
+                    return;
+                // 状态由排队的任务共同持有：调用方返回之后才开始执行的任务领不到下标，不会再访问 p_func
+                auto state = std::make_shared<ForState<std::remove_reference_t<Func>>>(p_func, p_count);
+                const size_t helpers = (std::min)(p_count - 1, size());
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    for (size_t idx = 0; idx < helpers; ++idx)
+                        m_tasks.emplace_back([state]()
+                                             { state->drain(); });
+                }
+                m_cond.notify_all();
+                state->drain();
+                // 下标领完之后还要等工作线程执行完已领取的下标，它们引用了调用方的栈
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->cond.wait(lock, [&state]()
+                                     { return state->done == state->count; });
+                }
+                for (auto &error : state->errors)
+                    if (error)
+                        std::rethrow_exception(error);
+            }
+
+        private:
+            /// @brief parallel_for 的共享状态：下标按领取顺序分给调用线程与工作线程。
+            template <typename Func>
+            struct ForState
+            {
+                Func &func;                             // 调用方的函数，只在领到下标时访问
+                const size_t count;                     // 下标总数
+                std::atomic<size_t> next;               // 下一个待领取的下标
+                std::vector<std::exception_ptr> errors; // 各下标抛出的异常
+                std::mutex mutex;                       // 保护 done
+                std::condition_variable cond;           // 全部下标完成时通知调用方
+                size_t done;                            // 已完成的下标数
+
+                ForState(Func &p_func, size_t p_count) : func(p_func), count(p_count), next(0), errors(p_count), done(0) {}
+
+                /// @brief 不断领取并执行下标，直到全部领完。
+                void drain()
+                {
+                    for (size_t idx = next.fetch_add(1); idx < count; idx = next.fetch_add(1))
+                    {
+                        try
+                        {
+                            func(idx);
+                        }
+                        catch (...)
+                        {
+                            errors[idx] = std::current_exception();
+                        }
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (++done == count)
+                            cond.notify_all();
+                    }
+                }
+            };
+
+            /// @brief 工作线程的主循环。
+            void work()
+            {
+                while (true)
+                {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_cond.wait(lock, [this]()
+                                    { return m_stop || !m_tasks.empty(); });
+                        if (m_tasks.empty())
+                            return;
+                        task = std::move(m_tasks.front());
+                        m_tasks.pop_front();
+                    }
+                    task();
+                }
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_THREAD_POOL
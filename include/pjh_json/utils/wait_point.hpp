@@ -0,0 +1,142 @@
+#ifndef INCLUDE_JSON_WAIT_POINT
+#define INCLUDE_JSON_WAIT_POINT
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "Synchronization.lib")
+#endif
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class WaitPoint
+         * @brief “先自旋、再睡眠”的等待点，供单生产者-单消费者的线程间交接使用。
+         *        等待方先忙等一小段时间（交接通常在微秒内完成），仍未就绪才通过 futex
+         *        （Windows 上为 WaitOnAddress，其他平台退回条件变量）挂起；
+         *        通知方只有在确实有线程睡眠时才进入内核，常态下只是一次原子加法。
+         */
+        class WaitPoint
+        {
+        public:
+            /// @brief 进入睡眠前的自旋次数。
+            static constexpr int spin_count = 2048;
+
+        private:
+            std::atomic<uint32_t> m_epoch{0};     // 每次通知加一，睡眠方以它作为 futex 的比较值
+            std::atomic<bool> m_sleeping{false}; // 是否有线程正在（或即将）睡眠
+#if !defined(__linux__) && !defined(_WIN32)
+            std::mutex m_mutex;
+            std::condition_variable m_cond;
+#endif
+
+        public:
+            WaitPoint() = default;
+            WaitPoint(const WaitPoint &) = delete;
+            WaitPoint &operator=(const WaitPoint &) = delete;
+
+        public:
+            /**
+             * @brief 等待直到 p_ready() 返回 true。
+             *        调用方负责在条件发生变化之后调用 notify()，且条件的写入需先于 notify()。
+             */
+            template <typename Pred>
+            void wait(Pred &&p_ready)
+            {
+                for (int spin = 0; spin < spin_count; ++spin)
+                {
+                    if (p_ready())
+                        return;
+                    pause();
+                }
+                while (true)
+                {
+                    const uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+                    m_sleeping.store(true, std::memory_order_seq_cst);
+                    // 宣布睡眠之后必须再检查一次条件（与 notify() 中的栅栏配对），避免与通知方错过彼此
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (p_ready())
+                        break;
+                    sleep(epoch);
+                    if (p_ready())
+                        break;
+                }
+                m_sleeping.store(false, std::memory_order_relaxed);
+            }
+
+            /// @brief 通知等待方条件可能已经变化。
+            void notify()
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!m_sleeping.load(std::memory_order_seq_cst))
+                    return;
+                m_epoch.fetch_add(1, std::memory_order_seq_cst);
+                wake();
+            }
+
+        private:
+            /// @brief 自旋时提示 CPU 让出流水线资源。
+            static void pause() noexcept
+            {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+                _mm_pause();
+#else
+                std::this_thread::yield();
+#endif
+            }
+
+            /// @brief 在 m_epoch 仍等于 p_epoch 时挂起当前线程。
+            void sleep(uint32_t p_epoch)
+            {
+#if defined(__linux__)
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&m_epoch), FUTEX_WAIT_PRIVATE, p_epoch, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+                ::WaitOnAddress(&m_epoch, &p_epoch, sizeof(p_epoch), INFINITE);
+#else
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cond.wait(lock, [&]()
+                            { return m_epoch.load(std::memory_order_seq_cst) != p_epoch; });
+#endif
+            }
+
+            /// @brief 唤醒所有睡眠在 m_epoch 上的线程。
+            void wake()
+            {
+#if defined(__linux__)
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&m_epoch), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+                ::WakeByAddressAll(&m_epoch);
+#else
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                }
+                m_cond.notify_all();
+#endif
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_WAIT_POINT
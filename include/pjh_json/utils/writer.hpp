@@ -0,0 +1,261 @@
+#ifndef INCLUDE_JSON_WRITER
+#define INCLUDE_JSON_WRITER
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <ostream>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <pjh_json/helpers/json_definition.hpp>
+#include <pjh_json/helpers/json_exception.hpp>
+
+namespace pjh_std
+{
+    namespace json
+    {
+        /**
+         * @class Sink
+         * @brief 序列化输出的去向。Writer 把字节攒在自己的缓冲区里，满了才整块交给 Sink。
+         */
+        class Sink
+        {
+        public:
+            virtual ~Sink() = default;
+            /// @brief 写出一整块数据，失败时抛出 SerializationException。
+            virtual void write(const char *p_data, size_t p_size) = 0;
+            /// @brief 把 Sink 自己缓冲的数据推送到底层设备。
+            virtual void flush() {}
+        };
+
+        /**
+         * @class FileSink
+         * @brief 写入 C 标准库的 FILE*（不负责关闭）。
+         */
+        class FileSink : public Sink
+        {
+        private:
+            FILE *m_file;
+
+        public:
+            explicit FileSink(FILE *p_file) : m_file(p_file) {}
+
+            void write(const char *p_data, size_t p_size) override
+            {
+                if (std::fwrite(p_data, 1, p_size, m_file) != p_size)
+                    throw SerializationException("fwrite failed");
+            }
+            void flush() override
+            {
+                if (std::fflush(m_file) != 0)
+                    throw SerializationException("fflush failed");
+            }
+        };
+
+        /**
+         * @class FdSink
+         * @brief 直接写入文件描述符（不负责关闭），绕过 stdio 的二次缓冲。
+         */
+        class FdSink : public Sink
+        {
+        private:
+            int m_fd;
+
+        public:
+            explicit FdSink(int p_fd) : m_fd(p_fd) {}
+
+            void write(const char *p_data, size_t p_size) override
+            {
+                while (p_size > 0)
+                {
+#if defined(_WIN32)
+                    const int chunk = p_size > 0x40000000 ? 0x40000000 : static_cast<int>(p_size);
+                    const int written = ::_write(m_fd, p_data, chunk);
+#else
+                    const ssize_t written = ::write(m_fd, p_data, p_size);
+#endif
+                    if (written < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        throw SerializationException(std::string("write failed: ") + std::strerror(errno));
+                    }
+                    p_data += written;
+                    p_size -= static_cast<size_t>(written);
+                }
+            }
+        };
+
+        /**
+         * @class StreamSink
+         * @brief 写入 std::ostream（不负责其生命周期）。
+         */
+        class StreamSink : public Sink
+        {
+        private:
+            std::ostream &m_os;
+
+        public:
+            explicit StreamSink(std::ostream &p_os) : m_os(p_os) {}
+
+            void write(const char *p_data, size_t p_size) override
+            {
+                if (!m_os.write(p_data, static_cast<std::streamsize>(p_size)))
+                    throw SerializationException("ostream write failed");
+            }
+            void flush() override { m_os.flush(); }
+        };
+
+        /**
+         * @class Writer
+         * @brief 序列化用的输出缓冲区，每个字节只写一次。
+         *        不绑定 Sink 时是一块按需倍增的内存缓冲区，可以反复 clear() 复用；
+         *        绑定 Sink 时是定长缓冲区，写满即整块交给 Sink，析构时写出剩余数据。
+         */
+        class Writer
+        {
+        public:
+            /// @brief 默认的初始缓冲区大小。
+            static constexpr size_t default_capacity = 4096;
+
+        private:
+            std::unique_ptr<char[]> m_buffer; // 输出缓冲区
+            size_t m_size;                    // 缓冲区中已写入的字节数
+            size_t m_capacity;                // 缓冲区容量
+            Sink *m_sink;                     // 输出去向，为空时只写入内存
+
+        public:
+            /// @brief 构造一个写入内存的 Writer。@param p_capacity 初始容量。
+            explicit Writer(size_t p_capacity = default_capacity)
+                : m_buffer(new char[p_capacity ? p_capacity : 1]), m_size(0), m_capacity(p_capacity ? p_capacity : 1), m_sink(nullptr) {}
+            /// @brief 构造一个写入 Sink 的 Writer。@param p_sink 输出去向（不转移所有权）。@param p_capacity 缓冲区大小。
+            explicit Writer(Sink &p_sink, size_t p_capacity = 64 * 1024)
+                : m_buffer(new char[p_capacity ? p_capacity : 1]), m_size(0), m_capacity(p_capacity ? p_capacity : 1), m_sink(&p_sink) {}
+
+            Writer(const Writer &) = delete;
+            Writer &operator=(const Writer &) = delete;
+
+            /// @brief 析构函数。绑定 Sink 时尽量把剩余数据交给 Sink（析构中不抛出异常，也不刷新 Sink）。
+            ~Writer()
+            {
+                if (m_sink != nullptr)
+                {
+                    try
+                    {
+                        drain();
+                    }
+                    catch (...)
+                    {
+                    }
+                }
+            }
+
+        public:
+            /// @brief 写入一个字符。
+            void put(char p_ch)
+            {
+                if (m_size == m_capacity)
+                    make_room(1);
+                m_buffer[m_size++] = p_ch;
+            }
+            /// @brief 写入 p_count 个相同的字符。
+            void put(char p_ch, size_t p_count)
+            {
+                while (p_count > 0)
+                {
+                    if (m_size == m_capacity)
+                        make_room(p_count);
+                    const size_t chunk = (std::min)(p_count, m_capacity - m_size);
+                    std::memset(m_buffer.get() + m_size, p_ch, chunk);
+                    m_size += chunk;
+                    p_count -= chunk;
+                }
+            }
+            /// @brief 写入一段字节。
+            void write(const char *p_data, size_t p_size)
+            {
+                if (m_capacity - m_size < p_size)
+                {
+                    // 绑定 Sink 时，不小于缓冲区大小的数据直接交给 Sink，无需再拷贝一次
+                    if (m_sink != nullptr && p_size >= m_capacity)
+                    {
+                        drain();
+                        m_sink->write(p_data, p_size);
+                        return;
+                    }
+                    make_room(p_size);
+                }
+                std::memcpy(m_buffer.get() + m_size, p_data, p_size);
+                m_size += p_size;
+            }
+            /// @brief 写入一个字符串视图。
+            void write(string_v_t p_str) { write(p_str.data(), p_str.size()); }
+
+            /**
+             * @brief 预留至少 p_size 字节的连续可写空间，返回写入位置，写完后调用 commit() 确认。
+             *        适合数字格式化这类需要直接写入缓冲区的场景。
+             */
+            char *reserve(size_t p_size)
+            {
+                if (m_capacity - m_size < p_size)
+                    make_room(p_size);
+                return m_buffer.get() + m_size;
+            }
+            /// @brief 确认通过 reserve() 写入的 p_size 字节。
+            void commit(size_t p_size) noexcept { m_size += p_size; }
+
+            /// @brief 把缓冲区中的数据交给 Sink 并刷新 Sink（只写内存时为空操作）。
+            void flush()
+            {
+                if (m_sink == nullptr)
+                    return;
+                drain();
+                m_sink->flush();
+            }
+
+        public:
+            /// @brief 获取缓冲区中尚未交给 Sink 的内容（只写内存时即全部输出）。
+            string_v_t view() const noexcept { return string_v_t(m_buffer.get(), m_size); }
+            /// @brief 以 string 的形式拷贝出缓冲区的内容。
+            string_t str() const { return string_t(m_buffer.get(), m_size); }
+            /// @brief 获取缓冲区中的字节数。
+            size_t size() const noexcept { return m_size; }
+            /// @brief 清空缓冲区（保留容量以便复用）。
+            void clear() noexcept { m_size = 0; }
+
+        private:
+            /// @brief 把缓冲区中的数据交给 Sink 并清空缓冲区。
+            void drain()
+            {
+                if (m_size > 0)
+                    m_sink->write(m_buffer.get(), m_size);
+                m_size = 0;
+            }
+
+            /// @brief 为接下来的 p_needed 字节腾出连续空间：绑定 Sink 时先写出已有数据，空间仍不足再扩容。
+            void make_room(size_t p_needed)
+            {
+                if (m_sink != nullptr)
+                    drain();
+                if (m_capacity - m_size >= p_needed)
+                    return;
+                size_t capacity = m_capacity * 2;
+                while (capacity - m_size < p_needed)
+                    capacity *= 2;
+                std::unique_ptr<char[]> buffer(new char[capacity]);
+                std::memcpy(buffer.get(), m_buffer.get(), m_size);
+                m_buffer = std::move(buffer);
+                m_capacity = capacity;
+            }
+        };
+    }
+}
+
+#endif // INCLUDE_JSON_WRITER
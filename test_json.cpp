@@ -5,9 +5,21 @@
 #include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <random>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <set>
 
 // 引入 JSON 解析器头文件
+#include <pjh_json/helpers/json_path.hpp>
 #include <pjh_json/parsers/json_parser.hpp>
+#include <pjh_json/parsers/json_document_builder.hpp>
+#include <pjh_json/parsers/json_lazy_document.hpp>
+#include <pjh_json/parsers/json_line_stream_parser.hpp>
+#include <pjh_json/parsers/json_push_parser.hpp>
+#include <pjh_json/utils/spsc_queue.hpp>
 #include <nlohmann/json.hpp>
 #include "rapidjson/document.h"
 
@@ -45,6 +57,19 @@ void functionWrapper(const std::string &func_name, std::function<void()> test_fu
     std::cout << "Spend " << duration.count() << " ms.\n";
 }
 
+/**
+ * @brief 当前 CPU 支持的全部指令集级别。直接调用 simd:: / escape:: 的函数不会自动降级，
+ *        超出 detect_level() 的级别会执行非法指令，因此测试只能遍历这些级别。
+ */
+std::vector<simd::Level> supported_levels()
+{
+    std::vector<simd::Level> levels;
+    for (auto level : {simd::Level::Scalar, simd::Level::SSE42, simd::Level::AVX2})
+        if (level <= simd::detect_level())
+            levels.push_back(level);
+    return levels;
+}
+
 /**
  * @brief 测试 Value 类的基本功能，包括构造、类型判断和值访问。
  */
@@ -174,6 +199,2305 @@ void test_parser()
     std::cout << "Parser tests passed.\n";
 }
 
+/**
+ * @brief 测试借用模式的 Parser：不拷贝输入，解析结果直接指向调用方的缓冲区。
+ */
+void test_parser_borrowed()
+{
+    std::cout << "Test: Parsing a caller-owned buffer without copying.\n";
+
+    // 1. 调用方持有的缓冲区
+    const std::string buffer = R"({"name": "Carol", "tags": ["a", "b"], "age": 41})";
+
+    // 2. 以 string_view 借用缓冲区进行解析
+    Parser parser{std::string_view(buffer)};
+    Ref root = parser.parse();
+
+    // 3. 字符串值的 string_view 应当直接指向原缓冲区
+    value_t name = root.get()->as_object()->get("name")->as_value()->get_value();
+    const char *name_ptr = name.get<string_v_t>().data();
+    assert(name_ptr >= buffer.data() && name_ptr < buffer.data() + buffer.size());
+    assert(root["name"].as_str() == "Carol");
+    assert(root["tags"][1].as_str() == "b");
+    assert(root["age"].as_int() == 41);
+
+    // 4. (const char *, size_t) 形式同样是借用
+    Parser span_parser(buffer.data(), buffer.size());
+    Ref span_root = span_parser.parse();
+    assert(span_root["tags"].size() == 2);
+
+    // 5. 拥有模式的 Tokenizer 被拷贝/移动后，Token 仍然指向有效的副本
+    Tokenizer owner(std::string(R"(["x"])"));
+    Parser copied(owner);
+    Parser moved(std::move(owner));
+    assert(copied.parse()[0].as_str() == "x");
+    assert(moved.parse()[0].as_str() == "x");
+
+    delete root.get();
+    delete span_root.get();
+
+    std::cout << "Borrowed parser tests passed.\n";
+}
+
+/**
+ * @brief 测试通过内存映射直接解析文件的入口 Parser::parse_file。
+ */
+void test_parse_file()
+{
+    std::cout << "Test: Parsing a memory-mapped file.\n";
+
+    // 1. 写出一个临时文件
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "pjh_json_parse_file_test.json";
+    {
+        std::ofstream ofs(path, std::ios::binary);
+        ofs << R"({"service": "ingest", "ports": [80, 443], "tls": true})";
+    }
+
+    // 2. 解析文件，Document 负责保持映射存活
+    {
+        Document doc = Parser::parse_file(path);
+        assert(doc["service"].as_str() == "ingest");
+        assert(doc["ports"].size() == 2);
+        assert(doc["ports"][1].as_int() == 443);
+        assert(doc["tls"].as_bool() == true);
+    }
+    std::filesystem::remove(path);
+
+    // 3. 文件不存在时抛出 FileException
+    bool thrown = false;
+    try
+    {
+        Parser::parse_file(path);
+    }
+    catch (const FileException &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "Parse file tests passed.\n";
+}
+
+/**
+ * @brief 测试 Document 自带的 Arena：节点整体分配、整体释放。
+ */
+void test_document_arena()
+{
+    std::cout << "Test: Arena-backed documents.\n";
+
+    // 1. Arena 本身：对齐、跨块的大分配与 reset
+    {
+        Arena arena(64);
+        for (size_t align : {1, 2, 8, 16, 64})
+        {
+            void *ptr = arena.allocate(3, align);
+            assert(reinterpret_cast<uintptr_t>(ptr) % align == 0);
+        }
+        char *big = static_cast<char *>(arena.allocate(10000, 8));
+        std::fill(big, big + 10000, 'x');
+        assert(arena.used() >= 10000 && arena.reserved() >= arena.used());
+        arena.reset();
+        assert(arena.used() == 0);
+    }
+
+    // 2. 拥有模式下文档共享输入副本，Parser 销毁后仍然可用
+    Document doc;
+    {
+        std::string json_text = R"({"name": "Dave", "scores": [1, 2, 3], "profile": {"city": "Paris"}})";
+        Parser parser(json_text);
+        doc = parser.parse_document();
+    }
+    assert(doc.arena() != nullptr && doc.get()->in_arena());
+    assert(doc["name"].as_str() == "Dave");
+    assert(doc["scores"][2].as_int() == 3);
+    assert(doc["profile"]["city"].as_str() == "Paris");
+
+    // 3. 向文档中插入同一 Arena 上的新节点，替换旧节点时不会单独释放 Arena 上的内存
+    Object *root = doc.get()->as_object();
+    Array *list = doc.create<Array>();
+    for (int i = 0; i < 100; ++i)
+        list->append_raw_ptr(doc.create<Value>(i));
+    root->insert_raw_ptr("scores", list);
+    assert(doc["scores"].size() == 100 && doc["scores"][99].as_int() == 99);
+    Object *wide = doc.create<Object>();
+    std::vector<std::string> keys;
+    for (int i = 0; i < 200; ++i)
+        keys.push_back("k" + std::to_string(i));
+    for (const auto &key : keys)
+        wide->insert_raw_ptr(key, doc.create<Value>(true));
+    root->insert_raw_ptr("wide", wide);
+    assert(doc["wide"].size() == 200 && doc["wide"]["k150"].as_bool());
+
+    // 4. 从 Arena 文档深拷贝出来的树位于堆上
+    Element *copied = doc.get()->copy();
+    assert(!copied->in_arena() && copied->as_object()->size() == root->size());
+    assert(!copied->as_object()->get("wide")->in_arena());
+    copied->clear();
+    delete copied;
+
+    // 5. 移动文档后原文档为空
+    Document moved = std::move(doc);
+    assert(doc.empty() && moved["name"].as_str() == "Dave");
+
+    // 6. 语法错误时不会泄漏 Arena
+    bool thrown = false;
+    try
+    {
+        Parser(std::string("[1, 2")).parse_document();
+    }
+    catch (const Exception &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 7. Arena 上以字符串构造的 Value 引用 Arena 上的副本；挂到 Arena 容器上的堆元素会在文档销毁时释放
+    {
+        Document owned = Parser(std::string(R"({"list": [1]})")).parse_document();
+        std::string text(100, 'x');
+        Value *str = owned.create<Value>(text);
+        text.assign(100, 'y');
+        assert(str->in_arena() && str->as_str() == std::string(100, 'x'));
+        assert(owned.create<Value>("literal")->as_str() == "literal");
+        assert(!owned.arena()->has_heap_refs());
+        bool rejected = false;
+        try
+        {
+            *str = Value(std::string("owning"));
+        }
+        catch (const TypeException &)
+        {
+            rejected = true;
+        }
+        assert(rejected && str->as_str() == std::string(100, 'x'));
+
+        Object *heap = new Object();
+        heap->insert("nested", std::string(100, 'z'));
+        Array *list = owned.get()->as_object()->get("list")->as_array();
+        list->append(std::string(100, 'w'));
+        list->append_raw_ptr(heap);
+        assert(owned.arena()->has_heap_refs());
+        // 释放 Arena 上的子树时，其中的堆元素同样会被释放
+        owned.get()->as_object()->insert_raw_ptr("list", owned.create<Value>(1));
+        list = owned.create<Array>();
+        list->append_raw_ptr(new Value(std::string(100, 'v')));
+        owned.get()->as_object()->insert_raw_ptr("tail", list);
+    }
+
+    std::cout << "Arena document tests passed.\n";
+}
+
+/**
+ * @brief 测试线程本地缓存的对象池：多线程并发解析，以及跨线程释放的内存能被复用。
+ */
+void test_concurrent_parsing()
+{
+    std::cout << "Test: Concurrent parsing with thread-cached pools.\n";
+
+    // 1. 多个线程同时在堆上解析与释放
+    const std::string json_text = R"({"id": 7, "tags": ["a", "b", "c"], "nested": {"x": [1, 2, {"y": null}]}})";
+    std::atomic<int> failures{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 8; ++t)
+        workers.emplace_back(
+            [&]()
+            {
+                for (int i = 0; i < 2000; ++i)
+                {
+                    Parser parser{std::string_view(json_text)};
+                    Ref root = parser.parse();
+                    if (root["id"].as_int() != 7 || root["tags"][2].as_str() != "c" || !root["nested"]["x"][2]["y"].is_null())
+                        ++failures;
+                    root.get()->clear();
+                    delete root.get();
+                }
+            });
+    for (auto &worker : workers)
+        worker.join();
+    assert(failures == 0);
+
+    // 2. 在一个线程分配、在另一个线程释放，释放的内存经由全局仓库回到新线程中复用
+    struct Probe
+    {
+        size_t payload[3];
+    };
+    ObjectPool<Probe, ThreadCachedAllocator<Probe>> pool;
+    std::vector<Probe *> produced;
+    std::thread producer(
+        [&]()
+        {
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                Probe *probe = pool.allocate(sizeof(Probe));
+                probe->payload[0] = i;
+                produced.push_back(probe);
+            }
+        });
+    producer.join();
+    assert(std::set<Probe *>(produced.begin(), produced.end()).size() == produced.size());
+    for (size_t i = 0; i < produced.size(); ++i)
+        assert(produced[i]->payload[0] == i);
+
+    std::thread consumer(
+        [&]()
+        {
+            for (Probe *probe : produced)
+                pool.deallocate(probe);
+        });
+    consumer.join();
+
+    const std::set<Probe *> freed(produced.begin(), produced.end());
+    size_t reused = 0;
+    std::thread reuser(
+        [&]()
+        {
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                Probe *probe = pool.allocate(sizeof(Probe));
+                reused += freed.count(probe);
+                pool.deallocate(probe);
+            }
+        });
+    reuser.join();
+    assert(reused > 0);
+
+    // 3. 线程退出时不足一批的节点同样交还仓库：另一个线程会取回它们，而不是申请新的内存块
+    struct Partial
+    {
+        size_t payload[3];
+    };
+    ObjectPool<Partial, ThreadCachedAllocator<Partial>> partial_pool;
+    Partial *first = nullptr;
+    std::thread holder([&]()
+                       { first = partial_pool.allocate(sizeof(Partial)); });
+    holder.join();
+    std::thread taker(
+        [&]()
+        {
+            // holder 的内存块中还剩 63 个节点，按顺序排在第一个节点之后
+            for (size_t i = 0; i < 63; ++i)
+            {
+                Partial *probe = partial_pool.allocate(sizeof(Partial));
+                assert(probe > first && probe < first + 64);
+            }
+        });
+    taker.join();
+
+    // 4. 大量释放超过仓库槽位的容量时，多出的节点进入溢出列表，而不是囤积在释放线程中
+    struct Burst
+    {
+        size_t payload[3];
+    };
+    ObjectPool<Burst, ThreadCachedAllocator<Burst>> burst_pool;
+    std::vector<Burst *> burst(10000);
+    std::thread burst_producer([&]()
+                               { for (auto &probe : burst) probe = burst_pool.allocate(sizeof(Burst)); });
+    burst_producer.join();
+    std::thread burst_consumer([&]()
+                               { for (Burst *probe : burst) burst_pool.deallocate(probe); });
+    burst_consumer.join();
+    const std::set<Burst *> burst_freed(burst.begin(), burst.end());
+    size_t burst_reused = 0;
+    std::thread burst_reuser([&]()
+                             { for (size_t i = 0; i < burst.size(); ++i) burst_reused += burst_freed.count(burst_pool.allocate(sizeof(Burst))); });
+    burst_reuser.join();
+    assert(burst_reused == burst.size());
+
+    std::cout << "Concurrent parsing tests passed.\n";
+}
+
+/**
+ * @brief 逐字节的参考实现，用来校验 StructuralIndex 的结果。
+ *        与向量实现一致：奇数个连续反斜杠之后的字符视为被转义（不区分是否在字符串内），
+ *        字符串外的反斜杠本身不合法，Tokenizer 会在它作为标量起点时报错。
+ */
+std::vector<uint32_t> reference_structurals(std::string_view text)
+{
+    std::vector<uint32_t> out;
+    bool in_string = false, prev_scalar = false, escaped = false;
+    for (size_t idx = 0; idx < text.size(); ++idx)
+    {
+        const char ch = text[idx];
+        const bool is_quote = ch == '"' && !escaped;
+        escaped = ch == '\\' && !escaped;
+        if (is_quote)
+            in_string = !in_string;
+
+        const bool is_op = std::string_view("{}[]:,").find(ch) != std::string_view::npos;
+        const bool is_ws = ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+        // 开引号计入字符串内部，闭引号不计入
+        const bool inside = in_string && !is_quote;
+        const bool is_scalar = !is_op && !is_ws && !is_quote && !in_string;
+        if (is_quote || (is_op && !inside) || (is_scalar && !prev_scalar))
+            out.push_back(idx);
+        prev_scalar = is_scalar;
+    }
+    return out;
+}
+
+/**
+ * @brief 测试 SIMD 结构索引：各指令集级别的结果与逐字节参考实现一致，且 Parser 可以基于索引解析。
+ */
+void test_structural_index()
+{
+    std::cout << "Test: SIMD structural index and indexed tokenizer.\n";
+
+    const simd::Level levels[] = {simd::Level::Scalar, simd::Level::SSE42, simd::Level::AVX2};
+
+    // 1. 随机输入（包含跨越 64 字节边界的反斜杠序列与引号），与参考实现逐项比较
+    std::mt19937 rng(20240611);
+    const char alphabet[] = "{}[]:,\" \\\\\\a1\n";
+    for (int round = 0; round < 500; ++round)
+    {
+        std::string text(1 + rng() % 300, ' ');
+        for (auto &ch : text)
+            ch = alphabet[rng() % (sizeof(alphabet) - 1)];
+        const auto expected = reference_structurals(text);
+        for (auto level : levels)
+        {
+            const StructuralIndex index(text, level);
+            assert(std::vector<uint32_t>(index.positions().begin(), index.positions().end()) == expected);
+        }
+    }
+
+    // 2. 基于索引进行完整解析
+    std::string json_text = R"({
+        "name": "Bob \"the builder\"",
+        "path": "C:\\",
+        "scores": [90, -85, 8.5, true, false, null],
+        "profile": { "city": "New York" }
+    })";
+    for (auto level : levels)
+    {
+        ParseOptions options;
+        options.structural_index = true;
+        options.simd_level = level;
+        Parser parser(json_text, options);
+        Ref root = parser.parse();
+        assert(root["name"].as_str() == "Bob \"the builder\"");
+        assert(root["path"].as_str() == "C:\\");
+        assert(root["scores"].size() == 6);
+        assert(root["scores"][1].as_int() == -85);
+        assert(root["scores"][3].as_bool() == true);
+        assert(root["scores"][5].is_null());
+        assert(root["profile"]["city"].as_str() == "New York");
+        delete root.get();
+    }
+
+    // 3. 索引模式下的错误同样会带上行列号
+    ParseOptions options;
+    options.structural_index = true;
+    const char *bad_inputs[] = {"[truex]", "{\n  \"a\": \"open", "[1, @]"};
+    for (const char *bad : bad_inputs)
+    {
+        bool thrown = false;
+        try
+        {
+            Parser(std::string(bad), options).parse();
+        }
+        catch (const ParseException &e)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    // 标量之后的反斜杠不在索引中，两种模式都必须在同一位置报错
+    const char *backslash_inputs[] = {"[1\\]", "{\"a\":true\\}", "[null\\,2]", "[1\\ ,2]", "1\\"};
+    for (const char *bad : backslash_inputs)
+    {
+        size_t offsets[2] = {0, 0};
+        for (int indexed = 0; indexed < 2; ++indexed)
+        {
+            ParseOptions mode;
+            mode.structural_index = indexed == 1;
+            bool thrown = false;
+            try
+            {
+                delete Parser(std::string(bad), mode).parse().get();
+            }
+            catch (const ParseException &e)
+            {
+                thrown = true;
+                offsets[indexed] = e.offset();
+            }
+            assert(thrown);
+        }
+        assert(offsets[0] == offsets[1]);
+    }
+    try
+    {
+        Parser(std::string("[1,\n  2,\n  x]"), options).parse();
+        assert(false);
+    }
+    catch (const ParseException &e)
+    {
+        assert(e.line() == 3 && e.column() == 3);
+    }
+
+    std::cout << "Structural index tests passed.\n";
+}
+
+/**
+ * @brief 测试向量化的空白跳过与字符串结尾查找，以及出错时延迟推算的行列号。
+ */
+void test_vectorized_scanning()
+{
+    std::cout << "Test: Vectorized whitespace skipping and string scanning.\n";
+
+    const simd::Level levels[] = {simd::Level::Scalar, simd::Level::SSE42, simd::Level::AVX2};
+
+    // 1. 不同长度的空白与带转义的长字符串，覆盖 16/32 字节边界前后的各种偏移
+    for (size_t pad = 0; pad < 70; ++pad)
+    {
+        const std::string spaces(pad, ' ');
+        const std::string body = std::string(pad, 'x') + "\\\"" + std::string(pad % 7, 'y') + "\\\\";
+        const std::string text = "{" + spaces + "\n\t\"k\"" + spaces + ":" + spaces + "\"" + body + "\"" + spaces + "}";
+        for (auto level : levels)
+        {
+            ParseOptions options;
+            options.simd_level = level;
+            Parser parser(text, options);
+            Ref root = parser.parse();
+            assert(root["k"].as_str() == std::string(pad, 'x') + "\"" + std::string(pad % 7, 'y') + "\\");
+            delete root.get();
+        }
+    }
+
+    // 2. 行列号只在抛出异常时根据偏移量推算
+    for (auto level : levels)
+    {
+        ParseOptions options;
+        options.simd_level = level;
+        try
+        {
+            Parser(std::string("{\n  \"a\": 1,\n      \"b\": ?\n}"), options).parse();
+            assert(false);
+        }
+        catch (const ParseException &e)
+        {
+            assert(e.line() == 3 && e.column() == 12);
+        }
+    }
+
+    std::cout << "Vectorized scanning tests passed.\n";
+}
+
+/**
+ * @brief 测试解析为扁平 Tape 的入口 Parser::parse_to_tape 及其只读游标 TapeRef。
+ */
+void test_tape()
+{
+    std::cout << "Test: Parsing into a flat tape.\n";
+
+    // 1. 解析到 Tape，且结果不依赖输入缓冲区
+    Tape tape;
+    {
+        std::string json_text = R"({
+            "name": "Bob",
+            "age": 25,
+            "isStudent": true,
+            "scores": [90, 85, 88],
+            "empty": [],
+            "nothing": null,
+            "profile": {"height": 1.75, "city": "New York", "tags": {}}
+        })";
+        Parser parser{std::string_view(json_text)};
+        tape = parser.parse_to_tape();
+    }
+
+    // 2. 与 Ref 类似的链式访问
+    TapeRef root = tape.root();
+    assert(root.is_object() && root.size() == 7);
+    assert(tape["name"].as_str() == "Bob");
+    assert(root["age"].as_int() == 25);
+    assert(root["isStudent"].as_bool() == true);
+    assert(root["nothing"].is_null());
+    assert(root["scores"].size() == 3 && root["scores"][2].as_int() == 88);
+    assert(root["empty"].is_array() && root["empty"].size() == 0);
+    assert(root["profile"]["height"].as_float() == 1.75f);
+    assert(root["profile"]["city"].as_str() == "New York");
+    assert(root["profile"]["tags"].size() == 0);
+
+    // 3. 遍历保持原文顺序，跳过子树为 O(1)
+    std::vector<string_v_t> keys;
+    for (auto it = root.begin(); it != root.end(); ++it)
+        keys.push_back(it.key());
+    assert(keys.size() == 7 && keys.front() == "name" && keys.back() == "profile");
+    int sum = 0;
+    for (TapeRef score : root["scores"])
+        sum += static_cast<int>(score.as_int());
+    assert(sum == 263);
+
+    // 4. 错误处理与 Ref 保持一致
+    bool thrown = false;
+    try
+    {
+        root["missing"];
+    }
+    catch (const InvalidKeyException &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try
+    {
+        root["scores"][3];
+    }
+    catch (const OutOfRangeException &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 5. 序列化结果与 DOM 一致（数组中没有无序的对象）
+    const std::string array_text = R"([1, 2.5, "s", true, false, null, [[]], [{"k": [3]}]])";
+    Parser dom_parser{std::string_view(array_text)};
+    Ref dom = dom_parser.parse();
+    Tape array_tape = Parser(array_text).parse_to_tape();
+    assert(array_tape.root().serialize() == dom.get()->serialize());
+    delete dom.get();
+
+    // 6. 语法错误同样带有位置
+    try
+    {
+        Parser(std::string("[1, 2 3]")).parse_to_tape();
+        assert(false);
+    }
+    catch (const ParseException &e)
+    {
+        assert(e.offset() == 6);
+    }
+
+    std::cout << "Tape tests passed.\n";
+}
+
+/**
+ * @brief 测试错误位置只在出错时由字节偏移推算行列号。
+ */
+void test_error_location()
+{
+    std::cout << "Test: Error location computed lazily from offset.\n";
+
+    // 1. 直接由偏移量构造异常
+    const std::string text = "[1,\n 2,\n\n   x]";
+    ParseException at_x(text, text.find('x'), "bad");
+    assert(at_x.line() == 4 && at_x.column() == 4 && at_x.offset() == text.find('x'));
+    ParseException at_begin(text, 0, "bad");
+    assert(at_begin.line() == 1 && at_begin.column() == 1);
+    ParseException past_end(text, text.size() + 10, "bad");
+    assert(past_end.line() == 4 && past_end.column() == 6);
+    assert(ParseException(1, 2, "bad").offset() == ParseException::npos);
+
+    // 2. 跨越多个向量块的长文本，各级指令集得到相同的行号
+    std::string long_text;
+    for (int i = 0; i < 300; ++i)
+        long_text += std::string(i % 50, ' ') + "\n";
+    long_text += "  @";
+    ParseException at_long(long_text, long_text.size() - 1, "bad");
+    assert(at_long.line() == 301 && at_long.column() == 3);
+
+    // 3. 解析器的语法错误同样带有位置
+    const std::pair<std::string, size_t> cases[] = {
+        {"{\"a\" 1}", 5},
+        {"{\n  1: 2}", 4},
+        {"[1,\n  2 3]", 8},
+        {"{\"a\": 1,\n \"b\": 2 ]", 17},
+    };
+    for (const auto &[input, offset] : cases)
+    {
+        for (bool indexed : {false, true})
+        {
+            ParseOptions options;
+            options.structural_index = indexed;
+            try
+            {
+                Parser(input, options).parse();
+                assert(false);
+            }
+            catch (const ParseException &e)
+            {
+                assert(e.offset() == offset);
+                ParseException expected(input, offset, "");
+                assert(e.line() == expected.line() && e.column() == expected.column());
+            }
+        }
+    }
+
+    std::cout << "Error location tests passed.\n";
+}
+
+/**
+ * @brief 测试数字解析：指数形式，以及快速路径与标准库逐位一致。
+ */
+void test_number_parsing()
+{
+    std::cout << "Test: Number parsing with exponents and the fast float path.\n";
+
+    // 1. 指数形式的数字
+    for (bool indexed : {false, true})
+    {
+        ParseOptions options;
+        options.structural_index = indexed;
+        const std::string text = "[1e10, 2.5E-3, -1E+2, 0.5e1, 12, -0, 3.25]";
+        Parser parser{std::string_view(text), options};
+        Ref root = parser.parse();
+        assert(root[0].is_float() && root[0].as_float() == 1e10f);
+        assert(root[1].as_float() == 2.5e-3f);
+        assert(root[2].as_float() == -100.0f);
+        assert(root[3].as_float() == 5.0f);
+        assert(root[4].is_int() && root[4].as_int() == 12);
+        assert(root[5].is_int() && root[5].as_int() == 0);
+        assert(root[6].as_float() == 3.25f);
+        delete root.get();
+    }
+
+    // 2. 与 strtod / strtof 逐位比较（覆盖快速路径与后备路径）
+    std::mt19937_64 rng(12345);
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string text = (rng() % 2) ? "-" : "";
+        text += std::to_string(rng() % (i % 3 == 0 ? 1000000000000000000ull : 100000ull));
+        if (rng() % 2)
+            text += "." + std::to_string(rng() % 1000000);
+        if (rng() % 2)
+            text += "e" + std::to_string(static_cast<int>(rng() % 80) - 40);
+
+        double as_double = 0;
+        float as_float = 0;
+        assert(number::parse_floating(text.data(), text.data() + text.size(), as_double));
+        assert(as_double == std::strtod(text.c_str(), nullptr));
+        // float 的范围较小，只比较不会上溢或下溢的数
+        if (as_double == 0 || (std::fabs(as_double) > 1e-30 && std::fabs(as_double) < 1e30))
+        {
+            assert(number::parse_floating(text.data(), text.data() + text.size(), as_float));
+            assert(as_float == std::strtof(text.c_str(), nullptr));
+        }
+    }
+    double huge = 0;
+    assert(!number::parse_floating<double>("1e400", "1e400" + 5, huge));
+
+    // 3. 不完整的数字在词法分析阶段就被拒绝
+    for (const char *bad : {"[1e]", "[1.]", "[-]", "[1e+]", "[.5]", "[-a]"})
+    {
+        for (bool indexed : {false, true})
+        {
+            ParseOptions options;
+            options.structural_index = indexed;
+            bool thrown = false;
+            try
+            {
+                Parser(bad, options).parse();
+            }
+            catch (const ParseException &)
+            {
+                thrown = true;
+            }
+            assert(thrown);
+        }
+    }
+
+    std::cout << "Number parsing tests passed.\n";
+}
+
+/**
+ * @brief 测试 64 位整数与双精度浮点数：解析器按能精确表示的最窄类型存储。
+ */
+void test_wide_numbers()
+{
+    std::cout << "Test: 64-bit integers and double precision.\n";
+
+    // 1. 解析时选择最窄的精确类型
+    const std::string text = "[2147483647, 2147483648, -2147483649, 9223372036854775807, 9223372036854775808,"
+                             " 18446744073709551615, 18446744073709551616, -9223372036854775808, 0.1, 0.5]";
+    Parser parser{std::string_view(text)};
+    Ref root = parser.parse();
+    auto holds = [&](size_t idx)
+    { return root[idx].get()->as_value()->get_value(); };
+    assert(holds(0).holds_alternative<int>() && root[0].as_int() == 2147483647);
+    assert(holds(1).holds_alternative<int64_t>() && root[1].as_int64() == 2147483648LL);
+    assert(root[2].as_int64() == -2147483649LL);
+    assert(root[3].as_int64() == (std::numeric_limits<int64_t>::max)());
+    assert(holds(4).holds_alternative<uint64_t>() && root[4].as_uint64() == 9223372036854775808ULL);
+    assert(root[5].is_int() && root[5].as_uint64() == (std::numeric_limits<uint64_t>::max)());
+    assert(root[6].is_float() && root[6].as_double() == 18446744073709551616.0);
+    assert(root[7].as_int64() == (std::numeric_limits<int64_t>::min)());
+    assert(holds(8).holds_alternative<double>() && root[8].as_double() == 0.1);
+    assert(holds(9).holds_alternative<float>() && root[9].as_double() == 0.5);
+
+    // 2. 超出目标类型范围时抛出 OutOfRangeException
+    auto out_of_range = [](auto &&func)
+    {
+        try
+        {
+            func();
+        }
+        catch (const OutOfRangeException &)
+        {
+            return true;
+        }
+        return false;
+    };
+    assert(out_of_range([&]()
+                        { root[1].as_int(); }));
+    assert(out_of_range([&]()
+                        { root[4].as_int64(); }));
+    assert(out_of_range([&]()
+                        { root[2].as_uint64(); }));
+    // 浮点数转换为整数前先检查范围：超出范围、NaN 与无穷大都抛出异常
+    assert(out_of_range([&]()
+                        { root[6].get()->as_value()->as_uint64(); }));
+    for (double bad : {1e20, -1e20, 9223372036854775808.0, std::nan(""), std::numeric_limits<double>::infinity()})
+    {
+        const Value value(bad);
+        assert(out_of_range([&]()
+                            { value.as_int64(); }));
+        assert(out_of_range([&]()
+                            { value.as_int(); }));
+    }
+    for (double bad : {1e20, 18446744073709551616.0, std::nan(""), std::numeric_limits<double>::infinity()})
+        assert(out_of_range([&]()
+                            { Value(bad).as_uint64(); }));
+    assert(Value(-9223372036854775808.0).as_int64() == (std::numeric_limits<int64_t>::min)());
+    assert(Value(18446744073709549568.0).as_uint64() == 18446744073709549568ULL);
+    assert(Value(-2.5f).as_int64() == -2);
+
+    // 3. 数字按数值比较，与存储类型无关
+    assert(Value(5) == Value(int64_t(5)) && Value(uint64_t(5)) == Value(5));
+    assert(Value(-1) != Value((std::numeric_limits<uint64_t>::max)()));
+    assert(Value(0.5f) == Value(0.5) && Value(0.1f) != Value(0.1));
+    assert(*root[4].get() == Value(uint64_t(9223372036854775808ULL)));
+
+    // 4. 序列化保持完整精度的整数
+    assert(root[5].get()->serialize() == "18446744073709551615");
+    assert(root[7].get()->serialize() == "-9223372036854775808");
+    delete root.get();
+
+    // 5. Tape 同样支持 64 位整数
+    Tape tape = Parser(text).parse_to_tape();
+    assert(tape[1].as_int() == 2147483648LL);
+    assert(tape[4].as_uint64() == 9223372036854775808ULL);
+    assert(tape[3].as_uint64() == 9223372036854775807ULL);
+    assert(out_of_range([&]()
+                        { tape[5].as_int(); }));
+    assert(out_of_range([&]()
+                        { tape[6].as_int(); }));
+    assert(out_of_range([&]()
+                        { tape[6].as_uint64(); }));
+    Tape huge = Parser(std::string("[1e20, -1e20, -9.5]")).parse_to_tape();
+    assert(out_of_range([&]()
+                        { huge[0].as_int(); }));
+    assert(out_of_range([&]()
+                        { huge[1].as_int(); }));
+    assert(huge[2].as_int() == -9);
+    assert(tape[8].as_float() == 0.1);
+
+    std::cout << "Wide number tests passed.\n";
+}
+
+/**
+ * @brief 测试流式序列化：Writer 的内存缓冲区与各种 Sink 输出相同的内容。
+ */
+void test_writer()
+{
+    std::cout << "Test: Streaming serialization.\n";
+
+    const std::string text = R"({"name": "pjh", "list": [1, -2, 3.5, true, false, null, {"deep": ["x", []]}], "big": 18446744073709551615})";
+    Parser parser{std::string_view(text)};
+    Ref root = parser.parse();
+    const std::string compact = root.get()->serialize();
+    const std::string pretty = root.get()->pretty_serialize(0, ' ');
+    assert(compact.size() > 50 && compact.front() == '{' && compact.back() == '}');
+
+    // 1. 内存 Writer：从 1 字节开始扩容，可以 clear() 后复用
+    Writer memory(1);
+    root.get()->serialize_to(memory);
+    assert(memory.view() == compact);
+    memory.clear();
+    root.get()->pretty_serialize_to(memory, 0, ' ');
+    assert(memory.str() == pretty);
+
+    // 2. 极小缓冲区的 StreamSink：分块写出后内容不变
+    std::ostringstream oss;
+    {
+        StreamSink sink(oss);
+        Writer writer(sink, 3);
+        root.get()->serialize_to(writer);
+        writer.write(std::string(10, '-'));
+    }
+    assert(oss.str() == compact + std::string(10, '-'));
+
+    // 3. FILE* 与文件描述符
+    FILE *file = std::tmpfile();
+    assert(file != nullptr);
+    {
+        FileSink file_sink(file);
+        Writer writer(file_sink, 16);
+        root.get()->serialize_to(writer);
+        writer.flush();
+
+        FdSink fd_sink(fileno(file));
+        Writer fd_writer(fd_sink, 16);
+        root.get()->pretty_serialize_to(fd_writer, 0, ' ');
+        fd_writer.flush();
+    }
+    std::string content(compact.size() + pretty.size(), '\0');
+    std::rewind(file);
+    assert(std::fread(content.data(), 1, content.size(), file) == content.size());
+    assert(content == compact + pretty);
+    std::fclose(file);
+
+    // 4. operator<< 直接写入流
+    std::ostringstream shown;
+    shown << root;
+    assert(shown.str() == pretty);
+
+    // 5. Tape 与 DOM 的输出一致
+    Tape tape = Parser(text).parse_to_tape();
+    Writer tape_writer;
+    tape.root()["list"].serialize_to(tape_writer);
+    assert(tape_writer.view() == root["list"].get()->serialize());
+    delete root.get();
+
+    std::cout << "Streaming serialization tests passed.\n";
+}
+
+/**
+ * @brief 测试数字的序列化：整数精确输出，浮点数以最短形式往返且不丢失类型。
+ */
+void test_number_formatting()
+{
+    std::cout << "Test: Number formatting.\n";
+
+    // 1. 浮点数使用最短的可往返表示，整数值补上 ".0"
+    assert(Value(1e-9).serialize() == "1e-09");
+    assert(Value(0.1).serialize() == "0.1");
+    assert(Value(0.5f).serialize() == "0.5");
+    // float 按自身精度取最短形式，而不是扩展为 double 后的 1.6799999475479126
+    Ref height = make_value(1.68f);
+    assert(height.get()->serialize() == "1.68" && Value(3.0f).serialize() == "3.0");
+    Element::release(height.get());
+    // 解析时只有 float 的最短形式仍能还原为同一个 double 时才存为 float
+    assert(number::fits_float(3.25) && !number::fits_float(0.1) && !number::fits_float(9223372036854775808.0));
+    assert(Value(1e-9f).serialize() == "1e-09" && Value(std::numeric_limits<float>::max()).serialize() == "3.4028235e+38");
+    assert(Value(100.0).serialize() == "100.0");
+    assert(Value(-0.0).serialize() == "-0.0");
+    assert(Value(1e21).serialize() == "1e+21");
+    assert(Value(std::nan("")).serialize() == "null");
+    assert(Value(-std::numeric_limits<double>::infinity()).serialize() == "null");
+    assert(Value(-42).serialize() == "-42");
+    assert(Value((std::numeric_limits<int64_t>::min)()).serialize() == "-9223372036854775808");
+
+    // 2. 随机浮点数经过 序列化 -> 解析 后数值不变
+    std::mt19937_64 rng(12);
+    std::uniform_int_distribution<uint64_t> bits;
+    Array array;
+    std::vector<double> expected;
+    while (expected.size() < 2000)
+    {
+        const uint64_t raw = bits(rng);
+        double number;
+        std::memcpy(&number, &raw, sizeof(number));
+        if (!std::isfinite(number))
+            continue;
+        expected.push_back(number);
+        array.append(number);
+    }
+    const std::string text = array.serialize();
+    array.clear();
+    Parser parser{std::string_view(text)};
+    Ref parsed = parser.parse();
+    assert(parsed.size() == expected.size());
+    for (size_t idx = 0; idx < expected.size(); ++idx)
+    {
+        assert(parsed[idx].is_float());
+        assert(parsed[idx].as_double() == expected[idx]);
+    }
+    delete parsed.get();
+
+    // 3. Tape 的输出与 DOM 一致
+    Tape tape = Parser(text).parse_to_tape();
+    assert(tape.root().serialize() == text);
+
+    std::cout << "Number formatting tests passed.\n";
+}
+
+/**
+ * @brief 测试字符串转义：解析时解码（含代理对），序列化时转义，不含转义的字符串保持零拷贝。
+ */
+void test_string_escapes()
+{
+    std::cout << "Test: String escapes.\n";
+
+    // 1. 解码各种转义序列，键同样会被解码
+    const std::string text = R"({"k\"ey": ["a\nb", "\"q\"", "caf\u00e9", "\ud83d\ude00", "plain", "\\\/\b\f\r\t", "\u0000"]})";
+    const std::string expected[] = {"a\nb", "\"q\"", "caf\xC3\xA9", "\xF0\x9F\x98\x80", "plain", "\\/\b\f\r\t", std::string(1, '\0')};
+    {
+        Parser parser{std::string_view(text)};
+        Ref root = parser.parse();
+        for (size_t idx = 0; idx < 7; ++idx)
+            assert(root["k\"ey"][idx].as_str() == expected[idx]);
+
+        // 不含转义的字符串直接引用输入，含转义的才拥有解码后的副本
+        const value_t &plain = root["k\"ey"][4].get()->as_value()->get_value();
+        assert(plain.holds_alternative<string_v_t>());
+        assert(plain.get<string_v_t>().data() >= text.data() && plain.get<string_v_t>().data() < text.data() + text.size());
+        assert(root["k\"ey"][0].get()->as_value()->get_value().holds_alternative<string_t>());
+
+        // 序列化结果重新转义，再次解析得到相同的内容
+        const std::string serialized = root.get()->serialize();
+        assert(serialized == R"({"k\"ey":["a\nb","\"q\"","caf)" "\xC3\xA9" R"(",")" "\xF0\x9F\x98\x80" R"(","plain","\\/\b\f\r\t","\u0000"]})");
+        delete root.get();
+    }
+
+    // 2. Document、Tape 与结构索引模式得到相同的解码结果
+    for (bool indexed : {false, true})
+    {
+        ParseOptions options;
+        options.structural_index = indexed;
+        Parser parser(text, options);
+        Document doc = parser.parse_document();
+        Object *obj = doc.get()->as_object();
+        Array *arr = (*obj)["k\"ey"]->as_array();
+        for (size_t idx = 0; idx < 7; ++idx)
+            assert((*arr)[idx]->as_value()->as_str() == expected[idx]);
+
+        Tape tape = Parser(text, options).parse_to_tape();
+        for (size_t idx = 0; idx < 7; ++idx)
+            assert(tape["k\"ey"][idx].as_str() == expected[idx]);
+    }
+
+    // 3. 非法转义与不成对的代理项
+    const char *bad_inputs[] = {R"(["\x"])", R"(["\u12G4"])", R"(["\ud800"])", R"(["\udc00"])", R"(["\ud800\u0041"])", R"(["\u00)"};
+    for (const char *bad : bad_inputs)
+    {
+        for (bool tape : {false, true})
+        {
+            bool thrown = false;
+            try
+            {
+                Parser parser{std::string_view(bad)};
+                if (tape)
+                    parser.parse_to_tape();
+                else
+                    delete parser.parse().get();
+            }
+            catch (const ParseException &e)
+            {
+                thrown = e.offset() >= 2 && e.offset() <= std::strlen(bad);
+            }
+            assert(thrown);
+        }
+    }
+
+    // 4. 随机字符串（含引号、反斜杠与控制字符）经过 序列化 -> 解析 后不变，覆盖各指令集级别
+    const std::vector<simd::Level> levels = supported_levels();
+    const char alphabet[] = "abc \"\\/\n\t\x01\x1f\x7f\xC3\xA9";
+    std::mt19937 rng(13);
+    for (int round = 0; round < 200; ++round)
+    {
+        std::string raw;
+        const size_t length = rng() % 100;
+        for (size_t idx = 0; idx < length; ++idx)
+            raw += alphabet[rng() % (sizeof(alphabet) - 1)];
+        Value value(raw);
+        const std::string json = value.serialize();
+        for (auto level : levels)
+        {
+            Writer writer;
+            escape::write_quoted(writer, raw, level);
+            assert(writer.view() == json);
+
+            ParseOptions options;
+            options.simd_level = level;
+            Parser parser("[" + json + "]", options);
+            Ref root = parser.parse();
+            assert(root[0].as_str() == raw);
+            delete root.get();
+        }
+    }
+
+    std::cout << "String escape tests passed.\n";
+}
+
+/**
+ * @brief 测试 UTF-8 校验：各指令集级别的结果与标量实现一致，错误以字节偏移报告。
+ */
+void test_utf8_validation()
+{
+    std::cout << "Test: UTF-8 validation.\n";
+
+    const std::vector<simd::Level> levels = supported_levels();
+    auto first_error = [](simd::Level level, const std::string &text)
+    { return static_cast<size_t>(simd::find_utf8_error(level, text.data(), text.data() + text.size()) - text.data()); };
+
+    // 1. 典型的合法与非法序列
+    const std::string valid[] = {"", "ascii", "caf\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF", "\xED\x9F\xBF"};
+    for (const auto &text : valid)
+        for (auto level : levels)
+            assert(first_error(level, text) == text.size());
+    const std::pair<std::string, size_t> invalid[] = {
+        {"ab\x80", 2},                // 孤立的后续字节
+        {"a\xC0\x80", 1},             // 过长的 2 字节编码
+        {"\xE0\x80\x80", 0},          // 过长的 3 字节编码
+        {"xy\xED\xA0\x80", 2},        // 代理项
+        {"\xF4\x90\x80\x80", 0},      // 超出 U+10FFFF
+        {"\xF5\x80\x80\x80", 0},      // 非法首字节
+        {"abc\xE2\x82", 3},           // 末尾被截断
+        {"\xC3\xA9\xC3(", 2},         // 缺少后续字节
+        {"\xF0\x9F\x98\x80\xFF", 4}}; // 0xFF 永远非法
+    for (const auto &[text, offset] : invalid)
+        for (auto level : levels)
+            assert(first_error(level, text) == offset);
+
+    // 2. 随机输入（合法字符中夹杂少量损坏字节）：向量实现与标量实现给出相同的偏移，覆盖 64 字节分组的各个边界
+    const std::string pieces[] = {"a", " ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF"};
+    std::mt19937 rng(14);
+    for (int round = 0; round < 3000; ++round)
+    {
+        std::string text;
+        const size_t target = rng() % 300;
+        while (text.size() < target)
+            text += pieces[rng() % 6];
+        if (round % 3 != 0 && !text.empty())
+            text[rng() % text.size()] = static_cast<char>(rng() % 256);
+        if (round % 5 == 0 && !text.empty())
+            text.pop_back();
+        const size_t expected = first_error(simd::Level::Scalar, text);
+        for (auto level : levels)
+            assert(first_error(level, text) == expected);
+    }
+
+    // 3. 解析时开启校验：普通模式与结构索引模式都报告第一个非法字节的偏移
+    std::string long_text = "[\"" + std::string(40000, 'x') + "\xC3\xA9\", \"bad \xC3\x28\"]";
+    for (bool indexed : {false, true})
+    {
+        for (auto level : levels)
+        {
+            ParseOptions options;
+            options.validate_utf8 = true;
+            options.structural_index = indexed;
+            options.simd_level = level;
+            try
+            {
+                Parser parser(long_text, options);
+                assert(false);
+            }
+            catch (const ParseException &e)
+            {
+                assert(e.offset() == long_text.find("\xC3\x28"));
+            }
+
+            // 合法的输入照常解析
+            Parser parser("{\"k\": \"caf\xC3\xA9\"}", options);
+            Ref root = parser.parse();
+            assert(root["k"].as_str() == "caf\xC3\xA9");
+            delete root.get();
+        }
+    }
+
+    // 4. 建立结构索引时发现非法序列即停止，不再为其后的输入建立索引
+    std::string early = "[\"\xFF\"";
+    for (int i = 0; i < 100000; ++i)
+        early += ",1";
+    early += "]";
+    StructuralIndex early_index;
+    early_index.build(early, simd::detect_level(), true);
+    assert(early_index.utf8_error() == 2 && early_index.size() < 100000 / 2);
+
+    // 5. 默认不校验，保持原有行为
+    Parser lenient(std::string("[\"\xFF\"]"));
+    Ref root = lenient.parse();
+    assert(root[0].as_str() == "\xFF");
+    delete root.get();
+
+    std::cout << "UTF-8 validation tests passed.\n";
+}
+
+/**
+ * @brief 测试两线程流水线解析（ParseOptions::pipelined）：结果与单线程一致，
+ *        后台线程中的词法错误在当前线程以相同的偏移重新抛出，语法错误时后台线程也能正常退出。
+ */
+void test_pipelined_parse()
+{
+    std::cout << "Test: Pipelined parsing.\n";
+
+    ParseOptions pipelined;
+    pipelined.pipelined = true;
+
+    // 1. 跨越多个 TokenBlock 的输入：DOM、Document、Tape 三种结果都与单线程相同
+    std::string text = "[";
+    for (int idx = 0; idx < 5000; ++idx)
+        text += "{\"id\": " + std::to_string(idx) + ", \"name\": \"n\\u00e9" + std::to_string(idx) +
+                "\", \"ok\": true, \"v\": [1.5, null]},";
+    text += "{}]";
+    assert(text.size() > 50 * TokenBlock::capacity);
+    const std::string expected = Parser(text).parse_document().get()->serialize();
+
+    Parser heap_parser(text, pipelined); // 堆模式下对象键指向 Parser 持有的输入，需要保持 Parser 存活
+    Ref root = heap_parser.parse();
+    assert(root.get()->serialize() == expected);
+    assert(root[4999]["name"].as_str() == "n\xC3\xA9" "4999");
+    delete root.get();
+    assert(Parser(std::string_view(text), pipelined).parse_document().get()->serialize() == expected);
+    // Tape 保留对象键的原始顺序，与单线程的 Tape 比较
+    assert(Parser(text, pipelined).parse_to_tape().root().serialize() == Parser(text).parse_to_tape().root().serialize());
+
+    // 2. 小输入（只有一个块）与单个值
+    for (const char *small : {"[]", "{\"a\": [1, 2, {\"b\": null}]}", "\"str\"", "42"})
+    {
+        Parser small_parser(small, pipelined);
+        Ref value = small_parser.parse();
+        assert(value.get()->serialize() == Parser(small).parse_document().get()->serialize());
+        delete value.get();
+    }
+
+    // 3. 词法错误发生在后台线程：以 ParseException 的形式在当前线程抛出，偏移与单线程相同
+    std::string bad_literal = text;
+    bad_literal.replace(bad_literal.rfind("true"), 4, "trux");
+    size_t serial_offset = 0;
+    try
+    {
+        Parser(bad_literal).parse_document();
+        assert(false);
+    }
+    catch (const ParseException &e)
+    {
+        serial_offset = e.offset();
+    }
+    try
+    {
+        Parser(bad_literal, pipelined).parse_document();
+        assert(false);
+    }
+    catch (const ParseException &e)
+    {
+        assert(e.offset() == serial_offset);
+    }
+
+    // 4. 语法错误发生在当前线程：后台线程可能仍在等待空位，析构时被唤醒并退出，不会挂起
+    std::string bad_syntax = text;
+    bad_syntax.replace(bad_syntax.find("\"ok\""), 4, "\"ok\" 1");
+    for (int round = 0; round < 20; ++round)
+    {
+        try
+        {
+            Parser(bad_syntax, pipelined).parse_to_tape();
+            assert(false);
+        }
+        catch (const ParseException &e)
+        {
+            assert(e.offset() == bad_syntax.find(" 1:") + 1);
+        }
+    }
+
+    // 5. 直接驱动 TokenPipeline（与硬件线程数无关）：只有两个块时双方频繁等待，Token 序列仍与 Tokenizer 一致
+    {
+        Tokenizer serial{std::string_view(text)};
+        Tokenizer background{std::string_view(text)};
+        TokenPipeline pipeline(background, 2);
+        while (true)
+        {
+            const Token expected_token = serial.peek();
+            const Token &token = pipeline.peek();
+            assert(token.type == expected_token.type && token.value == expected_token.value);
+            if (token.type == TokenType::End)
+                break;
+            serial.consume();
+            pipeline.consume();
+        }
+    }
+    {
+        Tokenizer background{std::string_view(bad_literal)};
+        bool thrown = false;
+        try
+        {
+            TokenPipeline pipeline(background, 2);
+            while (pipeline.peek().type != TokenType::End)
+                pipeline.consume();
+        }
+        catch (const ParseException &e)
+        {
+            thrown = e.offset() == serial_offset;
+        }
+        assert(thrown);
+    }
+    {
+        // 消费者提前放弃：析构时后台线程从等待中被唤醒并退出
+        Tokenizer background{std::string_view(text)};
+        TokenPipeline pipeline(background, 2);
+        pipeline.consume();
+    }
+
+    // 6. 按值 push / pop 的原有接口保持不变
+    LockFreeRingBuffer<int> ring(3);
+    assert(ring.push(1) && ring.push(2) && !ring.push(3));
+    assert(ring.peek().value() == 1);
+    assert(ring.pop() && ring.peek().value() == 2);
+    assert(ring.pop() && !ring.pop() && !ring.peek().has_value());
+
+    std::cout << "Pipelined parsing tests passed.\n";
+}
+
+/**
+ * @brief 测试单生产者-单消费者队列 SpscQueue：容量取整、批量移动、只能移动的类型，以及两线程下的顺序与关闭。
+ */
+void test_spsc_queue()
+{
+    std::cout << "Test: SPSC queue.\n";
+
+    // 1. 容量向上取整为 2 的幂，并且全部可用
+    SpscQueue<int> small(5);
+    assert(small.capacity() == 8 && small.empty());
+    for (int idx = 0; idx < 8; ++idx)
+        assert(small.try_push(idx));
+    assert(!small.try_push(8) && small.size() == 8);
+    int value = -1;
+    assert(small.try_pop(value) && value == 0);
+    assert(small.try_push(8));
+
+    // 2. 批量入队只移走能放下的前缀，批量出队按顺序移动到输出迭代器
+    std::vector<int> out;
+    assert(small.pop_bulk(std::back_inserter(out), 100) == 8);
+    assert(out == std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8}));
+    int batch[10] = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+    assert(small.push_bulk(batch, 10) == 8);
+    int drained[4];
+    assert(small.pop_bulk(drained, 4) == 4 && drained[0] == 10 && drained[3] == 13);
+    assert(small.push_bulk(batch + 8, 2) == 2 && small.size() == 6);
+
+    // 3. 只能移动的类型：入队时移动构造，队列析构时释放剩余元素
+    auto tracker = std::make_shared<int>(7);
+    {
+        SpscQueue<std::unique_ptr<std::shared_ptr<int>>> owned(4);
+        std::unique_ptr<std::shared_ptr<int>> items[3];
+        for (auto &item : items)
+            item = std::make_unique<std::shared_ptr<int>>(tracker);
+        assert(owned.push_bulk(items, 3) == 3);
+        assert(items[0] == nullptr && tracker.use_count() == 4);
+        std::unique_ptr<std::shared_ptr<int>> front;
+        assert(owned.try_pop(front) && **front == 7);
+        front.reset();
+        assert(tracker.use_count() == 3);
+    }
+    assert(tracker.use_count() == 1);
+
+    // 4. 两线程：生产者批量入队、消费者阻塞出队，元素不丢失、不重复、保持顺序
+    const size_t total = 200000;
+    SpscQueue<size_t> queue(64);
+    std::thread producer([&]()
+                         {
+        size_t chunk[37];
+        size_t next = 0;
+        while (next < total)
+        {
+            size_t count = 0;
+            while (count < 37 && next + count < total)
+            {
+                chunk[count] = next + count;
+                ++count;
+            }
+            size_t pushed = 0;
+            while (pushed < count)
+            {
+                const size_t moved = queue.push_bulk(chunk + pushed, count - pushed);
+                if (moved == 0)
+                    std::this_thread::yield();
+                pushed += moved;
+            }
+            next += count;
+        }
+        queue.close(); });
+    size_t expected = 0, item = 0;
+    while (queue.pop(item))
+        assert(item == expected++);
+    producer.join();
+    assert(expected == total && queue.empty());
+
+    // 5. 关闭后阻塞的 push 失败，已入队的元素仍可取出
+    SpscQueue<int> closing(2);
+    assert(closing.push(1));
+    closing.close();
+    assert(!closing.push(2));
+    assert(closing.pop(value) && value == 1 && !closing.pop(value));
+
+    std::cout << "SPSC queue tests passed.\n";
+}
+
+/**
+ * @brief 测试顶层数组的并行解析：切分点只落在顶层元素之间，拼接结果与单线程一致，出错时异常也一致。
+ */
+void test_parallel_parse()
+{
+    std::cout << "Test: Parallel parsing.\n";
+
+    // 1. 切分点：与逐字节扫描得到的顶层逗号比较。元素中夹杂字符串里的逗号、括号、转义引号与反斜杠
+    const std::string pieces[] = {"1", "\"a,b]}\"", "\"q\\\",[\"", "\"\\\\\"", "[1,[2,{\"k\":\",\"}]]", "{\"x\\\\\\\"\":[]}", "  "};
+    auto top_level_commas = [](const std::string &text)
+    {
+        std::set<size_t> commas;
+        int depth = 0;
+        bool in_string = false;
+        for (size_t idx = 0; idx < text.size(); ++idx)
+        {
+            const char ch = text[idx];
+            if (in_string)
+            {
+                if (ch == '\\')
+                    ++idx;
+                else if (ch == '"')
+                    in_string = false;
+            }
+            else if (ch == '"')
+                in_string = true;
+            else if (ch == '[' || ch == '{')
+                ++depth;
+            else if (ch == ']' || ch == '}')
+                --depth;
+            else if (ch == ',' && depth == 1)
+                commas.insert(idx);
+        }
+        return commas;
+    };
+    ThreadPool pool(3);
+    std::mt19937 rng(17);
+    for (int round = 0; round < 200; ++round)
+    {
+        std::string text = "[";
+        const int count = 1 + rng() % 60;
+        for (int idx = 0; idx < count; ++idx)
+            text += (idx ? "," : "") + pieces[rng() % 6] + pieces[6].substr(0, rng() % 3);
+        text += "]";
+        const std::set<size_t> expected = top_level_commas(text);
+        for (ThreadPool *executor : {static_cast<ThreadPool *>(nullptr), &pool})
+        {
+            std::vector<size_t> commas;
+            assert(ArraySplitter::split(text, 1 + rng() % 40, executor, commas));
+            for (size_t idx = 0; idx < commas.size(); ++idx)
+                assert(expected.count(commas[idx]) && (idx == 0 || commas[idx] > commas[idx - 1]));
+        }
+    }
+    std::vector<size_t> commas;
+    assert(!ArraySplitter::split("[\"unclosed, 1]", 4, nullptr, commas) && commas.empty());
+    assert(!ArraySplitter::split("[[1, 2], 3", 4, nullptr, commas));
+
+    // 2. 足够大的顶层数组：并行结果与单线程相同，且确实被切成了多段
+    std::string text = "[";
+    for (int idx = 0; text.size() < 4 * Parser::parallel_min_chunk; ++idx)
+        text += "{\"id\": " + std::to_string(idx) + ", \"s\": \"a,b]\\\"}\\\\\", \"t\\u00e9\": [1, {\"n\": null}]},\n";
+    text += "[]]";
+    assert(ArraySplitter::split(text, 4, &pool, commas) && commas.size() == 3);
+    const std::string expected = Parser(std::string_view(text)).parse_document().get()->serialize();
+    for (size_t threads : {size_t(2), size_t(3), size_t(4)})
+    {
+        Document doc = Parser::parse_parallel(text, threads);
+        assert(doc.get()->serialize() == expected);
+    }
+    Document doc = Parser::parse_parallel(text, pool);
+    assert(doc[0]["s"].as_str() == "a,b]\"}\\" && doc[1]["t\xC3\xA9"][1]["n"].is_null());
+    // 各段 Arena 上的容器在合并后仍可修改
+    doc[2]["t\xC3\xA9"].get()->as_array()->append_raw_ptr(doc.create<Value>(3));
+    assert(doc[2]["t\xC3\xA9"].size() == 3);
+    // 在线程池自己的任务中并行解析：所有工作线程都在等待时由调用线程完成剩余的段，不会死锁
+    std::vector<std::future<size_t>> nested;
+    for (size_t idx = 0; idx < pool.size(); ++idx)
+        nested.push_back(pool.submit([&]()
+                                     { return Parser::parse_parallel(text, pool).get()->as_array()->size(); }));
+    for (auto &result : nested)
+        assert(result.get() == doc.get()->as_array()->size());
+
+    // 3. 不是顶层数组或输入较小时退回单线程解析
+    assert(Parser::parse_parallel("{\"a\": [1, 2]}", pool)["a"][1].as_int() == 2);
+    assert(Parser::parse_parallel(" [ ] ", pool).get()->as_array()->size() == 0);
+
+    // 4. 出错时抛出与单线程相同的异常（类型、消息与位置都相同）
+    std::string broken = text;
+    broken.replace(broken.rfind("null"), 4, "nul!");
+    std::string unclosed = text;
+    unclosed.erase(unclosed.rfind("\\\\\""), 3);
+    for (const std::string &bad : {broken, unclosed, text.substr(0, text.size() - 3) + "]"})
+    {
+        std::string serial_error;
+        try
+        {
+            Parser(std::string_view(bad)).parse_document();
+        }
+        catch (const Exception &e)
+        {
+            serial_error = e.what();
+        }
+        assert(!serial_error.empty());
+        try
+        {
+            Parser::parse_parallel(bad, pool);
+            assert(false);
+        }
+        catch (const Exception &e)
+        {
+            assert(e.what() == serial_error);
+        }
+    }
+
+    std::cout << "Parallel parsing tests passed.\n";
+}
+
+/**
+ * @brief 测试 NDJSON 流式读取：跨块的记录、空行、顺序与乱序交付、错误定位与管道输入。
+ */
+void test_line_stream_parser()
+{
+    std::cout << "Test: Line stream parsing.\n";
+
+    // 1. 写出一个临时文件：记录长短不一，夹杂空行与 \r\n；块很小，许多记录会跨越块边界
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "pjh_json_line_stream_test.ndjson";
+    std::string text;
+    std::vector<size_t> record_lines;
+    size_t line = 0;
+    for (int idx = 0; idx < 3000; ++idx, ++line)
+    {
+        if (idx % 97 == 5)
+        {
+            text += idx % 2 ? "   \n" : "\r\n";
+            ++line;
+        }
+        record_lines.push_back(line);
+        text += "{\"id\": " + std::to_string(idx) + ", \"s\": \"a\\nb\", \"pad\": \"" + std::string(idx % 300, 'x') + "\"}";
+        text += idx % 3 ? "\n" : "\r\n";
+    }
+    text += "[\"no trailing newline\"]";
+    record_lines.push_back(line);
+    {
+        std::ofstream ofs(path, std::ios::binary);
+        ofs << text;
+    }
+
+    LineStreamOptions options;
+    options.block_size = 4096;
+    options.batch_size = 1024;
+    options.threads = 3;
+
+    // 2. 顺序交付：行号与内容都与输入一致，记录在 batch 释放前有效
+    std::vector<LineRecord> kept;
+    {
+        LineStreamParser reader(path, options);
+        size_t count = reader.for_each([&](const LineRecord &record)
+                                       {
+                                           assert(record.line == record_lines[kept.size()]);
+                                           if (kept.size() < 3000)
+                                           {
+                                               assert(record.value()["id"].as_int() == static_cast<int64_t>(kept.size()));
+                                               assert(record.value()["s"].as_str() == "a\nb");
+                                           }
+                                           kept.push_back(record); });
+        assert(count == 3001);
+    }
+    // 读取器销毁后记录仍然可用
+    assert(kept[2999].value()["pad"].as_str().size() == 2999 % 300);
+    assert(kept[3000].value()[0].as_str() == "no trailing newline");
+    kept.clear();
+
+    // 3. 乱序交付：记录集合不变
+    options.ordered = false;
+    {
+        LineStreamParser reader(path, options);
+        std::set<int64_t> ids;
+        LineRecord record;
+        while (reader.next(record))
+            if (record.element->is_object())
+                ids.insert(record.value()["id"].as_int());
+        assert(ids.size() == 3000 && *ids.rbegin() == 2999);
+    }
+    options.ordered = true;
+
+    // 4. 某行出错：异常给出整个输入中的行号、列号与偏移，捕获后可以继续读取
+    {
+        std::ofstream ofs(path, std::ios::binary);
+        ofs << "{\"a\": 1}\n\n[1, tru, 3]\n{\"b\": 2}\n";
+    }
+    {
+        LineStreamParser reader(path, options);
+        LineRecord record;
+        assert(reader.next(record) && record.value()["a"].as_int() == 1);
+        bool thrown = false;
+        try
+        {
+            reader.next(record);
+        }
+        catch (const ParseException &e)
+        {
+            thrown = true;
+            assert(e.line() == 3 && e.column() == 5 && e.offset() == 14);
+        }
+        assert(thrown);
+        assert(reader.next(record) && record.line == 3 && record.value()["b"].as_int() == 2);
+        assert(!reader.next(record));
+    }
+    // 一行中值之后的多余内容（第二条记录、多余的括号）同样按错误报告，不会被悄悄丢弃
+    {
+        std::ofstream ofs(path, std::ios::binary);
+        ofs << "{\"a\":1} {\"b\":2}\n[1,2]]]garbage\n{\"c\": 3}  \n";
+    }
+    {
+        LineStreamParser reader(path, options);
+        LineRecord record;
+        const size_t offsets[] = {8, 21};
+        for (size_t expected : offsets)
+        {
+            bool thrown = false;
+            try
+            {
+                reader.next(record);
+            }
+            catch (const ParseException &e)
+            {
+                thrown = true;
+                assert(e.offset() == expected && e.message() == "Unexpected content after the JSON value");
+            }
+            assert(thrown);
+        }
+        assert(reader.next(record) && record.line == 2 && record.value()["c"].as_int() == 3);
+        assert(!reader.next(record));
+    }
+    std::filesystem::remove(path);
+
+    // 5. 从文件描述符（管道）读取，写入端在另一个线程中分多次写入
+#if !defined(_WIN32)
+    int fds[2];
+    assert(::pipe(fds) == 0);
+    std::thread writer([&]()
+                       {
+                           for (int idx = 0; idx < 500; ++idx)
+                           {
+                               const std::string row = "[" + std::to_string(idx) + ", \"" + std::string(idx % 50, 'y') + "\"]\n";
+                               // 每条记录分两次写入，读取端会看到被截断的行
+                               const size_t half = row.size() / 2;
+                               assert(::write(fds[1], row.data(), half) == static_cast<ssize_t>(half));
+                               assert(::write(fds[1], row.data() + half, row.size() - half) == static_cast<ssize_t>(row.size() - half));
+                           }
+                           ::close(fds[1]); });
+    {
+        LineStreamParser reader(fds[0], options);
+        int64_t expected = 0;
+        reader.for_each([&](const LineRecord &record)
+                        { assert(record.value()[0].as_int() == expected++); });
+        assert(expected == 500);
+    }
+    writer.join();
+    ::close(fds[0]);
+#endif
+
+    // 6. 文件不存在时抛出 FileException
+    bool thrown = false;
+    try
+    {
+        LineStreamParser reader(path, options);
+    }
+    catch (const FileException &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "Line stream parsing tests passed.\n";
+}
+
+/**
+ * @brief 测试 SAX 接口：事件顺序、数字分类、转义解码，以及与 DOM 一致的错误。
+ */
+void test_sax_parse()
+{
+    std::cout << "Test: SAX parsing.\n";
+
+    // 1. 把事件记录为字符串，检查顺序与内容
+    struct Recorder : SaxHandler
+    {
+        std::string log;
+        void on_null() { log += "null "; }
+        void on_bool(bool v) { log += v ? "true " : "false "; }
+        void on_int(int64_t v) { log += "i" + std::to_string(v) + " "; }
+        void on_uint(uint64_t v) { log += "u" + std::to_string(v) + " "; }
+        void on_double(double v) { log += "d" + std::to_string(v) + " "; }
+        void on_string(string_v_t v) { log += "s:" + std::string(v) + " "; }
+        void on_key(string_v_t v) { log += "k:" + std::string(v) + " "; }
+        void on_start_object() { log += "{ "; }
+        void on_end_object(size_t n) { log += "}" + std::to_string(n) + " "; }
+        void on_start_array() { log += "[ "; }
+        void on_end_array(size_t n) { log += "]" + std::to_string(n) + " "; }
+    };
+    const std::string text = R"({"a\tb": [1, -2, 18446744073709551615, 2.5, 1e300, "xé", true, null], "e": {}, "f": []})";
+    Recorder recorder;
+    Parser(std::string_view(text)).parse_sax(recorder);
+    assert(recorder.log == "{ k:a\tb [ i1 i-2 u18446744073709551615 d2.500000 d" + std::to_string(1e300) + " s:x\xC3\xA9 true null ]8 "
+                           "k:e { }0 k:f [ ]0 }3 ");
+
+    // 2. 只关心部分事件的处理器：统计与求和，不构建任何节点
+    struct Summer : SaxHandler
+    {
+        int64_t sum = 0;
+        size_t strings = 0;
+        void on_int(int64_t v) { sum += v; }
+        void on_string(string_v_t) { ++strings; }
+    };
+    std::string rows = "[";
+    for (int idx = 0; idx < 1000; ++idx)
+        rows += (idx ? ", " : "") + std::string("{\"id\": ") + std::to_string(idx) + ", \"tag\": \"t\\n\"}";
+    rows += "]";
+    Summer summer;
+    Parser(std::string_view(rows)).parse_sax(summer);
+    assert(summer.sum == 999 * 1000 / 2 && summer.strings == 1000);
+
+    // 流水线模式下事件相同
+    ParseOptions pipelined;
+    pipelined.pipelined = true;
+    Summer piped;
+    Parser(std::string_view(rows), pipelined).parse_sax(piped);
+    assert(piped.sum == summer.sum && piped.strings == summer.strings);
+
+    // 3. 出错时抛出与 DOM 解析相同的异常
+    for (const char *bad : {"{\"a\": 1,}", "[1, 2", "{\"a\" 1}", "[tru]"})
+    {
+        std::string dom_error, sax_error;
+        try
+        {
+            Parser(std::string_view(bad)).parse_document();
+        }
+        catch (const Exception &e)
+        {
+            dom_error = e.what();
+        }
+        try
+        {
+            SaxHandler ignore;
+            Parser(std::string_view(bad)).parse_sax(ignore);
+        }
+        catch (const Exception &e)
+        {
+            sax_error = e.what();
+        }
+        assert(!dom_error.empty() && dom_error == sax_error);
+    }
+
+    std::cout << "SAX parsing tests passed.\n";
+}
+
+/**
+ * @brief 测试增量解析：任意切块方式下的事件、DOM 与错误都与一次性解析相同。
+ */
+void test_push_parser()
+{
+    std::cout << "Test: Push parsing.\n";
+
+    // 把事件记录为字符串
+    struct Recorder : SaxHandler
+    {
+        std::string log;
+        void on_null() { log += "n,"; }
+        void on_bool(bool v) { log += v ? "t," : "f,"; }
+        void on_int(int64_t v) { log += "i" + std::to_string(v) + ","; }
+        void on_uint(uint64_t v) { log += "u" + std::to_string(v) + ","; }
+        void on_double(double v) { log += "d" + std::to_string(v) + ","; }
+        void on_string(string_v_t v) { log += "s:" + std::string(v) + ","; }
+        void on_key(string_v_t v) { log += "k:" + std::string(v) + ","; }
+        void on_start_object() { log += "{"; }
+        void on_end_object(size_t n) { log += "}" + std::to_string(n) + ","; }
+        void on_start_array() { log += "["; }
+        void on_end_array(size_t n) { log += "]" + std::to_string(n) + ","; }
+    };
+    auto feed_in_chunks = [](auto &parser, const std::string &text, size_t chunk)
+    {
+        for (size_t pos = 0; pos < text.size(); pos += chunk)
+        {
+            // 每块拷贝到独立的缓冲区，确保解析器没有保留指向旧块的视图
+            std::string piece = text.substr(pos, chunk);
+            parser.feed(piece);
+        }
+        parser.finish();
+    };
+
+    // 1. 事件：与 parse_sax 相同，块大小从 1 字节到整个输入
+    std::string text = "{\"name\": \"pjh\\tjson\", \"n\": [0, -12, 3.25, 1e-3, 18446744073709551615, -9223372036854775809, 123456789012],\n"
+                       " \"u\": \"\\u00e9\\ud83d\\ude00 \xE4\xB8\xAD\", \"empty\": {}, \"list\": [], \"flags\": [true, false, null],\n"
+                       " \"long\": \"" +
+                       std::string(300, 'x') + "\\\"" + std::string(200, 'y') + "\", \"nested\": [[[{\"k\": [1, {\"z\": null}]}]]]}";
+    Recorder expected;
+    Parser(std::string_view(text)).parse_sax(expected);
+    for (size_t chunk : {size_t(1), size_t(2), size_t(3), size_t(7), size_t(64), size_t(1000), text.size()})
+    {
+        Recorder recorder;
+        PushParser parser(recorder);
+        feed_in_chunks(parser, text, chunk);
+        assert(parser.done() && parser.depth() == 0 && parser.offset() == text.size());
+        assert(recorder.log == expected.log);
+    }
+
+    // 2. 以 DocumentBuilder 为处理器构建 DOM：结果与 Parser 相同，且不依赖输入缓冲区
+    const std::string expected_dom = Parser(text).parse_document().get()->serialize();
+    DocumentBuilder builder;
+    for (size_t chunk : {size_t(5), size_t(16 * 1024)})
+    {
+        PushParser parser(builder);
+        feed_in_chunks(parser, text, chunk);
+        assert(builder.complete());
+        Document doc = builder.document();
+        assert(doc.get()->serialize() == expected_dom);
+        assert(doc["u"].as_str() == "\xC3\xA9\xF0\x9F\x98\x80 \xE4\xB8\xAD" && doc["n"][4].as_uint64() == 18446744073709551615ull);
+    }
+    // 顶层标量在 finish() 时才能确定结束
+    {
+        PushParser parser(builder);
+        parser.feed("  -12");
+        assert(!parser.done());
+        parser.feed("5e1 ");
+        parser.finish();
+        assert(builder.document().get()->as_value()->as_float() == -1250.0f);
+    }
+
+    // 3. 错误：异常与 parse_sax 相同，行、列与偏移按整个输入计算
+    for (const std::string bad : {"{\n  \"a\": [1,\n 2,\n  tru]\n}", "[\"ab\\x\"]", "{\"k\"\n\n : 1,\n}", "[1, 2", "[\"unterminated",
+                                  "\"\\ud800\"", "[1.]", "[-]", "{\"a\" 1}", "  ", "[1, @]", "{\"a\": 1,}", "[\"\\u12", "[1e+]"})
+    {
+        std::string sax_error;
+        try
+        {
+            SaxHandler ignore;
+            Parser(std::string_view(bad)).parse_sax(ignore);
+        }
+        catch (const Exception &e)
+        {
+            sax_error = e.what();
+        }
+        assert(!sax_error.empty());
+        for (size_t chunk : {size_t(1), size_t(3), bad.size()})
+        {
+            std::string push_error;
+            try
+            {
+                SaxHandler ignore;
+                PushParser parser(ignore);
+                feed_in_chunks(parser, bad, chunk);
+            }
+            catch (const Exception &e)
+            {
+                push_error = e.what();
+            }
+            assert(push_error == sax_error);
+        }
+    }
+
+    // 4. 顶层值之后只允许空白；reset() 之后可以解析新的输入
+    Recorder recorder;
+    PushParser parser(recorder);
+    parser.feed("[1] \n");
+    bool thrown = false;
+    try
+    {
+        parser.feed(" [2]");
+    }
+    catch (const ParseException &e)
+    {
+        thrown = true;
+        assert(e.line() == 2 && e.column() == 2 && e.offset() == 6);
+    }
+    assert(thrown);
+    parser.reset();
+    recorder.log.clear();
+    parser.feed("[2]");
+    parser.finish();
+    assert(recorder.log == "[i2,]1,");
+
+    // 5. 出错后 DocumentBuilder 随 PushParser 一起 reset()，丢弃构建了一半的文档；后续文档沿用构造时的块大小
+    DocumentBuilder small_builder(1024);
+    PushParser dom_parser(small_builder);
+    thrown = false;
+    try
+    {
+        dom_parser.feed("{\"a\": [1, 2, x");
+    }
+    catch (const ParseException &)
+    {
+        thrown = true;
+    }
+    assert(thrown && !small_builder.complete());
+    dom_parser.reset();
+    small_builder.reset();
+    dom_parser.feed("{\"b\": 3}");
+    dom_parser.finish();
+    assert(small_builder.complete());
+    Document first = small_builder.document();
+    assert(first.get()->serialize() == "{\"b\":3}");
+    dom_parser.reset();
+    dom_parser.feed("[4]");
+    dom_parser.finish();
+    Document second = small_builder.document();
+    assert(second.get()->serialize() == "[4]" && second.arena()->reserved() == 1024);
+
+    std::cout << "Push parsing tests passed.\n";
+}
+
+/**
+ * @brief 测试按需解析的 LazyDocument：只扫描访问到的值，结果与完整解析一致。
+ */
+void test_lazy_document()
+{
+    std::cout << "Test: Lazy document.\n";
+
+    // 1. 访问结果与 Tape 一致；被跳过的子树中含有字符串内的括号与转义引号
+    const std::string text = "{\"skip\": {\"a\": [1, \"]}\\\"[{\", {\"b\": [[], {}]}], \"c\": \"}\"},\n"
+                             " \"n\": [0, -12, 3.25, 18446744073709551615, -9223372036854775809, 1e2],\n"
+                             " \"s\\u0074r\": \"x\\ty\", \"flags\": [true, false, null], \"empty\": {}, \"list\": [],\n"
+                             " \"long\": [" + std::string(200, ' ') + "\"" + std::string(100, '{') + "\", {\"deep\": [[[{\"k\": 42}]]]}]}";
+    LazyDocument doc(std::string_view{text});
+    Tape tape = Parser(std::string_view(text)).parse_to_tape();
+    TapeRef expected = tape.root();
+
+    assert(doc.root().is_object() && doc.root().size() == 7);
+    assert(doc["n"][0].as_int() == 0 && doc["n"][1].as_int() == -12);
+    assert(doc["n"][2].as_float() == expected["n"][2].as_float());
+    assert(doc["n"][3].type() == TapeType::UInt && doc["n"][3].as_uint64() == 18446744073709551615ull);
+    assert(doc["n"][4].is_float() && doc["n"][4].as_float() == expected["n"][4].as_float());
+    assert(doc["n"][5].is_float() && doc["n"][5].as_int() == 100);
+    assert(doc["str"].as_str() == "x\ty");
+    assert(doc["flags"][0].as_bool() && !doc["flags"][1].as_bool() && doc["flags"][2].is_null());
+    assert(doc["empty"].size() == 0 && doc["list"].size() == 0 && doc["empty"].begin() == doc["empty"].end());
+    assert(doc["long"][0].as_str() == std::string(100, '{'));
+    assert(doc["long"][1]["deep"][0][0][0]["k"].as_int() == 42);
+    assert(doc["skip"]["c"].as_str() == "}");
+    assert(doc["skip"]["a"][1].as_str() == "]}\"[{");
+    assert(doc["skip"]["a"].raw() == "[1, \"]}\\\"[{\", {\"b\": [[], {}]}]");
+
+    // 遍历：键已解码，值与 Tape 一致
+    std::vector<std::string> keys;
+    for (auto it = doc.root().begin(); it != doc.root().end(); ++it)
+        keys.emplace_back(it.key());
+    assert((keys == std::vector<std::string>{"skip", "n", "str", "flags", "empty", "list", "long"}));
+    // 含转义的键与字符串只解码一次：反复访问得到同一份副本，比较键时不产生副本
+    auto escaped_it = std::next(doc.root().begin(), 2);
+    assert(escaped_it.key_equals("str") && !escaped_it.key_equals("s\\u0074r"));
+    const std::string_view decoded_key = escaped_it.key();
+    for (int round = 0; round < 3; ++round)
+        for (auto it = doc.root().begin(); it != doc.root().end(); ++it)
+            if (it.key_equals("str"))
+                assert(it.key().data() == decoded_key.data());
+    assert(doc["str"].as_str().data() == doc["str"].as_str().data());
+    auto tape_it = expected["n"].begin();
+    for (LazyRef value : doc["n"])
+    {
+        assert(value.type() == (*tape_it).type());
+        ++tape_it;
+    }
+    assert(tape_it == expected["n"].end());
+
+    // 2. 序列化与物化：与完整解析为 DOM 相同
+    Document full = Parser(std::string_view(text)).parse_document();
+    assert(doc.root().serialize() == full.get()->serialize());
+    Document sub = doc["skip"].materialize();
+    assert(sub["a"][2]["b"].size() == 2 && sub.get()->serialize() == full["skip"].get()->serialize());
+
+    // 3. 异常：与 TapeRef 相同
+    auto throws = [](auto &&f)
+    {
+        try
+        {
+            f();
+        }
+        catch (const Exception &)
+        {
+            return true;
+        }
+        return false;
+    };
+    assert(throws([&]
+                  { doc["missing"]; }));
+    assert(throws([&]
+                  { doc["n"][6]; }));
+    assert(throws([&]
+                  { doc["n"]["x"]; }));
+    assert(throws([&]
+                  { doc["flags"][0].as_int(); }));
+    assert(throws([&]
+                  { doc["n"][3].as_int(); }));
+    assert(throws([]
+                  { LazyDocument("[1e20]")[0].as_int(); }));
+    assert(throws([]
+                  { LazyDocument("[-1e20]")[0].as_uint64(); }));
+    assert(throws([]
+                  { LazyRef().type(); }));
+
+    // 4. 语法错误只在扫描经过时才会发现，位置按整个输入计算
+    LazyDocument bad(std::string("{\"ok\": 1,\n \"bad\": [1, tru],\n \"after\": 2}"));
+    assert(bad["ok"].as_int() == 1);
+    bool thrown = false;
+    try
+    {
+        bad["bad"][1].type();
+    }
+    catch (const ParseException &e)
+    {
+        thrown = true;
+        assert(e.line() == 2 && e.column() == 13 && e.offset() == 22);
+    }
+    assert(thrown);
+    thrown = false;
+    try
+    {
+        bad["bad"].materialize();
+    }
+    catch (const ParseException &e)
+    {
+        thrown = true;
+        assert(e.offset() == 22);
+    }
+    assert(thrown);
+    assert(bad["after"].as_int() == 2);
+    assert(throws([]
+                  { LazyDocument("[1, [2, 3]")[2]; }));
+    assert(throws([]
+                  { LazyDocument("{\"a\" 1}")["a"]; }));
+    assert(throws([]
+                  { LazyDocument("   ").root().type(); }));
+
+    std::cout << "Lazy document tests passed.\n";
+}
+
+/**
+ * @brief 测试 Tokenizer::skip_value 与按键白名单只解析根对象的部分成员。
+ */
+void test_key_allowlist()
+{
+    std::cout << "Test: Key allowlist.\n";
+
+    // 1. skip_value：跳过整个子树，括号出现在字符串中或被转义的引号之后都不影响匹配
+    const std::string text = "{\"skip\": {\"a\": [1, \"]}\\\"[{\", {\"b\": [[], {}]}], \"c\": \"}\"},\n"
+                             " \"id\": 7, \"big\": [" + std::string(300, ' ') + "[{\"x\": \"" + std::string(100, '[') + "\"}]],\n"
+                             " \"n\\u0061me\": \"pjh\", \"tail\": {\"k\": [true, null]}}";
+    for (bool indexed : {false, true})
+    {
+        ParseOptions options;
+        options.structural_index = indexed;
+        Tokenizer tokenizer(std::string_view(text), options);
+        tokenizer.consume(); // '{'
+        tokenizer.consume(); // "skip"
+        tokenizer.consume(); // ':'
+        tokenizer.skip_value();
+        assert(tokenizer.peek().type == TokenType::Comma);
+        tokenizer.consume();
+        assert(tokenizer.peek().value == "id");
+        tokenizer.consume();
+        tokenizer.consume();
+        tokenizer.skip_value(); // 标量
+        tokenizer.consume();
+        tokenizer.consume();
+        tokenizer.consume();
+        tokenizer.skip_value();
+        assert(tokenizer.peek().type == TokenType::Comma);
+        tokenizer.consume();
+        assert(tokenizer.peek().value == "n\\u0061me");
+    }
+
+    // 2. 白名单：DOM、Tape、SAX 与各种选项组合下都只保留列出的根成员，顺序与原文一致
+    const std::string expected = "{\"id\":7,\"name\":\"pjh\",\"tail\":{\"k\":[true,null]}}";
+    for (int mode = 0; mode < 4; ++mode)
+    {
+        ParseOptions options;
+        options.key_allowlist = {"tail", "name", "id", "missing"};
+        options.structural_index = mode == 1;
+        options.pipelined = mode == 2;
+        options.validate_utf8 = mode == 3;
+
+        Document doc = Parser(std::string_view(text), options).parse_document();
+        Object *root = doc.get()->as_object();
+        assert(root->size() == 3 && root->contains("id") && root->contains("name") && !root->contains("skip") && !root->contains("big"));
+        assert(doc["id"].as_int() == 7 && doc["name"].as_str() == "pjh" && doc["tail"]["k"].size() == 2);
+
+        Tape tape = Parser(std::string_view(text), options).parse_to_tape();
+        assert(tape.root().size() == 3 && tape.root().serialize() == expected);
+
+        struct Counter : SaxHandler
+        {
+            std::string keys;
+            size_t members = 0;
+            void on_key(string_v_t p_key) { keys += std::string(p_key) + ","; }
+            void on_end_object(size_t p_count) { members = p_count; }
+        } counter;
+        Parser(std::string_view(text), options).parse_sax(counter);
+        assert(counter.keys == "id,name,tail,k," && counter.members == 3);
+    }
+
+    // 3. 白名单只作用于根对象；根为数组时不受影响
+    ParseOptions options;
+    options.key_allowlist = {"a"};
+    assert(Parser(std::string_view("{\"a\": {\"b\": 1}}"), options).parse_document()["a"]["b"].as_int() == 1);
+    assert(Parser(std::string_view("[{\"b\": 1}]"), options).parse_document()[0]["b"].as_int() == 1);
+
+    // 4. 被跳过的值不做校验，但括号不闭合、跳过之后的语法错误照常报告
+    assert(Parser(std::string_view("{\"x\": [1, tru, @], \"a\": 2}"), options).parse_document()["a"].as_int() == 2);
+    for (const std::string bad : {"{\"x\": [1, {\"y\": 2}, \"a\": 2}", "{\"x\": [1] \"a\": 2}", "{\"x\": ] }"})
+    {
+        bool thrown = false;
+        try
+        {
+            Parser(std::string_view(bad), options).parse_document();
+        }
+        catch (const Exception &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << "Key allowlist tests passed.\n";
+}
+
+/**
+ * @brief 测试编译后的 JSON Pointer / JSONPath 在 DOM、Tape 与 LazyDocument 上的求值。
+ */
+void test_json_path()
+{
+    std::cout << "Test: JSON path.\n";
+
+    const std::string text = "{\"store\": {\"book\": [{\"title\": \"A\", \"price\": 8.95, \"tags\": [\"x\", \"y\"]},\n"
+                             " {\"title\": \"B\", \"price\": 12.99, \"stock\": null},\n"
+                             " {\"title\": \"C\", \"price\": 8, \"isbn\": \"0-1\", \"used\": true}],\n"
+                             " \"bicycle\": {\"price\": 19.95, \"color\": \"red\"}},\n"
+                             " \"a/b\": 1, \"m~n\": 2, \"\": 3, \"list\": [10, 20, 30]}";
+    Document doc = Parser(text).parse_document();
+    Tape tape = Parser(std::string_view(text)).parse_to_tape();
+    LazyDocument lazy{std::string_view(text)};
+
+    // 在三种表示上求值，结果排序后比较
+    auto run = [&](const Path &path)
+    {
+        std::vector<std::string> dom_out, tape_out, lazy_out;
+        for (Element *element : path.select(doc.get()))
+            dom_out.push_back(element->serialize());
+        for (const TapeRef &value : path.select(tape.root()))
+            tape_out.push_back(Parser(value.serialize()).parse_document().get()->serialize());
+        for (const LazyRef &value : path.select(lazy.root()))
+            lazy_out.push_back(value.serialize());
+        std::sort(dom_out.begin(), dom_out.end());
+        std::sort(tape_out.begin(), tape_out.end());
+        std::sort(lazy_out.begin(), lazy_out.end());
+        assert(dom_out == tape_out && dom_out == lazy_out);
+        return dom_out;
+    };
+    using strings = std::vector<std::string>;
+
+    // 1. JSON Pointer：转义、空键、数组下标与越界
+    assert(run(Path::pointer("/store/book/1/title")) == strings{"\"B\""});
+    assert(run(Path::pointer("/a~1b")) == strings{"1"});
+    assert(run(Path::pointer("/m~0n")) == strings{"2"});
+    assert(run(Path::pointer("/")) == strings{"3"});
+    assert(run(Path::pointer("")).size() == 1);
+    assert(run(Path::pointer("/list/3")).empty() && run(Path::pointer("/list/-")).empty() && run(Path::pointer("/list/01")).empty());
+    assert(Path::pointer("/store/book/0").is_singular());
+
+    // 2. JSONPath：成员、下标、通配符、递归下降与过滤器
+    assert(run(Path::compile("$.store.book[*].title")) == (strings{"\"A\"", "\"B\"", "\"C\""}));
+    assert(run(Path::compile("$['store'][\"bicycle\"].color")) == strings{"\"red\""});
+    assert(run(Path::compile("$.list[-1]")) == strings{"30"} && run(Path::compile("$.list[-4]")).empty());
+    assert(run(Path::compile("$..price")) == (strings{"12.99", "19.95", "8", "8.95"}));
+    assert(run(Path::compile("$.store.*")).size() == 2 && run(Path::compile("$..*")).size() == 27);
+    assert(run(Path::compile("$..[0]")).size() == 3);
+    assert(run(Path::compile("$.store.book[?(@.price < 10)].title")) == (strings{"\"A\"", "\"C\""}));
+    assert(run(Path::compile("$.store.book[?(@.price >= 8.95)].title")) == (strings{"\"A\"", "\"B\""}));
+    assert(run(Path::compile("$..book[?(@.isbn)].title")) == strings{"\"C\""});
+    assert(run(Path::compile("$..book[?( @['title'] != 'B' )].title")) == (strings{"\"A\"", "\"C\""}));
+    assert(run(Path::compile("$..book[?(@.used == true)].title")) == strings{"\"C\""});
+    assert(run(Path::compile("$..book[?(@.stock == null)].title")) == strings{"\"B\""});
+    assert(run(Path::compile("$..book[?(@.tags[1] == \"y\")].title")) == strings{"\"A\""});
+    assert(run(Path::compile("$.list[?(@ > 15)]")) == (strings{"20", "30"}));
+    assert(!Path::compile("$..price").is_singular() && Path::compile("$.store['book'][0]").is_singular());
+
+    // 3. find 在第一个结果处停止；找不到时不抛异常
+    const Path first = Path::compile("$..title");
+    assert(first.find(doc.get()) != nullptr && first.find(doc.get())->is_value());
+    LazyRef found;
+    assert(first.find(lazy.root(), found) && found.as_str() == "A");
+    assert(Path::compile("$.missing.deep").find(doc.get()) == nullptr);
+    TapeRef missing;
+    assert(!Path::compile("$.list.x").find(tape.root(), missing));
+
+    // 4. 语法错误：ParseException 的位置为表达式中的偏移
+    for (const auto &[expression, offset] : std::vector<std::pair<std::string, size_t>>{
+             {"store", 0}, {"$.", 2}, {"$[", 2}, {"$['a", 2}, {"$[?(@.a ~ 1)]", 8}, {"$[1.5]", 3}, {"$.a]", 3}, {"$[?(@.a == x)]", 11}})
+    {
+        bool thrown = false;
+        try
+        {
+            Path::compile(expression);
+        }
+        catch (const ParseException &e)
+        {
+            thrown = true;
+            assert(e.offset() == offset && e.line() == 1);
+        }
+        assert(thrown);
+    }
+    for (const std::string pointer : {"a", "/a~", "/a~2"})
+    {
+        bool thrown = false;
+        try
+        {
+            Path::pointer(pointer);
+        }
+        catch (const ParseException &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << "JSON path tests passed.\n";
+}
+
+/**
+ * @brief 测试 Object 按插入顺序存放成员，以及成员较多时通过哈希索引查找。
+ */
+void test_object_order()
+{
+    std::cout << "Test: Insertion-ordered object storage.\n";
+
+    // 1. 遍历与序列化保持输入中的成员顺序
+    const std::string text = R"({"z":1,"a":2,"m":{"y":true,"b":null},"k":[3]})";
+    Document doc = Parser(text).parse_document();
+    assert(doc.get()->serialize() == text);
+    std::vector<std::string> keys;
+    for (const auto &[k, v] : *doc.get()->as_object())
+        keys.emplace_back(k);
+    assert((keys == std::vector<std::string>{"z", "a", "m", "k"}));
+
+    // 2. 重复的键替换旧值，但保留第一次出现的位置
+    Document dup = Parser(std::string(R"({"a":1,"b":2,"a":3})")).parse_document();
+    assert(dup.get()->serialize() == R"({"a":3,"b":2})");
+
+    // 3. 超过 index_threshold 后通过索引查找，顺序不变；临时字符串作为键时由对象自己保存一份
+    Object obj;
+    const size_t count = Object::index_threshold * 10;
+    for (size_t i = 0; i < count; ++i)
+        obj.insert("key" + std::to_string(i), static_cast<int>(i));
+    assert(obj.size() == count);
+    for (size_t i = 0; i < count; ++i)
+        assert(Ref(&obj)["key" + std::to_string(i)].as_int() == static_cast<int>(i));
+    assert(!obj.contains("key") && obj["key" + std::to_string(count)] == nullptr);
+    size_t index = 0;
+    for (const auto &[k, v] : obj)
+        assert(k == "key" + std::to_string(index++));
+    obj.insert("key7", -1);
+    assert(obj.size() == count && Ref(&obj)["key7"].as_int() == -1);
+
+    // 4. 深拷贝保持顺序；相等比较与成员顺序无关
+    Object *copied = obj.copy();
+    assert(*copied == obj && copied->serialize() == obj.serialize());
+    Object reversed;
+    for (size_t i = count; i-- > 0;)
+        reversed.copy_and_insert("key" + std::to_string(i), *obj["key" + std::to_string(i)]);
+    assert(reversed == obj && reversed.serialize() != obj.serialize());
+    reversed.insert("key0", 100);
+    assert(reversed != obj);
+    Element::release(copied);
+
+    // 5. Arena 上的大对象
+    std::string wide = "{";
+    for (size_t i = 0; i < count; ++i)
+        wide += (i ? ",\"" : "\"") + std::to_string(count - i) + "\":" + std::to_string(i);
+    wide += "}";
+    Document wide_doc = Parser(wide).parse_document();
+    assert(wide_doc.get()->in_arena() && wide_doc.get()->serialize() == wide);
+    assert(wide_doc[std::to_string(count)].as_int() == 0 && wide_doc["1"].as_int() == static_cast<int>(count - 1));
+
+    std::cout << "Object order tests passed.\n";
+}
+
+/**
+ * @brief 测试对象键的驻留表，以及用驻留的 Key 直接查找对象成员。
+ */
+void test_key_interning()
+{
+    std::cout << "Test: Key interning.\n";
+
+    // 1. 驻留表本身：相同内容得到同一个 Key，编号按驻留顺序分配
+    KeyTable table;
+    KeyTable::Key alpha = table.intern("alpha");
+    std::string temp = "alpha";
+    assert(table.intern(temp) == alpha && table.intern(temp).view().data() == alpha.view().data());
+    assert(alpha.id() == 0 && table.intern("beta").id() == 1 && table.size() == 2);
+    assert(table.find("beta").valid() && !table.find("gamma").valid());
+    assert(table.at(1).view() == "beta" && alpha.hash() == StringViewHash()("alpha"));
+    for (int i = 0; i < 1000; ++i)
+        table.intern("k" + std::to_string(i));
+    assert(table.size() == 1002 && table.find("k999").id() == 1001 && table.intern("alpha") == alpha);
+
+    // 2. 解析时驻留对象键：各文档中的同名键共享同一份内容（含转义的键按解码后的内容驻留）
+    ParseOptions options;
+    options.key_table = std::make_shared<KeyTable>();
+    std::vector<Document> docs;
+    for (int i = 0; i < 3; ++i)
+    {
+        std::string line = "{\"id\": " + std::to_string(i) + ", \"na\\u006de\": \"x\", \"nested\": {\"id\": true}}";
+        docs.push_back(Parser(line, options).parse_document());
+    }
+    KeyTable &keys = *options.key_table;
+    const KeyTable::Key id = keys.find("id"), name = keys.find("name");
+    assert(id.valid() && name.valid() && keys.size() == 3);
+    for (int i = 0; i < 3; ++i)
+    {
+        Object *root = docs[i].get()->as_object();
+        for (const auto &[k, v] : *root)
+            assert(keys.find(k).same(k));
+        assert(Ref(root->get(id)).as_int() == i && Ref(root->get(name)).as_str() == "x");
+        assert(root->get(keys.find("nested"))->as_object()->contains(id));
+        assert(!root->contains(alpha) && !root->contains(KeyTable::Key()));
+        bool thrown = false;
+        try
+        {
+            root->get(alpha);
+        }
+        catch (const InvalidKeyException &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    // 3. 未经驻留插入的成员也能用 Key 查到（按内容比较），包括建立了索引的对象
+    Object wide;
+    for (int i = 0; i < 40; ++i)
+        wide.insert("f" + std::to_string(i), i);
+    const KeyTable::Key f30 = keys.intern("f30");
+    assert(wide.contains(f30) && Ref(wide.get(f30)).as_int() == 30 && wide[keys.intern("f99")] == nullptr);
+    Object small;
+    small.insert("f1", 1);
+    assert(small[keys.intern("f1")] != nullptr && small[f30] == nullptr);
+
+    // 4. 文档保持驻留表存活
+    Document kept;
+    {
+        ParseOptions local;
+        local.key_table = std::make_shared<KeyTable>();
+        kept = Parser(std::string(R"({"only": 1})"), local).parse_document();
+    }
+    assert(kept["only"].as_int() == 1 && kept.get()->serialize() == R"({"only":1})");
+
+    // 5. 并行解析的各个线程共享同一张表
+    std::string text = "[";
+    for (int i = 0; i < 30000; ++i)
+        text += (i ? ",{\"id\":" : "{\"id\":") + std::to_string(i) + ",\"name\":\"n\",\"tags\":[1,2]}";
+    text += "]";
+    ThreadPool pool(3);
+    Document parallel = Parser::parse_parallel(text, pool, options);
+    const KeyTable::Key tags = keys.find("tags");
+    assert(tags.valid() && parallel[29999]["id"].as_int() == 29999);
+    for (size_t i = 0; i < 30000; i += 997)
+    {
+        Object *record = parallel[i].get()->as_object();
+        assert(Ref(record->get(id)).as_int() == static_cast<int>(i) && record->get(tags)->as_array()->size() == 2);
+        for (const auto &[k, v] : *record)
+            assert(keys.find(k).same(k));
+    }
+
+    std::cout << "Key interning tests passed.\n";
+}
+
 /**
  * @brief 测试工厂函数 (make_object, make_array, make_value) 构建 JSON 结构的功能。
  */
@@ -315,6 +2639,31 @@ int main()
     Func(test_array);
     Func(test_object);
     Func(test_parser);
+    Func(test_parser_borrowed);
+    Func(test_parse_file);
+    Func(test_document_arena);
+    Func(test_concurrent_parsing);
+    Func(test_structural_index);
+    Func(test_vectorized_scanning);
+    Func(test_error_location);
+    Func(test_tape);
+    Func(test_number_parsing);
+    Func(test_wide_numbers);
+    Func(test_writer);
+    Func(test_number_formatting);
+    Func(test_string_escapes);
+    Func(test_utf8_validation);
+    Func(test_pipelined_parse);
+    Func(test_spsc_queue);
+    Func(test_parallel_parse);
+    Func(test_line_stream_parser);
+    Func(test_sax_parse);
+    Func(test_push_parser);
+    Func(test_lazy_document);
+    Func(test_key_allowlist);
+    Func(test_json_path);
+    Func(test_object_order);
+    Func(test_key_interning);
     Func(test_factory_build);
     Func(test_file_io);
     Func(test_nlohhman_json_file_io);